@@ -64,7 +64,7 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)7000)
+#define configTOTAL_HEAP_SIZE                    ((size_t)1024)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
@@ -159,6 +159,19 @@ standard names. */
 
 #define configCOMMAND_INT_MAX_OUTPUT_SIZE 1
 
+/* Tickless idle is implemented in Lib/Src/Power/power.c on top of the RTC and STOP2 */
+#define configUSE_TICKLESS_IDLE 2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+
+/* Run time statistics from the DWT cycle counter, see Lib/Src/Stats/stats.c */
+#define configGENERATE_RUN_TIME_STATS 1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  extern void Stats_InitRunTimeCounter(void);
+  extern uint32_t Stats_GetRunTimeCounter(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() Stats_InitRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE() Stats_GetRunTimeCounter()
+
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -81,7 +81,12 @@ void Error_Handler(void);
 #define T_VCP_RXA2_Pin GPIO_PIN_2
 #define T_VCP_RXA2_GPIO_Port GPIOA
 /* USER CODE BEGIN Private defines */
-
+/* Logic analyser probes, high while the radio is in RX/TX (DBG_GPIO_RADIO_* in radio_conf.h) */
+/* #define RADIO_DEBUG_PROBES */
+#define DBG_PROBE_RX_Pin GPIO_PIN_12
+#define DBG_PROBE_RX_GPIO_Port GPIOB
+#define DBG_PROBE_TX_Pin GPIO_PIN_13
+#define DBG_PROBE_TX_GPIO_Port GPIOB
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
@@ -63,6 +63,13 @@ UTIL_ADV_TRACE_Status_t UART_TransmitDMA(uint8_t *pdata, uint16_t size);
 */
 UTIL_ADV_TRACE_Status_t UART_StartRx(void (*cb)(uint8_t *pdata, uint16_t size, uint8_t error));
 
+/**
+* @brief  register a function called after every completed DMA transfer,
+*         i.e. whenever space has been released in the trace FIFO
+* @param  notify function called from the UART interrupt
+*/
+void UART_RegisterTxCpltNotify(void (*notify)(void));
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,7 +28,7 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "stdint.h"
 /* USER CODE BEGIN Includes */
-
+#include "stm32_adv_trace.h"
 /* USER CODE END Includes */
 
 /* Exported types ------------------------------------------------------------*/
@@ -38,7 +38,8 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
-
+/* Traces above this level are filtered, VLEVEL_M and up also prints the radio driver logs */
+#define VERBOSE_LEVEL VLEVEL_L
 /* USER CODE END EC */
 
 /* External variables --------------------------------------------------------*/
@@ -48,7 +49,8 @@ extern "C" {
 
 /* Exported macros -----------------------------------------------------------*/
 /* USER CODE BEGIN EM */
-
+#define APP_PRINTF(...)   do{ SystemApp_TraceResult(UTIL_ADV_TRACE_COND_FSend(VLEVEL_ALWAYS, T_REG_OFF, TS_OFF, __VA_ARGS__)); }while(0)
+#define APP_LOG(TS,VL,...)   do{ SystemApp_TraceResult(UTIL_ADV_TRACE_COND_FSend(VL, T_REG_OFF, TS, __VA_ARGS__)); }while(0)
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
@@ -60,7 +62,12 @@ extern "C" {
 void SystemApp_Init(void);
 
 /* USER CODE BEGIN EFP */
-
+/**
+  * @brief counts traces dropped because the trace FIFO was full
+  * @param status value returned by the UTIL_ADV_TRACE send function
+  * @retval  none
+  */
+void SystemApp_TraceResult(UTIL_ADV_TRACE_Status_t status);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
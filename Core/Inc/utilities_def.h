@@ -42,7 +42,9 @@ typedef enum
 {
   CFG_LPM_TCXO_WA_Id,
   /* USER CODE BEGIN CFG_LPM_Id_t */
-
+  CFG_LPM_APPLI_Id,
+  CFG_LPM_UART_TX_Id,
+  CFG_LPM_US_TIMER_Id,
   /* USER CODE END CFG_LPM_Id_t */
 } CFG_LPM_Id_t;
 /* USER CODE BEGIN ET */
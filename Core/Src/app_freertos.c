@@ -31,9 +31,11 @@
 #include "subghz_phy_app.h"
 
 #include "CLI/cli.h"
+#include "MemBudget/mem_budget.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
+typedef StaticTask_t osStaticThreadDef_t;
 /* USER CODE BEGIN PTD */
 
 /* USER CODE END PTD */
@@ -54,10 +56,15 @@
 /* USER CODE END Variables */
 /* Definitions for initThread */
 osThreadId_t initThreadHandle;
+uint32_t initThreadBuffer[ 256 ];
+osStaticThreadDef_t initThreadControlBlock;
 const osThreadAttr_t initThread_attributes = {
   .name = "initThread",
+  .cb_mem = &initThreadControlBlock,
+  .cb_size = sizeof(initThreadControlBlock),
+  .stack_mem = &initThreadBuffer[0],
+  .stack_size = sizeof(initThreadBuffer),
   .priority = (osPriority_t) osPriorityNormal,
-  .stack_size = 512 * 4
 };
 
 /* Private function prototypes -----------------------------------------------*/
@@ -122,6 +129,12 @@ void initTask(void *argument)
   MX_SubGHz_Phy_Init();
   /* USER CODE BEGIN initTask */
 
+  /* Kernel objects, idle and timer task memory is provided by cmsis_os2.c */
+  MemBudget_Register("RTOS", "heap", configTOTAL_HEAP_SIZE);
+  MemBudget_Register("RTOS", "idle task", sizeof(StaticTask_t) + configMINIMAL_STACK_SIZE * sizeof(StackType_t));
+  MemBudget_Register("RTOS", "timer task", sizeof(StaticTask_t) + configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t));
+  MemBudget_Register("RTOS", "init task", sizeof(initThreadControlBlock) + sizeof(initThreadBuffer));
+
   /* Initialize Command Line */
   commandLineInit();
 
@@ -22,6 +22,7 @@
 #include "cmsis_os.h"
 #include "subghz.h"
 #include "app_subghz_phy.h"
+#include "dma.h"
 #include "usart.h"
 #include "gpio.h"
 
@@ -90,6 +91,7 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_SUBGHZ_Init();
   /* USER CODE BEGIN 2 */
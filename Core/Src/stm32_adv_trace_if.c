@@ -18,7 +18,7 @@
 #include "stm32_adv_trace.h"
 #include "stm32_adv_trace_if.h"
 /* USER CODE BEGIN include */
-
+#include "usart.h"
 /* USER CODE END include */
 
 /* Exported variables --------------------------------------------------------*/
@@ -36,7 +36,7 @@ const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
   UART_TransmitDMA
 };
 /* USER CODE BEGIN EV */
-
+extern UART_HandleTypeDef huart2;
 /* USER CODE END EV */
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN Private_Function_Prototypes */
@@ -56,12 +56,25 @@ const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
 /* USER CODE END Private_Macro */
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Private_Variables */
+/**
+ * @brief  TX complete callback of the trace FIFO, plus an optional listener for FIFO space
+ */
+static void (*TxCpltCallback)(void *);
+static void (*TxCpltNotify)(void);
 
+/**
+ * @brief  RX byte and callback of the owner of the console input
+ */
+static uint8_t charRx;
+static void (*RxCpltCallback)(uint8_t *pdata, uint16_t size, uint8_t error);
 /* USER CODE END Private_Variables */
 
 UTIL_ADV_TRACE_Status_t UART_Init(void (*cb)(void *))
 {
 /* USER CODE BEGIN UART_Init */
+  /* USART2 and its TX DMA channel are initialised by main() */
+  TxCpltCallback = cb;
+
   return UTIL_ADV_TRACE_OK;
 /* USER CODE END UART_Init */
 }
@@ -69,6 +82,9 @@ UTIL_ADV_TRACE_Status_t UART_Init(void (*cb)(void *))
 UTIL_ADV_TRACE_Status_t UART_DeInit( void )
 {
 /* USER CODE BEGIN UART_DeInit */
+  HAL_UART_AbortTransmit(&huart2);
+  TxCpltCallback = NULL;
+
   return UTIL_ADV_TRACE_OK;
 /* USER CODE END UART_DeInit */
 }
@@ -76,6 +92,13 @@ UTIL_ADV_TRACE_Status_t UART_DeInit( void )
 UTIL_ADV_TRACE_Status_t UART_StartRx(void (*cb)(uint8_t *pdata, uint16_t size, uint8_t error))
 {
 /* USER CODE BEGIN UART_StartRx */
+  RxCpltCallback = cb;
+
+  if (HAL_UART_Receive_IT(&huart2, &charRx, 1) != HAL_OK)
+  {
+    return UTIL_ADV_TRACE_HW_ERROR;
+  }
+
   return UTIL_ADV_TRACE_OK;
 /* USER CODE END UART_StartRx */
 }
@@ -83,12 +106,70 @@ UTIL_ADV_TRACE_Status_t UART_StartRx(void (*cb)(uint8_t *pdata, uint16_t size, u
 UTIL_ADV_TRACE_Status_t UART_TransmitDMA ( uint8_t *pdata, uint16_t size )
 {
 /* USER CODE BEGIN UART_TransmitDMA */
-	return UTIL_ADV_TRACE_OK;
+  if (HAL_UART_Transmit_DMA(&huart2, pdata, size) != HAL_OK)
+  {
+    return UTIL_ADV_TRACE_HW_ERROR;
+  }
+
+  return UTIL_ADV_TRACE_OK;
 /* USER CODE END UART_TransmitDMA */
 }
 
 /* USER CODE BEGIN Private_Functions */
+void UART_RegisterTxCpltNotify(void (*notify)(void))
+{
+  TxCpltNotify = notify;
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart != &huart2)
+  {
+    return;
+  }
+
+  /* Releases the sent chunk and starts the DMA on the next one, if any */
+  if (TxCpltCallback != NULL)
+  {
+    TxCpltCallback(NULL);
+  }
+
+  if (TxCpltNotify != NULL)
+  {
+    TxCpltNotify();
+  }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart != &huart2)
+  {
+    return;
+  }
+
+  if (RxCpltCallback != NULL)
+  {
+    RxCpltCallback(&charRx, 1, 0);
+  }
+
+  HAL_UART_Receive_IT(&huart2, &charRx, 1);
+}
 
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (huart != &huart2)
+  {
+    return;
+  }
+
+  /* Overrun/framing/noise errors abort the reception, report and re-arm it */
+  if (RxCpltCallback != NULL)
+  {
+    RxCpltCallback(&charRx, 0, 1);
+  }
+
+  HAL_UART_Receive_IT(&huart2, &charRx, 1);
+}
 /* USER CODE END Private_Functions */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -22,7 +22,8 @@
 #include "stm32_lpm_if.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "stm32wlxx_hal.h"
+#include "stm32wlxx_ll_pwr.h"
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -89,28 +90,36 @@ void PWR_ExitOffMode(void)
 void PWR_EnterStopMode(void)
 {
   /* USER CODE BEGIN EnterStopMode_1 */
+  HAL_SuspendTick();
+
+  /* Clear Status Flag before entering STOP/STANDBY Mode */
+  LL_PWR_ClearFlag_C1STOP_C1STB();
 
+  HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
   /* USER CODE END EnterStopMode_1 */
 }
 
 void PWR_ExitStopMode(void)
 {
   /* USER CODE BEGIN ExitStopMode_1 */
-
+  /* MSI range and the peripheral clock selections are retained in STOP2 */
+  HAL_ResumeTick();
   /* USER CODE END ExitStopMode_1 */
 }
 
 void PWR_EnterSleepMode(void)
 {
   /* USER CODE BEGIN EnterSleepMode_1 */
+  HAL_SuspendTick();
 
+  HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
   /* USER CODE END EnterSleepMode_1 */
 }
 
 void PWR_ExitSleepMode(void)
 {
   /* USER CODE BEGIN ExitSleepMode_1 */
-
+  HAL_ResumeTick();
   /* USER CODE END ExitSleepMode_1 */
 }
 
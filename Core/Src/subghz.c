@@ -57,7 +57,9 @@ void HAL_SUBGHZ_MspInit(SUBGHZ_HandleTypeDef* subghzHandle)
     /* SUBGHZ clock enable */
     __HAL_RCC_SUBGHZSPI_CLK_ENABLE();
   /* USER CODE BEGIN SUBGHZ_MspInit 1 */
-
+    /* SUBGHZ interrupt Init, delivers TxDone/Timeout to radio.c */
+    HAL_NVIC_SetPriority(SUBGHZ_Radio_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(SUBGHZ_Radio_IRQn);
   /* USER CODE END SUBGHZ_MspInit 1 */
 }
 
@@ -70,7 +72,7 @@ void HAL_SUBGHZ_MspDeInit(SUBGHZ_HandleTypeDef* subghzHandle)
     /* Peripheral clock disable */
     __HAL_RCC_SUBGHZSPI_CLK_DISABLE();
   /* USER CODE BEGIN SUBGHZ_MspDeInit 1 */
-
+    HAL_NVIC_DisableIRQ(SUBGHZ_Radio_IRQn);
   /* USER CODE END SUBGHZ_MspDeInit 1 */
 }
 
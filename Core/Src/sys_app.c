@@ -27,7 +27,16 @@
 #include "timer_if.h"
 
 /* USER CODE BEGIN Includes */
+#include "Power/power.h"
+#include "UsTimer/us_timer.h"
+#include "Stats/stats.h"
+#include "MemBudget/mem_budget.h"
 
+#include "cmsis_os.h"
+#include "stm32_adv_trace.h"
+
+#include <string.h>
+#include <inttypes.h>
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -42,7 +51,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define MAX_TS_SIZE (int) 16
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -57,6 +66,19 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+/**
+  * @brief  Returns sec and msec based on the kernel tick
+  * @param  buff string buffer
+  * @param  size size of the string
+  */
+static void TimestampNow(uint8_t *buff, uint16_t *size);
+
+#ifdef RADIO_DEBUG_PROBES
+/**
+  * @brief  Configures the radio RX/TX probe pins as outputs
+  */
+static void DBG_ProbesInit(void);
+#endif /* RADIO_DEBUG_PROBES */
 
 /* USER CODE END PFP */
 
@@ -69,17 +91,80 @@
 void SystemApp_Init(void)
 {
   /* USER CODE BEGIN SystemApp_Init_1 */
+#ifdef RADIO_DEBUG_PROBES
+  DBG_ProbesInit();
+#endif /* RADIO_DEBUG_PROBES */
+
+  /* RTC timebase, STOP2 wakeup sources and the low power manager */
+  Power_Init();
 
+  /* TIM2 compares, for deadlines below the tick */
+  UsTimer_Init();
+
+  /* Initializes the trace, USART2 TX is drained by DMA */
+  UTIL_ADV_TRACE_Init();
+  UTIL_ADV_TRACE_RegisterTimeStampFunction(TimestampNow);
+  MemBudget_Register("TRACE", "fifo", UTIL_ADV_TRACE_FIFO_SIZE);
+
+  /* Set verbose LEVEL */
+  UTIL_ADV_TRACE_SetVerboseLevel(VERBOSE_LEVEL);
   /* USER CODE END SystemApp_Init_1 */
 }
 
 /* USER CODE BEGIN ExF */
+void SystemApp_TraceResult(UTIL_ADV_TRACE_Status_t status)
+{
+  /* The trace FIFO was full and the log was dropped */
+  if (status == UTIL_ADV_TRACE_MEM_FULL)
+  {
+    Stats_CountTraceOverrun();
+  }
+}
+
+/**
+  * @brief  Blocks stop mode while the trace DMA is running
+  */
+void UTIL_ADV_TRACE_PreSendHook(void)
+{
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_UART_TX_Id), UTIL_LPM_DISABLE);
+}
 
+/**
+  * @brief  Releases stop mode once the trace FIFO is empty
+  */
+void UTIL_ADV_TRACE_PostSendHook(void)
+{
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_UART_TX_Id), UTIL_LPM_ENABLE);
+}
 /* USER CODE END ExF */
 
 /* Private functions ---------------------------------------------------------*/
 /* USER CODE BEGIN PrFD */
+static void TimestampNow(uint8_t *buff, uint16_t *size)
+{
+  uint32_t ticks = osKernelGetTickCount();
+
+  snprintf((char *)buff, MAX_TS_SIZE, "%" PRIu32 "s%03" PRIu32 ":", ticks / 1000, ticks % 1000);
 
+  *size = strlen((char *)buff);
+}
+
+#ifdef RADIO_DEBUG_PROBES
+static void DBG_ProbesInit(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+
+  HAL_GPIO_WritePin(GPIOB, DBG_PROBE_RX_Pin | DBG_PROBE_TX_Pin, GPIO_PIN_RESET);
+
+  GPIO_InitStruct.Pin = DBG_PROBE_RX_Pin | DBG_PROBE_TX_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+}
+#endif /* RADIO_DEBUG_PROBES */
 /* USER CODE END PrFD */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
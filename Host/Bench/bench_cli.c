@@ -0,0 +1,66 @@
+/*
+ * bench_cli.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Time per CLI command, parsing and handler down to the fake SUBGHZ.
+ *   bench_cli [iterations]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "app_subghz_phy.h"
+#include "CLI/cli.h"
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_CLI.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+static const char *const commands[] = {
+	"freq",
+	"freq 868000000",
+	"power 14",
+	"datarate 4800",
+	"syncword 2 AB",
+	"transmit hello",
+};
+#define COMMAND_COUNT (sizeof(commands) / sizeof(commands[0]))
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char **argv) {
+	uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 100000;
+	char out[128];
+
+	MX_SubGHz_Phy_Init();
+	commandLineInit();
+
+	printf("%-20s %12s\n", "command", "ns/command");
+
+	for (uint32_t c = 0; c < COMMAND_COUNT; c++) {
+		uint64_t start = Host_GetTimeNs();
+
+		for (uint32_t i = 0; i < iterations; i++) {
+			while (FreeRTOS_CLIProcessCommand(commands[c], out, sizeof(out)) != pdFALSE);
+			HostUart_Drain();
+		}
+
+		uint64_t elapsed = Host_GetTimeNs() - start;
+		printf("%-20s %12.1f\n", commands[c], (double) elapsed / iterations);
+
+		/* The fake SUBGHZ log is bounded, start every command from an empty one */
+		HostSubghz_ClearLog();
+	}
+
+	return 0;
+}
@@ -0,0 +1,400 @@
+/*
+ * bench_cli_load.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * CLI throughput and turnaround under load. A mix of commands is typed on the
+ * serial line at increasing rates, open loop, and every step reports the
+ * commands/s completed, the turnaround percentiles seen from the terminal,
+ * the lines dropped by cliQueue and the UART bytes per command, as JSON.
+ *
+ * Without -d the firmware runs in this process under the scheduler, like
+ * pwnrf_sim. With -d it talks to a simulator (pwnrf_sim -l) or a board.
+ *   bench_cli_load [-d device] [-t ms per step] [-r rate,rate,...]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "usart.h"
+#include "subghz.h"
+#include "cmsis_os.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define BENCH_MAX_RATES 16
+#define BENCH_MAX_COMMANDS 65536
+
+/* End of every response, see cliTask in Lib/Src/CLI/cli.c */
+#define BENCH_PROMPT "> \e7"
+
+/* The response is complete once the line has been quiet this long */
+#define BENCH_QUIET_MS 500
+#define BENCH_TIMEOUT_MS 5000
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	uint32_t rate;
+	uint32_t sent;
+	uint32_t completed;
+	uint64_t bytes;
+	uint64_t elapsedNs;			/* First command sent to last prompt received */
+	int32_t queueDrops;			/* -1 when the firmware does not report them */
+	uint32_t p50Us, p99Us, maxUs;
+} BenchStep_t;
+
+/********************************
+ * Static Variables
+ ********************************/
+/* Config get/set, transmissions, continuous mode start/stop and help */
+static const char *const mix[] = {
+	"freq",
+	"freq 433000000",
+	"power",
+	"power 14",
+	"datarate",
+	"datarate 600",
+	"crc",
+	"syncword 2 AB",
+	"transmit hello",
+	"transmitContinuous 1000 ping",
+	"freq",
+	"transmitContinuous 0",
+	"help",
+};
+#define MIX_COUNT (sizeof(mix) / sizeof(mix[0]))
+
+static const char *device = NULL;
+static uint32_t stepMs = 2000;
+static uint32_t rates[BENCH_MAX_RATES] = { 5, 10, 20, 50, 100, 200 };
+static uint32_t rateCount = 6;
+
+static int fd = -1;
+
+/* Prompt matcher, state kept across reads */
+static uint32_t promptPos = 0;
+
+/* Send times of the commands still waiting for their prompt */
+static uint64_t outstanding[BENCH_MAX_COMMANDS];
+static uint32_t outHead = 0, outTail = 0;
+
+static uint32_t turnaround[BENCH_MAX_COMMANDS];
+static uint32_t turnaroundCount = 0;
+
+/* Scratch for the stats response */
+static char response[4096];
+static size_t responseLen = 0;
+
+/********************************
+ * External Functions
+ ********************************/
+/* Core/Src/app_freertos.c */
+void MX_FREERTOS_Init(void);
+
+/********************************
+ * Helpers
+ ********************************/
+static uint64_t nowNs(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void sendLine(const char *line) {
+	(void) write(fd, line, strlen(line));
+	(void) write(fd, "\r\n", 2);
+}
+
+/* @brief: Counts the prompts in a chunk of output */
+static uint32_t scanPrompts(const char *data, size_t len) {
+	static const char prompt[] = BENCH_PROMPT;
+	uint32_t prompts = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		if (data[i] == prompt[promptPos]) {
+			promptPos++;
+		} else {
+			promptPos = data[i] == prompt[0];
+		}
+
+		if (promptPos == sizeof(prompt) - 1) {
+			promptPos = 0;
+			prompts++;
+		}
+	}
+
+	return prompts;
+}
+
+/*
+ * @brief: Reads whatever arrives until deadline, returns the bytes read.
+ * Every prompt completes the oldest outstanding command.
+ */
+static size_t receive(uint64_t deadline, BenchStep_t *step) {
+	char data[1024];
+	size_t total = 0;
+
+	for (;;) {
+		uint64_t now = nowNs();
+		if (now >= deadline) {
+			return total;
+		}
+
+		struct pollfd pfd = { .fd = fd, .events = POLLIN };
+		if (poll(&pfd, 1, (int) ((deadline - now + 999999) / 1000000)) <= 0) {
+			continue;
+		}
+
+		ssize_t len = read(fd, data, sizeof(data));
+		if (len <= 0) {
+			continue;
+		}
+		total += len;
+
+		if (responseLen + len < sizeof(response)) {
+			memcpy(&response[responseLen], data, len);
+			responseLen += len;
+			response[responseLen] = '\0';
+		}
+
+		uint32_t prompts = scanPrompts(data, len);
+		if (step == NULL) {
+			continue;
+		}
+
+		uint64_t at = nowNs();
+		step->bytes += len;
+		while (prompts-- != 0 && outTail != outHead) {
+			uint64_t sentAt = outstanding[outTail++ % BENCH_MAX_COMMANDS];
+			if (turnaroundCount < BENCH_MAX_COMMANDS) {
+				turnaround[turnaroundCount++] = (uint32_t) ((at - sentAt) / 1000);
+			}
+			step->completed++;
+			step->elapsedNs = at;
+		}
+	}
+}
+
+/* @brief: Reads until the line has been quiet for BENCH_QUIET_MS, or the timeout */
+static void receiveUntilQuiet(BenchStep_t *step) {
+	uint64_t end = nowNs() + BENCH_TIMEOUT_MS * 1000000ULL;
+
+	while (nowNs() < end) {
+		if (receive(nowNs() + BENCH_QUIET_MS * 1000000ULL, step) == 0) {
+			return;
+		}
+	}
+}
+
+/* @brief: cliQueue drops reported by the stats command, -1 if not reported */
+static int32_t queueDrops(void) {
+	unsigned int drops;
+
+	responseLen = 0;
+	response[0] = '\0';
+	sendLine("stats");
+	receiveUntilQuiet(NULL);
+
+	const char *line = strstr(response, "cliQueue");
+	if (line == NULL || (line = strstr(line, "drops ")) == NULL || sscanf(line, "drops %u", &drops) != 1) {
+		return -1;
+	}
+
+	return (int32_t) drops;
+}
+
+static int compareU32(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t percentile(uint32_t permille) {
+	if (turnaroundCount == 0) {
+		return 0;
+	}
+
+	return turnaround[(uint64_t) (turnaroundCount - 1) * permille / 1000];
+}
+
+/********************************
+ * Benchmark
+ ********************************/
+static void runStep(BenchStep_t *step, int32_t *drops) {
+	uint64_t period = 1000000000ULL / step->rate;
+	uint64_t start = nowNs();
+	uint64_t end = start + stepMs * 1000000ULL;
+
+	outHead = outTail = 0;
+	turnaroundCount = 0;
+
+	/* Open loop, commands are typed at the rate whatever the responses */
+	for (uint64_t next = start; next < end; next += period) {
+		receive(next, step);
+
+		outstanding[outHead++ % BENCH_MAX_COMMANDS] = nowNs();
+		sendLine(mix[step->sent % MIX_COUNT]);
+		step->sent++;
+	}
+	receiveUntilQuiet(step);
+
+	step->elapsedNs = step->completed != 0 ? step->elapsedNs - start : 0;
+
+	qsort(turnaround, turnaroundCount, sizeof(turnaround[0]), compareU32);
+	step->p50Us = percentile(500);
+	step->p99Us = percentile(990);
+	step->maxUs = percentile(1000);
+
+	int32_t total = queueDrops();
+	step->queueDrops = total >= 0 && *drops >= 0 ? total - *drops : -1;
+	*drops = total;
+}
+
+static int bench(void) {
+	BenchStep_t steps[BENCH_MAX_RATES];
+	int32_t drops;
+
+	/* Boot output or a previous session, then one prompt to show the CLI is there */
+	receiveUntilQuiet(NULL);
+	responseLen = 0;
+	sendLine("");
+	receiveUntilQuiet(NULL);
+	if (strstr(response, BENCH_PROMPT) == NULL) {
+		fprintf(stderr, "bench_cli_load: no prompt from %s\n", device != NULL ? device : "the firmware");
+		return 1;
+	}
+	drops = queueDrops();
+
+	for (uint32_t i = 0; i < rateCount; i++) {
+		memset(&steps[i], 0, sizeof(steps[i]));
+		steps[i].rate = rates[i];
+		runStep(&steps[i], &drops);
+		fprintf(stderr, "%lu cmd/s offered: %lu/%lu completed\n", (unsigned long) steps[i].rate,
+				(unsigned long) steps[i].completed, (unsigned long) steps[i].sent);
+	}
+
+	printf("{\n");
+	printf("  \"target\": \"%s\",\n", device != NULL ? device : "in-process");
+	printf("  \"stepMs\": %lu,\n", (unsigned long) stepMs);
+	printf("  \"mix\": [");
+	for (uint32_t c = 0; c < MIX_COUNT; c++) {
+		printf("%s\"%s\"", c ? ", " : "", mix[c]);
+	}
+	printf("],\n");
+	printf("  \"steps\": [\n");
+	for (uint32_t i = 0; i < rateCount; i++) {
+		BenchStep_t *s = &steps[i];
+		double seconds = s->elapsedNs / 1e9;
+
+		printf("    {\"rate\": %lu, \"sent\": %lu, \"completed\": %lu, \"cmdPerSec\": %.1f, "
+				"\"p50Us\": %lu, \"p99Us\": %lu, \"maxUs\": %lu, \"queueDrops\": %ld, \"uartBytesPerCmd\": %.1f}%s\n",
+				(unsigned long) s->rate, (unsigned long) s->sent, (unsigned long) s->completed,
+				seconds > 0 ? s->completed / seconds : 0.0,
+				(unsigned long) s->p50Us, (unsigned long) s->p99Us, (unsigned long) s->maxUs, (long) s->queueDrops,
+				s->sent ? (double) s->bytes / s->sent : 0.0, i + 1 < rateCount ? "," : "");
+	}
+	printf("  ]\n");
+	printf("}\n");
+
+	return 0;
+}
+
+/* @brief: Terminal side of the in-process firmware, ends the process */
+static void *client(void *arg) {
+	fd = open((const char *) arg, O_RDWR | O_NOCTTY);
+	if (fd < 0) {
+		perror("bench_cli_load: pseudo-terminal");
+		_exit(1);
+	}
+
+	int status = bench();
+
+	fflush(stdout);
+	_exit(status);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+			device = argv[++i];
+		} else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+			stepMs = strtoul(argv[++i], NULL, 0);
+		} else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+			char *rate = argv[++i];
+			rateCount = 0;
+			while (*rate != '\0' && rateCount < BENCH_MAX_RATES) {
+				char *end;
+				rates[rateCount] = strtoul(rate, &end, 0);
+				if (end == rate) {
+					break;
+				}
+				if (rates[rateCount] != 0) {
+					rateCount++;
+				}
+				rate = end + (*end == ',');
+			}
+		} else {
+			fprintf(stderr, "usage: %s [-d device] [-t ms per step] [-r rate,rate,...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (device != NULL) {
+		struct termios tio;
+
+		fd = open(device, O_RDWR | O_NOCTTY);
+		if (fd < 0) {
+			perror(device);
+			return 1;
+		}
+
+		/* A board on a serial port, the simulator terminal is already raw */
+		if (tcgetattr(fd, &tio) == 0) {
+			cfmakeraw(&tio);
+			cfsetspeed(&tio, B115200);
+			tcsetattr(fd, TCSANOW, &tio);
+		}
+
+		return bench();
+	}
+
+	const char *pty = HostUart_OpenPty(NULL);
+	if (pty == NULL) {
+		perror("bench_cli_load: pseudo-terminal");
+		return 1;
+	}
+
+	pthread_t thread;
+	pthread_create(&thread, NULL, client, (void *) pty);
+
+	/* Same start-up as the simulator */
+	MX_USART2_UART_Init();
+	MX_SUBGHZ_Init();
+	HostSubghz_StartRealTime();
+
+	osKernelInitialize();
+	MX_FREERTOS_Init();
+	osKernelStart();
+
+	return 1;
+}
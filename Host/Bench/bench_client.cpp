@@ -0,0 +1,211 @@
+/*
+ * bench_client.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Client side throughput of Tools/libpwnrf. For every window size, calls are
+ * issued back to back through one connection and the calls/s completed are
+ * reported together with the latency of a full configure() batch, as JSON.
+ * Window 1 is the request/response baseline of a terminal script.
+ *
+ * Without -d the firmware runs in this process under the scheduler, like
+ * pwnrf_sim. With -d it talks to a simulator (pwnrf_sim -l) or a board.
+ *   bench_client [-d device] [-n calls] [-w window,window,...]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+extern "C" {
+#include "host.h"
+#include "usart.h"
+#include "subghz.h"
+#include "cmsis_os.h"
+
+/* Core/Src/app_freertos.c */
+void MX_FREERTOS_Init(void);
+}
+
+#include "pwnrf.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/********************************
+ * Defines
+ ********************************/
+#define BENCH_CONFIGURE_BATCHES 10
+
+/********************************
+ * Types
+ ********************************/
+struct BenchStep {
+	unsigned window;
+	uint32_t calls;
+	double seconds;
+	uint32_t configureP50Us, configureMaxUs;
+};
+
+/********************************
+ * Static Variables
+ ********************************/
+static std::string device;
+static uint32_t calls = 200;
+static std::vector<unsigned> windows = { 1, 2, 4 };
+
+/********************************
+ * Helpers
+ ********************************/
+static double elapsed(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/********************************
+ * Benchmark
+ ********************************/
+static void runStep(const std::string &path, BenchStep *step) {
+	pwnrf::Client client(path, step->window);
+
+	/* Config get/set pairs, the mix a tuning script issues */
+	std::vector<std::future<void>> sets;
+	std::vector<std::future<uint32_t>> gets;
+	sets.reserve(calls / 2);
+	gets.reserve(calls / 2);
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < calls / 2; i++) {
+		sets.push_back(client.setPower(1 + i % 22));
+		gets.push_back(client.getPower());
+	}
+	for (auto &set : sets) {
+		set.get();
+	}
+	for (auto &get : gets) {
+		get.get();
+	}
+	step->seconds = elapsed(start);
+	step->calls = calls / 2 * 2;
+
+	/* Every setting of the radio in one batch */
+	pwnrf::Config config;
+	config.freq = 433920000;
+	config.freqDeviation = 25000;
+	config.power = 14;
+	config.datarate = 2400;
+	config.preambleLength = 4;
+	config.crc = true;
+	config.syncword = "SYNC";
+
+	std::vector<uint32_t> latency;
+	for (uint32_t i = 0; i < BENCH_CONFIGURE_BATCHES; i++) {
+		start = std::chrono::steady_clock::now();
+		client.configure(config).get();
+		latency.push_back(static_cast<uint32_t>(elapsed(start) * 1e6));
+	}
+	std::sort(latency.begin(), latency.end());
+	step->configureP50Us = latency[latency.size() / 2];
+	step->configureMaxUs = latency.back();
+}
+
+static int bench(const std::string &path) {
+	std::vector<BenchStep> steps;
+
+	try {
+		for (unsigned window : windows) {
+			BenchStep step = {};
+			step.window = window;
+			runStep(path, &step);
+			fprintf(stderr, "window %u: %.1f calls/s\n", window, step.calls / step.seconds);
+			steps.push_back(step);
+		}
+	} catch (const std::exception &e) {
+		fprintf(stderr, "bench_client: %s\n", e.what());
+		return 1;
+	}
+
+	printf("{\n");
+	printf("  \"target\": \"%s\",\n", device.empty() ? "in-process" : device.c_str());
+	printf("  \"calls\": %lu,\n", (unsigned long) calls);
+	printf("  \"steps\": [\n");
+	for (size_t i = 0; i < steps.size(); i++) {
+		const BenchStep &s = steps[i];
+
+		printf("    {\"window\": %u, \"callsPerSec\": %.1f, \"configureP50Us\": %lu, \"configureMaxUs\": %lu}%s\n",
+				s.window, s.calls / s.seconds, (unsigned long) s.configureP50Us, (unsigned long) s.configureMaxUs,
+				i + 1 < steps.size() ? "," : "");
+	}
+	printf("  ]\n");
+	printf("}\n");
+
+	return 0;
+}
+
+/* @brief: Client side of the in-process firmware, ends the process */
+static void *run(void *arg) {
+	int status = bench(static_cast<const char *>(arg));
+
+	fflush(stdout);
+	_exit(status);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+			device = argv[++i];
+		} else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			calls = std::max(2UL, strtoul(argv[++i], NULL, 0));
+		} else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+			char *window = argv[++i];
+			windows.clear();
+			while (*window != '\0') {
+				char *end;
+				unsigned long value = strtoul(window, &end, 0);
+				if (end == window) {
+					break;
+				}
+				if (value != 0) {
+					windows.push_back(static_cast<unsigned>(value));
+				}
+				window = end + (*end == ',');
+			}
+		} else {
+			fprintf(stderr, "usage: %s [-d device] [-n calls] [-w window,window,...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (!device.empty()) {
+		return bench(device);
+	}
+
+	const char *pty = HostUart_OpenPty(NULL);
+	if (pty == NULL) {
+		perror("bench_client: pseudo-terminal");
+		return 1;
+	}
+
+	pthread_t thread;
+	pthread_create(&thread, NULL, run, const_cast<char *>(pty));
+
+	/* Same start-up as the simulator */
+	MX_USART2_UART_Init();
+	MX_SUBGHZ_Init();
+	HostSubghz_StartRealTime();
+
+	osKernelInitialize();
+	MX_FREERTOS_Init();
+	osKernelStart();
+
+	return 1;
+}
@@ -0,0 +1,97 @@
+/*
+ * bench_encode.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Table driven CRC and whitening of Lib/Src/Encode against the bitwise
+ * references, per byte of a maximum size payload. The last column is the
+ * share of a byte time at 500 kbps, the highest FSK datarate the CLI takes.
+ *   bench_encode [iterations]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "Encode/encode.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define BENCH_PAYLOAD 64
+#define BENCH_BYTE_NS_500K 16000.0
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint8_t payload[BENCH_PAYLOAD];
+static volatile uint32_t sink;
+
+static EncodeCrcTable_t crcTable;
+static EncodeWhiteningTable_t whiteningTable;
+
+/********************************
+ * Helpers
+ ********************************/
+static void report(const char *name, uint64_t bitwiseNs, uint64_t tableNs, uint32_t iterations) {
+	double bytes = (double) iterations * BENCH_PAYLOAD;
+	double bitwise = bitwiseNs / bytes, table = tableNs / bytes;
+
+	printf("%-20s %12.2f %12.2f %8.1fx %9.3f%%\n", name, bitwise, table, bitwise / table, 100.0 * table / BENCH_BYTE_NS_500K);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char **argv) {
+	uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 100000;
+
+	for (uint32_t i = 0; i < BENCH_PAYLOAD; i++) {
+		payload[i] = i * 37 + 11;
+	}
+
+	printf("%-20s %12s %12s %9s %10s\n", "kernel", "bitwise ns/B", "table ns/B", "speedup", "of 500k");
+
+	for (const EncodeCrcPreset_t *preset = Encode_CrcPresets; preset->name != NULL; preset++) {
+		Encode_CrcTableInit(&crcTable, &preset->crc);
+
+		uint64_t start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			sink += Encode_CrcBitwise(&preset->crc, payload, BENCH_PAYLOAD);
+		}
+		uint64_t bitwise = Host_GetTimeNs() - start;
+
+		start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			sink += Encode_Crc(&crcTable, payload, BENCH_PAYLOAD);
+		}
+		uint64_t table = Host_GetTimeNs() - start;
+
+		report(preset->name, bitwise, table, iterations);
+	}
+
+	for (const EncodeWhiteningPreset_t *preset = Encode_WhiteningPresets; preset->name != NULL; preset++) {
+		Encode_WhiteningTableInit(&whiteningTable, &preset->whitening);
+
+		uint64_t start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			Encode_WhitenBitwise(&preset->whitening, payload, BENCH_PAYLOAD);
+		}
+		uint64_t bitwise = Host_GetTimeNs() - start;
+
+		start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			Encode_Whiten(&whiteningTable, payload, BENCH_PAYLOAD);
+		}
+		uint64_t table = Host_GetTimeNs() - start;
+
+		report(preset->name, bitwise, table, iterations);
+	}
+
+	return 0;
+}
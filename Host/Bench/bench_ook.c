@@ -0,0 +1,67 @@
+/*
+ * bench_ook.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Time to encode a 64 bit remote code repeated 10 times, with the pattern
+ * tables of Lib/Src/Ook and with the chip at a time reference.
+ *   bench_ook [iterations]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "Ook/ook.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+static const OokProtocol_t protocols[] = {
+	/* EV1527 style PWM, 4 chips a bit */
+	{ .chipUs = 350, .zero = { 1, 350, 1050 }, .one = { 1, 1050, 350 }, .sync = { 1, 350, 10850 }, .repeats = 10 },
+	/* Manchester, 2 chips a bit */
+	{ .chipUs = 500, .zero = { 1, 500, 500 }, .one = { 0, 500, 500 }, .sync = { 1, 2000, 2000 }, .gapUs = 10000, .repeats = 10 },
+};
+static const char *const names[] = { "pwm", "manchester" };
+
+static const uint8_t code[8] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x23, 0x45, 0x67 };
+
+/* Larger than a radio packet, the encoder is not limited to one */
+static uint8_t out[1024];
+static volatile uint32_t sink;
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char **argv) {
+	uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 100000;
+	OokEncoder_t encoder;
+
+	printf("%-12s %8s %14s %14s %9s\n", "protocol", "chips", "reference us", "table us", "speedup");
+
+	for (uint32_t p = 0; p < sizeof(protocols) / sizeof(protocols[0]); p++) {
+		Ook_Compile(&encoder, &protocols[p]);
+
+		uint64_t start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			sink += Ook_EncodeReference(&protocols[p], code, 64, out, sizeof(out));
+		}
+		uint64_t reference = Host_GetTimeNs() - start;
+
+		start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			sink += Ook_Encode(&encoder, code, 64, out, sizeof(out));
+		}
+		uint64_t table = Host_GetTimeNs() - start;
+
+		printf("%-12s %8lu %14.3f %14.3f %8.1fx\n", names[p], (unsigned long) Ook_Encode(&encoder, code, 64, out, sizeof(out)),
+				reference / 1e3 / iterations, table / 1e3 / iterations, (double) reference / table);
+	}
+
+	return 0;
+}
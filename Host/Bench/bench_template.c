@@ -0,0 +1,57 @@
+/*
+ * bench_template.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Time to evaluate one packet of a payload template, the work the timer task
+ * does per packet in continuous mode.
+ *   bench_template [iterations]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "Template/template.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+static const char *const templates[] = {
+	"'pwnRF seq16",
+	"0xaa55 len seq32 time32 rand4 sum8",
+	"0xaa55 len seq32 time32 rand40 sum16:3 xor8",
+};
+
+static TemplateProgram_t program;
+static uint8_t out[TEMPLATE_MAX_PAYLOAD];
+static volatile uint32_t sink;
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char **argv) {
+	uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 1000000;
+	TemplateState_t state;
+
+	printf("%-46s %6s %6s %10s\n", "template", "bytes", "ops", "ns/packet");
+
+	for (uint32_t t = 0; t < sizeof(templates) / sizeof(templates[0]); t++) {
+		Template_Compile(&program, templates[t]);
+		Template_Reset(&program, &state, 1);
+
+		uint64_t start = Host_GetTimeNs();
+		for (uint32_t i = 0; i < iterations; i++) {
+			sink += Template_Evaluate(&program, &state, i, out);
+		}
+		uint64_t ns = Host_GetTimeNs() - start;
+
+		printf("%-46s %6u %6u %10.1f\n", templates[t], program.size, program.opCount, (double) ns / iterations);
+	}
+
+	return 0;
+}
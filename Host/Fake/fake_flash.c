@@ -0,0 +1,116 @@
+/*
+ * fake_flash.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Fake FLASH controller of the host build. The memory is HostFlash, erased to
+ * 0xFF at start. Like the real controller it only programs unlocked, aligned,
+ * erased double words and erases whole pages, refused accesses are counted.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "stm32wlxx_hal.h"
+#include "host.h"
+
+#include <string.h>
+
+/********************************
+ * Global Variables
+ ********************************/
+uint8_t HostFlash[FLASH_SIZE] __attribute__((aligned(FLASH_PAGE_SIZE)));
+
+/* Flash regions of STM32WL55JCIX_FLASH.ld */
+__asm__(".globl _sconfig_store\n .set _sconfig_store, HostFlash + 0x36000\n"
+		".globl _econfig_store\n .set _econfig_store, HostFlash + 0x38000\n"
+		".globl _spayload_store\n .set _spayload_store, HostFlash + 0x38000\n"
+		".globl _epayload_store\n .set _epayload_store, HostFlash + 0x40000\n");
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint8_t unlocked = 0;
+static HostFlashStats_t stats;
+static uint32_t pageErases[FLASH_PAGE_NB];
+
+/********************************
+ * Static Functions
+ ********************************/
+/* @brief: A fresh part, erased before the firmware reads it */
+__attribute__((constructor)) static void flashPowerOn(void) {
+	memset(HostFlash, 0xFF, sizeof(HostFlash));
+}
+
+/********************************
+ * Host Functions
+ ********************************/
+void HostFlash_Reset(void) {
+	memset(HostFlash, 0xFF, sizeof(HostFlash));
+	memset(&stats, 0, sizeof(stats));
+	memset(pageErases, 0, sizeof(pageErases));
+	unlocked = 0;
+}
+
+const HostFlashStats_t *HostFlash_Stats(void) {
+	return &stats;
+}
+
+uint32_t HostFlash_PageErases(uint32_t page) {
+	return page < FLASH_PAGE_NB ? pageErases[page] : 0;
+}
+
+/********************************
+ * HAL
+ ********************************/
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+	unlocked = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+	unlocked = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+	uint32_t offset = Address - FLASH_BASE;
+	uint64_t current;
+
+	if (!unlocked || TypeProgram != FLASH_TYPEPROGRAM_DOUBLEWORD || offset % 8 || offset >= FLASH_SIZE) {
+		stats.errors++;
+		return HAL_ERROR;
+	}
+
+	/* PROGERR: the double word was not erased */
+	memcpy(&current, &HostFlash[offset], sizeof(current));
+	if (current != UINT64_MAX) {
+		stats.errors++;
+		return HAL_ERROR;
+	}
+
+	memcpy(&HostFlash[offset], &Data, sizeof(Data));
+	stats.programs++;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError) {
+	*PageError = 0xFFFFFFFF;
+
+	if (!unlocked || pEraseInit->TypeErase != FLASH_TYPEERASE_PAGES || pEraseInit->NbPages == 0
+			|| pEraseInit->Page + pEraseInit->NbPages > FLASH_PAGE_NB) {
+		stats.errors++;
+		*PageError = pEraseInit->Page;
+		return HAL_ERROR;
+	}
+
+	for (uint32_t page = pEraseInit->Page; page < pEraseInit->Page + pEraseInit->NbPages; page++) {
+		memset(&HostFlash[page * FLASH_PAGE_SIZE], 0xFF, FLASH_PAGE_SIZE);
+		pageErases[page]++;
+		stats.erases++;
+	}
+
+	return HAL_OK;
+}
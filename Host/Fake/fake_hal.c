@@ -0,0 +1,165 @@
+/*
+ * fake_hal.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Core of the fake HAL: GPIO, the host clock, the DWT cycle counter and the
+ * linker script symbols used by the firmware. Interrupt masking is emulated
+ * by the FreeRTOS port in Host/Port/port.c.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "main.h"
+#include "host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/********************************
+ * Global Variables
+ ********************************/
+uint32_t SystemCoreClock = 48000000UL;
+
+GPIO_TypeDef HostGpioA, HostGpioB, HostGpioC;
+CoreDebug_Type HostCoreDebug;
+
+/* Linker script symbols, sized like the RAM regions of STM32WL55JCIX_FLASH.ld */
+static uint8_t hostRam1[32 * 1024] __attribute__((used));
+static uint8_t hostRam2[32 * 1024] __attribute__((used));
+__asm__(".globl _sdata\n .set _sdata, hostRam1\n"
+		".globl _ebss\n .set _ebss, hostRam1 + 0x2000\n"
+		".globl _estack\n .set _estack, hostRam1 + 0x8000\n"
+		".globl _Min_Stack_Size\n .set _Min_Stack_Size, 0x400\n"
+		".globl _sram2\n .set _sram2, hostRam2\n"
+		".globl _eram2\n .set _eram2, hostRam2\n");
+
+/********************************
+ * Static Variables
+ ********************************/
+/* Virtual clock, only moved by Host_SetTimeNs() */
+static uint8_t virtualTime = 0;
+static uint64_t virtualNow = 0;
+
+static DWT_Type dwt;
+static uint32_t dwtBase = 0;
+static uint32_t dwtLast = 0;
+
+/********************************
+ * Host Functions
+ ********************************/
+uint64_t Host_GetTimeNs(void) {
+	static uint64_t start = 0;
+	struct timespec ts;
+
+	if (virtualTime) {
+		return virtualNow;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t now = (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	if (start == 0) {
+		start = now;
+	}
+
+	return now - start;
+}
+
+void Host_SetVirtualTime(uint8_t enable) {
+	virtualNow = Host_GetTimeNs();
+	virtualTime = enable;
+}
+
+uint8_t Host_IsVirtualTime(void) {
+	return virtualTime;
+}
+
+void Host_SetTimeNs(uint64_t ns) {
+	if (virtualTime && ns > virtualNow) {
+		virtualNow = ns;
+	}
+}
+
+void Host_AssertFailed(const char *file, int line) {
+	fprintf(stderr, "assert failed: %s:%d\n", file, line);
+	abort();
+}
+
+/********************************
+ * Core
+ ********************************/
+DWT_Type *HostDwt(void) {
+	/* CYCCNT counts SystemCoreClock cycles of host time, a write to it sets the counter */
+	uint32_t raw = (uint32_t) (Host_GetTimeNs() * (SystemCoreClock / 1000000U) / 1000U);
+	if (dwt.CYCCNT != dwtLast) {
+		dwtBase = raw - dwt.CYCCNT;
+	}
+
+	dwt.CYCCNT = raw - dwtBase;
+	dwtLast = dwt.CYCCNT;
+
+	return &dwt;
+}
+
+void Error_Handler(void) {
+	Host_AssertFailed(__FILE__, __LINE__);
+}
+
+void HAL_Delay(uint32_t Delay) {
+	if (virtualTime) {
+		Host_SetTimeNs(virtualNow + Delay * 1000000ULL);
+		return;
+	}
+
+	struct timespec ts = {
+		.tv_sec = Delay / 1000,
+		.tv_nsec = (Delay % 1000) * 1000000L
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+uint32_t HAL_GetTick(void) {
+	return (uint32_t) (Host_GetTimeNs() / 1000000ULL);
+}
+
+void HAL_SuspendTick(void) {
+}
+
+void HAL_ResumeTick(void) {
+}
+
+/********************************
+ * GPIO
+ ********************************/
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+	if (GPIO_Init->Mode == GPIO_MODE_OUTPUT_PP) {
+		GPIOx->MODER |= GPIO_Init->Pin;
+	} else {
+		GPIOx->MODER &= ~GPIO_Init->Pin;
+	}
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin) {
+	GPIOx->MODER &= ~GPIO_Pin;
+	GPIOx->ODR &= ~GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+	if (PinState == GPIO_PIN_SET) {
+		GPIOx->ODR |= GPIO_Pin;
+	} else {
+		GPIOx->ODR &= ~GPIO_Pin;
+	}
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+	GPIOx->ODR ^= GPIO_Pin;
+}
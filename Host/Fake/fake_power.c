@@ -0,0 +1,61 @@
+/*
+ * fake_power.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Low power for the host build. The process never sleeps, so the power module
+ * (Lib/Src/Power/power.c, RTC and STOP2 specific) and the LPM driver
+ * (Core/Src/stm32_lpm_if.c) are replaced by no-ops.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Power/power.h"
+#include "stm32_lpm_if.h"
+
+#include <string.h>
+
+/********************************
+ * LPM Driver
+ ********************************/
+void PWR_EnterOffMode(void) {
+}
+
+void PWR_ExitOffMode(void) {
+}
+
+void PWR_EnterStopMode(void) {
+}
+
+void PWR_ExitStopMode(void) {
+}
+
+void PWR_EnterSleepMode(void) {
+}
+
+void PWR_ExitSleepMode(void) {
+}
+
+const struct UTIL_LPM_Driver_s UTIL_PowerDriver = {
+	PWR_EnterSleepMode,
+	PWR_ExitSleepMode,
+	PWR_EnterStopMode,
+	PWR_ExitStopMode,
+	PWR_EnterOffMode,
+	PWR_ExitOffMode,
+};
+
+/********************************
+ * Power Module
+ ********************************/
+void Power_Init(void) {
+}
+
+void Power_GetStats(PowerStats_t *stats) {
+	memset(stats, 0, sizeof(*stats));
+}
+
+void Power_AlarmIRQHandler(void) {
+}
@@ -0,0 +1,266 @@
+/*
+ * fake_subghz.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * SUBGHZ HAL for the host build. Accesses go to the behavioural radio model in
+ * subghz_model.c, commands are also recorded for the tests to inspect.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "subghz.h"
+#include "subghz_model.h"
+#include "Stats/stats.h"
+#include "host.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define HOST_SUBGHZ_MAX_CMDS 256
+
+/* Longest sleep of the real time thread, bounds the latency of newly started operations */
+#define HOST_SUBGHZ_POLL_NS 100000ULL
+
+/********************************
+ * Static Variables
+ ********************************/
+static HostSubghzCmd_t cmds[HOST_SUBGHZ_MAX_CMDS];
+static uint32_t cmdCount = 0;
+
+static SubghzModel_t radio;
+
+/********************************
+ * Static Functions
+ ********************************/
+static void subghzIsr(void) {
+	Stats_CountIrq(STATS_IRQ_SUBGHZ);
+	HAL_SUBGHZ_IRQHandler(&hsubghz);
+}
+
+static void radioIrq(SubghzModel_t *model) {
+	Host_RunIsr(SUBGHZ_Radio_IRQn, subghzIsr);
+}
+
+/* @brief: The radio events are processed on the core, in the radio interrupt */
+static void radioEventIsr(void) {
+	SubghzAir_Poll();
+}
+
+static void *realTimeThread(void *arg) {
+	(void) arg;
+
+	for (;;) {
+		uint64_t now = Host_GetTimeNs();
+		uint64_t next = SubghzAir_NextEventNs();
+
+		if (next != 0 && next <= now) {
+			Host_PendIrq(SUBGHZ_Radio_IRQn, radioEventIsr);
+			next = now + HOST_SUBGHZ_POLL_NS;
+		} else if (next == 0 || next > now + HOST_SUBGHZ_POLL_NS) {
+			next = now + HOST_SUBGHZ_POLL_NS;
+		}
+
+		struct timespec ts = {
+			.tv_sec = (next - now) / 1000000000ULL,
+			.tv_nsec = (next - now) % 1000000000ULL
+		};
+		nanosleep(&ts, NULL);
+	}
+
+	return NULL;
+}
+
+/********************************
+ * HAL Functions
+ ********************************/
+HAL_StatusTypeDef HAL_SUBGHZ_Init(SUBGHZ_HandleTypeDef *hsubghz) {
+	HAL_SUBGHZ_MspInit(hsubghz);
+
+	radio.irqHandler = radioIrq;
+	SubghzModel_Init(&radio, "hsubghz");
+	SubghzAir_Attach(&radio);
+
+	hsubghz->DeepSleep = 0;
+	hsubghz->ErrorCode = 0;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ExecSetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioSetCmd_t Command, uint8_t *pBuffer,
+		uint16_t Size) {
+	/* The log keeps the first commands, later ones are only applied */
+	if (cmdCount < HOST_SUBGHZ_MAX_CMDS) {
+		HostSubghzCmd_t *cmd = &cmds[cmdCount++];
+		cmd->opcode = Command;
+		cmd->size = Size;
+		memcpy(cmd->params, pBuffer, Size < sizeof(cmd->params) ? Size : sizeof(cmd->params));
+	}
+
+	SubghzModel_SetCmd(&radio, Command, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ExecGetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioGetCmd_t Command, uint8_t *pBuffer,
+		uint16_t Size) {
+	SubghzModel_GetCmd(&radio, Command, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_WriteBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size) {
+	SubghzModel_WriteBuffer(&radio, Offset, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ReadBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size) {
+	SubghzModel_ReadBuffer(&radio, Offset, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_WriteRegisters(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pBuffer,
+		uint16_t Size) {
+	SubghzModel_WriteRegisters(&radio, Address, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ReadRegisters(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pBuffer,
+		uint16_t Size) {
+	SubghzModel_ReadRegisters(&radio, Address, pBuffer, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_WriteRegister(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t Value) {
+	return HAL_SUBGHZ_WriteRegisters(hsubghz, Address, &Value, 1);
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ReadRegister(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pValue) {
+	return HAL_SUBGHZ_ReadRegisters(hsubghz, Address, pValue, 1);
+}
+
+/* @brief: Same dispatch order as the HAL driver */
+void HAL_SUBGHZ_IRQHandler(SUBGHZ_HandleTypeDef *hsubghz) {
+	uint8_t tmpisr[2] = {0};
+	uint16_t itsource;
+
+	HAL_SUBGHZ_ExecGetCmd(hsubghz, RADIO_GET_IRQSTATUS, tmpisr, 2);
+	itsource = ((uint16_t) tmpisr[0] << 8) | tmpisr[1];
+
+	if (itsource & SUBGHZ_IT_TX_CPLT) {
+		HAL_SUBGHZ_TxCpltCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_RX_CPLT) {
+		HAL_SUBGHZ_RxCpltCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_PREAMBLE_DETECTED) {
+		HAL_SUBGHZ_PreambleDetectedCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_SYNCWORD_VALID) {
+		HAL_SUBGHZ_SyncWordValidCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_HEADER_VALID) {
+		HAL_SUBGHZ_HeaderValidCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_HEADER_ERROR) {
+		HAL_SUBGHZ_HeaderErrorCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_CRC_ERROR) {
+		HAL_SUBGHZ_CRCErrorCallback(hsubghz);
+	}
+	if (itsource & SUBGHZ_IT_CAD_DONE) {
+		HAL_SUBGHZ_CADStatusCallback(hsubghz,
+				(itsource & SUBGHZ_IT_CAD_ACTIVITY_DETECTED) ? HAL_SUBGHZ_CAD_DETECTED : HAL_SUBGHZ_CAD_CLEAR);
+	}
+	if (itsource & SUBGHZ_IT_RX_TX_TIMEOUT) {
+		HAL_SUBGHZ_RxTxTimeoutCallback(hsubghz);
+	}
+
+	HAL_SUBGHZ_ExecSetCmd(hsubghz, RADIO_CLR_IRQSTATUS, tmpisr, 2);
+}
+
+/* Defaults for the callbacks radio_driver.c does not implement */
+__weak void HAL_SUBGHZ_TxCpltCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_RxCpltCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_PreambleDetectedCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_SyncWordValidCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_HeaderValidCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_HeaderErrorCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_CRCErrorCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+__weak void HAL_SUBGHZ_CADStatusCallback(SUBGHZ_HandleTypeDef *hsubghz, HAL_SUBGHZ_CadStatusTypeDef cadstatus) {
+}
+
+__weak void HAL_SUBGHZ_RxTxTimeoutCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+}
+
+/********************************
+ * Host Functions
+ ********************************/
+SubghzModel_t *HostSubghz_Model(void) {
+	return &radio;
+}
+
+void HostSubghz_ClearLog(void) {
+	cmdCount = 0;
+}
+
+uint32_t HostSubghz_CmdCount(void) {
+	return cmdCount;
+}
+
+const HostSubghzCmd_t *HostSubghz_Cmd(uint32_t index) {
+	return index < cmdCount ? &cmds[index] : NULL;
+}
+
+int32_t HostSubghz_FindLastCmd(uint8_t opcode) {
+	for (int32_t i = (int32_t) cmdCount - 1; i >= 0; i--) {
+		if (cmds[i].opcode == opcode) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+const uint8_t *HostSubghz_Buffer(void) {
+	return radio.buffer;
+}
+
+uint8_t HostSubghz_Register(uint16_t address) {
+	return radio.registers[address % SUBGHZ_MODEL_REG_SIZE];
+}
+
+void HostSubghz_RaiseIrq(uint16_t irq) {
+	SubghzModel_RaiseIrq(&radio, irq);
+}
+
+void HostSubghz_StartRealTime(void) {
+	pthread_t thread;
+
+	pthread_create(&thread, NULL, realTimeThread, NULL);
+	pthread_detach(thread);
+}
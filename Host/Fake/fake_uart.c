@@ -0,0 +1,273 @@
+/*
+ * fake_uart.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * USART2 for the host build. Core/Src/stm32_adv_trace_if.c runs unchanged on
+ * top of it. In the tests a DMA transfer completes when the test calls
+ * HostUart_Drain() and received bytes are delivered one RX interrupt at a time
+ * by HostUart_Inject(). Connected to a pseudo-terminal, a thread plays the
+ * wire: transfers complete after their time at 115200 baud and the bytes
+ * typed on the terminal arrive at the same rate.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "usart.h"
+#include "Stats/stats.h"
+#include "host.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define HOST_UART_OUTPUT_SIZE (64 * 1024)
+
+/* 10 bits per byte at 115200 baud */
+#define HOST_UART_BYTE_NS 86806ULL
+
+/********************************
+ * Global Variables
+ ********************************/
+UART_HandleTypeDef huart2;
+
+/********************************
+ * Static Variables
+ ********************************/
+static char output[HOST_UART_OUTPUT_SIZE + 1];
+static size_t outputLen = 0;
+
+/* Transfer started by HAL_UART_Transmit_DMA, completed by HostUart_Drain or the wire */
+static volatile uint8_t txBusy = 0;
+static volatile uint8_t txCplt = 0;
+static volatile uint64_t txDoneAt = 0;
+
+/* Destination armed by HAL_UART_Receive_IT and the byte being delivered */
+static uint8_t *volatile rxBuf = NULL;
+static volatile uint8_t rxByte;
+static volatile uint8_t rxFull = 0;
+
+/* Pseudo-terminal, master side, and the pipe waking the wire thread up */
+static int ptyFd = -1;
+static int wakeFd[2] = {-1, -1};
+static char ptyPath[64];
+
+/********************************
+ * Static Functions
+ ********************************/
+/* @brief: USART2 interrupt, TX complete and RX not empty like the status flags of the peripheral */
+static void uartIsr(void) {
+	Stats_CountIrq(STATS_IRQ_USART2);
+
+	if (rxFull && rxBuf != NULL) {
+		uint8_t *buf = rxBuf;
+		rxBuf = NULL;
+		*buf = rxByte;
+		HAL_UART_RxCpltCallback(&huart2);
+
+		/* The data register is free once the callback has armed the next reception */
+		rxFull = 0;
+	}
+
+	if (txCplt) {
+		txCplt = 0;
+		txBusy = 0;
+		HAL_UART_TxCpltCallback(&huart2);
+	}
+}
+
+static void sleepNs(uint64_t ns) {
+	struct timespec ts = {
+		.tv_sec = ns / 1000000000ULL,
+		.tv_nsec = ns % 1000000000ULL
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+/* @brief: Delivers a byte typed on the terminal, dropped if reception is not armed like an overrun */
+static void wireReceive(uint8_t byte) {
+	/* The previous byte is still in the data register */
+	while (rxFull) {
+		sleepNs(HOST_UART_BYTE_NS / 4);
+	}
+
+	if (rxBuf == NULL) {
+		return;
+	}
+
+	rxByte = byte;
+	rxFull = 1;
+	Host_PendIrq(USART2_IRQn, uartIsr);
+}
+
+static void *wireThread(void *arg) {
+	(void) arg;
+
+	for (;;) {
+		struct pollfd fds[2] = {
+			{ .fd = ptyFd, .events = POLLIN },
+			{ .fd = wakeFd[0], .events = POLLIN },
+		};
+		int timeout = -1;
+
+		if (txBusy && !txCplt) {
+			uint64_t now = Host_GetTimeNs();
+			if (now >= txDoneAt) {
+				txCplt = 1;
+				Host_PendIrq(USART2_IRQn, uartIsr);
+				continue;
+			}
+			timeout = (int) ((txDoneAt - now + 999999) / 1000000);
+		}
+
+		poll(fds, 2, timeout);
+
+		if (fds[1].revents & POLLIN) {
+			char discard[16];
+			(void) read(wakeFd[0], discard, sizeof(discard));
+		}
+
+		if (fds[0].revents & POLLIN) {
+			uint8_t data[64];
+			ssize_t len = read(ptyFd, data, sizeof(data));
+
+			for (ssize_t i = 0; i < len; i++) {
+				wireReceive(data[i]);
+				sleepNs(HOST_UART_BYTE_NS);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/********************************
+ * HAL Functions
+ ********************************/
+void MX_USART2_UART_Init(void) {
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size) {
+	if (txBusy) {
+		return HAL_BUSY;
+	}
+
+	/* Keeps the start of the log, the end is dropped once the capture is full */
+	size_t space = HOST_UART_OUTPUT_SIZE - outputLen;
+	size_t copy = Size < space ? Size : space;
+	memcpy(&output[outputLen], pData, copy);
+	outputLen += copy;
+	output[outputLen] = '\0';
+
+	if (ptyFd >= 0) {
+		/* Nobody reading the terminal is a disconnected cable, the data is lost */
+		(void) write(ptyFd, pData, Size);
+
+		txDoneAt = Host_GetTimeNs() + Size * HOST_UART_BYTE_NS;
+		txBusy = 1;
+		(void) write(wakeFd[1], "", 1);
+	} else {
+		txBusy = 1;
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+	if (Size != 1) {
+		return HAL_ERROR;
+	}
+
+	rxBuf = pData;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart) {
+	txBusy = 0;
+
+	return HAL_OK;
+}
+
+/********************************
+ * Host Functions
+ ********************************/
+void HostUart_Drain(void) {
+	while (txBusy) {
+		txCplt = 1;
+		Host_RunIsr(USART2_IRQn, uartIsr);
+	}
+}
+
+void HostUart_Inject(const char *data, size_t len) {
+	for (size_t i = 0; i < len; i++) {
+		if (rxBuf == NULL) {
+			/* Reception not started, the byte is lost like an overrun */
+			continue;
+		}
+
+		rxByte = (uint8_t) data[i];
+		rxFull = 1;
+		Host_RunIsr(USART2_IRQn, uartIsr);
+	}
+}
+
+const char *HostUart_OpenPty(const char *link) {
+	struct termios tio;
+	pthread_t thread;
+
+	ptyFd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (ptyFd < 0 || grantpt(ptyFd) != 0 || unlockpt(ptyFd) != 0 || pipe(wakeFd) != 0) {
+		return NULL;
+	}
+	snprintf(ptyPath, sizeof(ptyPath), "%s", ptsname(ptyFd));
+
+	/* Raw terminal, kept open so the master does not see a hang up between clients */
+	int slave = open(ptyPath, O_RDWR | O_NOCTTY);
+	if (slave < 0) {
+		return NULL;
+	}
+	tcgetattr(slave, &tio);
+	cfmakeraw(&tio);
+	cfsetspeed(&tio, B115200);
+	tcsetattr(slave, TCSANOW, &tio);
+
+	fcntl(ptyFd, F_SETFL, fcntl(ptyFd, F_GETFL) | O_NONBLOCK);
+
+	if (link != NULL) {
+		unlink(link);
+		if (symlink(ptyPath, link) != 0) {
+			return NULL;
+		}
+	}
+
+	pthread_create(&thread, NULL, wireThread, NULL);
+	pthread_detach(thread);
+
+	return ptyPath;
+}
+
+const char *HostUart_Output(void) {
+	return output;
+}
+
+size_t HostUart_OutputLen(void) {
+	return outputLen;
+}
+
+void HostUart_ClearOutput(void) {
+	outputLen = 0;
+	output[0] = '\0';
+}
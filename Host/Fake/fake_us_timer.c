@@ -0,0 +1,85 @@
+/*
+ * fake_us_timer.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * TIM2 compares for the host build, replacing Lib/Src/UsTimer/us_timer.c. The
+ * counter is the host clock in us. The air (subghz_model.c) runs the compares
+ * with its radio events, in time order in virtual time and from the real time
+ * thread otherwise, so a packet sent from a compare starts at its deadline.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "UsTimer/us_timer.h"
+#include "stm32wlxx_hal.h"
+#include "host.h"
+
+/********************************
+ * Static Variables
+ ********************************/
+static UsTimerCallback_t callbacks[US_TIMER_COUNT];
+static volatile uint64_t deadlines[US_TIMER_COUNT];	/* ns, 0 when the channel is stopped */
+
+/********************************
+ * Interface Functions
+ ********************************/
+void UsTimer_Init(void) {
+	for (uint32_t channel = 0; channel < US_TIMER_COUNT; channel++) {
+		deadlines[channel] = 0;
+	}
+}
+
+uint32_t UsTimer_Now(void) {
+	return (uint32_t) (Host_GetTimeNs() / 1000);
+}
+
+void UsTimer_Start(UsTimerChannel_t channel, uint32_t at, UsTimerCallback_t callback) {
+	uint64_t now = Host_GetTimeNs();
+	int32_t left = (int32_t) (at - (uint32_t) (now / 1000));
+
+	callbacks[channel] = callback;
+	deadlines[channel] = left > 0 ? now - now % 1000 + (uint64_t) left * 1000 : (now != 0 ? now : 1);
+}
+
+void UsTimer_Stop(UsTimerChannel_t channel) {
+	deadlines[channel] = 0;
+}
+
+void UsTimer_IRQHandler(void) {
+	uint64_t now = Host_GetTimeNs();
+
+	for (uint32_t channel = 0; channel < US_TIMER_COUNT; channel++) {
+		if (deadlines[channel] != 0 && deadlines[channel] <= now) {
+			deadlines[channel] = 0;
+			callbacks[channel]();
+		}
+	}
+}
+
+/********************************
+ * Host Functions
+ ********************************/
+uint64_t HostUsTimer_NextEventNs(void) {
+	uint64_t next = 0;
+
+	for (uint32_t channel = 0; channel < US_TIMER_COUNT; channel++) {
+		uint64_t deadline = deadlines[channel];
+
+		if (deadline != 0 && (next == 0 || deadline < next)) {
+			next = deadline;
+		}
+	}
+
+	return next;
+}
+
+void HostUsTimer_Poll(void) {
+	uint64_t next = HostUsTimer_NextEventNs();
+
+	if (next != 0 && next <= Host_GetTimeNs()) {
+		Host_RunIsr(TIM2_IRQn, UsTimer_IRQHandler);
+	}
+}
@@ -0,0 +1,718 @@
+/*
+ * subghz_model.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Behavioural model of the SUBGHZ radio. Timings are the typical values of the
+ * SX126x family datasheet the STM32WL radio is derived from. Only what the
+ * firmware uses is modelled: CAD, RX duty cycle and the radio statistics are
+ * accepted and ignored.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "subghz_model.h"
+#include "stm32wlxx_hal.h"
+#include "host.h"
+
+#include <math.h>
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_US 1000ULL
+
+/* Wake up from sleep, with and without the retained configuration */
+#define SUBGHZ_MODEL_WARM_START_NS (340 * NS_PER_US)
+#define SUBGHZ_MODEL_COLD_START_NS (3500 * NS_PER_US)
+
+#define SUBGHZ_MODEL_CMD_BUSY_NS (1 * NS_PER_US)
+#define SUBGHZ_MODEL_CALIBRATE_NS (3500 * NS_PER_US)
+#define SUBGHZ_MODEL_CALIBRATE_IMAGE_NS (1000 * NS_PER_US)
+
+/* RX/TX timeouts and the TCXO delay count 15.625 us steps */
+#define SUBGHZ_MODEL_STEP_NS 15625ULL
+
+#define SUBGHZ_MODEL_XTAL_HZ 32000000.0
+
+#define SUBGHZ_MODEL_REG_GFSK_SYNCWORD 0x06C0
+#define SUBGHZ_MODEL_REG_LORA_SYNCWORD 0x0740
+
+#define SUBGHZ_MODEL_DEFAULT_RSSI -50
+
+/********************************
+ * Static Variables
+ ********************************/
+static SubghzModel_t *air = NULL;
+
+/* @brief: BUSY time of a mode change, rows are the current mode and columns the new one */
+static const uint16_t switchTimeUs[6][6] = {
+	/*                 SLEEP STBY_RC STBY_XOSC FS  RX   TX */
+	/* SLEEP */		{ 0,    0,      0,        0,   0,   0   },
+	/* STBY_RC */	{ 0,    1,      31,       50,  83,  126 },
+	/* STBY_XOSC */	{ 0,    1,      1,        40,  62,  105 },
+	/* FS */		{ 0,    1,      1,        1,   15,  60  },
+	/* RX */		{ 0,    1,      1,        1,   15,  60  },
+	/* TX */		{ 0,    1,      1,        1,   15,  60  },
+};
+
+/* @brief: LoRa bandwidth in Hz indexed by the RADIO_SET_MODULATIONPARAMS code */
+static const double loraBandwidthHz[] = {
+	7810, 15630, 31250, 62500, 125000, 250000, 500000, 0,
+	10420, 20830, 41670,
+};
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint16_t readBe16(const uint8_t *data) {
+	return ((uint16_t) data[0] << 8) | data[1];
+}
+
+static uint32_t readBe24(const uint8_t *data) {
+	return ((uint32_t) data[0] << 16) | ((uint32_t) data[1] << 8) | data[2];
+}
+
+static void resetConfig(SubghzModel_t *model) {
+	model->fallbackMode = 0x20;
+	model->tcxoDelayNs = 0;
+	model->irqStatus = 0;
+	model->irqMask = 0;
+	memset(model->dioMask, 0, sizeof(model->dioMask));
+	model->packetType = SUBGHZ_MODEL_PACKET_GFSK;
+	model->freqReg = 0;
+	memset(model->modParams, 0, sizeof(model->modParams));
+	memset(model->pktParams, 0, sizeof(model->pktParams));
+	model->txBase = 0;
+	model->rxBase = 0;
+	memset(model->registers, 0, sizeof(model->registers));
+	memset(model->buffer, 0, sizeof(model->buffer));
+	model->opEnd = 0;
+	model->rxLength = 0;
+	model->rxStart = 0;
+}
+
+/* @brief: An access to a sleeping radio wakes it up, then the access waits for BUSY */
+static void wakeUp(SubghzModel_t *model) {
+	if (model->mode != SUBGHZ_MODEL_SLEEP) {
+		return;
+	}
+
+	if (!model->warmStart) {
+		resetConfig(model);
+	}
+
+	model->mode = SUBGHZ_MODEL_STDBY_RC;
+	model->busyUntil = Host_GetTimeNs() + (model->warmStart ? SUBGHZ_MODEL_WARM_START_NS : SUBGHZ_MODEL_COLD_START_NS);
+}
+
+static void setBusy(SubghzModel_t *model, uint64_t ns) {
+	model->busyUntil = Host_GetTimeNs() + ns;
+}
+
+static uint64_t switchTo(SubghzModel_t *model, SubghzModelMode_t mode) {
+	uint64_t ns = switchTimeUs[model->mode][mode] * NS_PER_US;
+
+	/* The TCXO starts with the crystal oscillator */
+	if (model->mode == SUBGHZ_MODEL_STDBY_RC && mode >= SUBGHZ_MODEL_STDBY_XOSC) {
+		ns += model->tcxoDelayNs;
+	}
+
+	model->mode = mode;
+	model->opEnd = 0;
+	setBusy(model, ns);
+
+	return ns;
+}
+
+static SubghzModelMode_t fallbackMode(const SubghzModel_t *model) {
+	switch (model->fallbackMode) {
+	case 0x40:
+		return SUBGHZ_MODEL_FS;
+	case 0x30:
+		return SUBGHZ_MODEL_STDBY_XOSC;
+	default:
+		return SUBGHZ_MODEL_STDBY_RC;
+	}
+}
+
+static uint8_t payloadLength(const SubghzModel_t *model) {
+	switch (model->packetType) {
+	case SUBGHZ_MODEL_PACKET_LORA:
+		return model->pktParams[3];
+	case SUBGHZ_MODEL_PACKET_BPSK:
+		return model->pktParams[0];
+	default:
+		return model->pktParams[6];
+	}
+}
+
+static uint8_t crcEnabled(const SubghzModel_t *model) {
+	if (model->packetType == SUBGHZ_MODEL_PACKET_LORA) {
+		return model->pktParams[4] != 0;
+	}
+
+	return model->packetType == SUBGHZ_MODEL_PACKET_GFSK && model->pktParams[7] != 0x01;
+}
+
+/* @brief: Bit rate of the GFSK and BPSK modulation parameters, 0 when not configured */
+static double bitRate(const SubghzModel_t *model) {
+	uint32_t reg = readBe24(model->modParams);
+
+	return reg ? 32.0 * SUBGHZ_MODEL_XTAL_HZ / reg : 0;
+}
+
+static uint8_t streaming(const SubghzModel_t *model) {
+	return model->mode == SUBGHZ_MODEL_TX && model->opEnd && model->packetType == SUBGHZ_MODEL_PACKET_GFSK
+			&& bitRate(model) > 0;
+}
+
+/* @brief: Preamble, sync word, address and length bits in front of a GFSK payload */
+static uint32_t gfskHeaderBits(const SubghzModel_t *model) {
+	uint32_t bits = readBe16(model->pktParams) + model->pktParams[3];
+
+	bits += model->pktParams[4] ? 8 : 0;		/* Address */
+	bits += model->pktParams[5] ? 8 : 0;		/* Length */
+
+	return bits;
+}
+
+static uint32_t gfskCrcBits(const SubghzModel_t *model) {
+	uint8_t crc = model->pktParams[7];
+
+	return (crc == 0x02 || crc == 0x06) ? 16 : (crc == 0x00 || crc == 0x04) ? 8 : 0;
+}
+
+/* @brief: Payload bytes of the current GFSK packet that left the buffer by now */
+static uint32_t txBytesSent(const SubghzModel_t *model, uint64_t now) {
+	double bitNs = 1e9 / bitRate(model);
+	double start = model->opStart + gfskHeaderBits(model) * bitNs;
+
+	if (now <= start) {
+		return 0;
+	}
+
+	uint64_t bytes = (uint64_t) ((now - start) / (8 * bitNs));
+
+	return bytes < model->txBytes ? bytes : model->txBytes;
+}
+
+/* @brief: Appends the payload bytes sent since the last call to txCapture */
+static void captureTx(SubghzModel_t *model, uint32_t sent) {
+	for (; model->txCaptured < sent; model->txCaptured++) {
+		if (model->txCapture != NULL && model->txCaptureLen < model->txCaptureSize) {
+			model->txCapture[model->txCaptureLen++] = model->buffer[(uint8_t) (model->txBase + model->txCaptured)];
+		}
+	}
+}
+
+static void prepareAccess(SubghzModel_t *model) {
+	wakeUp(model);
+	SubghzModel_WaitBusy(model);
+
+	/* The bytes sent so far were read before this access changes the buffer */
+	if (streaming(model) && !model->opTimeout) {
+		captureTx(model, txBytesSent(model, Host_GetTimeNs()));
+	}
+}
+
+/* @brief: Payload length register written during TX, the packet now ends at the new end address */
+static void extendTx(SubghzModel_t *model) {
+	uint32_t sent = txBytesSent(model, Host_GetTimeNs());
+
+	if (sent >= model->txBytes) {
+		/* The engine reached the old end, the packet is over */
+		return;
+	}
+
+	uint8_t pointer = model->txBase + sent;
+	uint8_t end = model->txBase + model->registers[SUBGHZ_MODEL_REG_PAYLOAD_LENGTH];
+
+	model->txBytes = sent + (uint8_t) (end - pointer);
+	model->opEnd = model->opStart + (uint64_t) ((gfskHeaderBits(model) + model->txBytes * 8 + gfskCrcBits(model)) * 1e9 / bitRate(model));
+}
+
+static uint64_t loraTimeOnAirNs(const SubghzModel_t *model, uint8_t payloadLength) {
+	uint8_t sf = model->modParams[0];
+	uint8_t bw = model->modParams[1];
+	uint8_t cr = model->modParams[2];
+	uint8_t ldro = model->modParams[3];
+
+	if (bw >= sizeof(loraBandwidthHz) / sizeof(loraBandwidthHz[0]) || loraBandwidthHz[bw] == 0 || sf < 5 || sf > 12) {
+		return 0;
+	}
+
+	double symbolS = (double) (1UL << sf) / loraBandwidthHz[bw];
+	uint16_t preamble = readBe16(model->pktParams);
+	uint8_t implicitHeader = model->pktParams[2];
+	uint8_t crc = model->pktParams[4] ? 1 : 0;
+
+	double num = 8.0 * payloadLength - 4.0 * sf + 28 + 16 * crc - 20 * implicitHeader;
+	double den = 4.0 * (sf - 2 * (ldro ? 1 : 0));
+	double payloadSymbols = 8 + fmax(ceil(num / den) * (cr + 4), 0);
+	double preambleSymbols = preamble + (sf < 7 ? 6.25 : 4.25);
+
+	return (uint64_t) ((preambleSymbols + payloadSymbols) * symbolS * 1e9);
+}
+
+static uint8_t modulationMatches(const SubghzModel_t *a, const SubghzModel_t *b) {
+	if (a->packetType == SUBGHZ_MODEL_PACKET_LORA) {
+		/* Spreading factor, bandwidth and IQ inversion */
+		return a->modParams[0] == b->modParams[0] && a->modParams[1] == b->modParams[1]
+				&& a->pktParams[5] == b->pktParams[5];
+	}
+
+	/* Bit rate, the receiver bandwidth and deviation do not have to be exact */
+	return !memcmp(a->modParams, b->modParams, 3);
+}
+
+static uint8_t syncWordMatches(const SubghzModel_t *a, const SubghzModel_t *b) {
+	switch (a->packetType) {
+	case SUBGHZ_MODEL_PACKET_GFSK: {
+		uint8_t bits = a->pktParams[3];
+		if (bits != b->pktParams[3]) {
+			return 0;
+		}
+		return !memcmp(&a->registers[SUBGHZ_MODEL_REG_GFSK_SYNCWORD], &b->registers[SUBGHZ_MODEL_REG_GFSK_SYNCWORD],
+				(bits + 7) / 8);
+	}
+	case SUBGHZ_MODEL_PACKET_LORA:
+		return !memcmp(&a->registers[SUBGHZ_MODEL_REG_LORA_SYNCWORD], &b->registers[SUBGHZ_MODEL_REG_LORA_SYNCWORD], 2);
+	default:
+		return 1;
+	}
+}
+
+/* @brief: Latches the IRQs enabled in the mask and runs the interrupt when one is routed to a DIO */
+static void latchIrq(SubghzModel_t *model, uint16_t irq) {
+	model->irqStatus |= irq & model->irqMask;
+
+	uint16_t routed = model->dioMask[0] | model->dioMask[1] | model->dioMask[2];
+	if ((model->irqStatus & routed) && model->irqHandler != NULL) {
+		model->irqHandler(model);
+	}
+}
+
+static void receive(SubghzModel_t *rx, const SubghzModel_t *tx, uint64_t now) {
+	uint8_t txLength = payloadLength(tx);
+	uint8_t length = txLength;
+
+	/* Fixed length packets are received with the length the receiver expects */
+	if ((rx->packetType == SUBGHZ_MODEL_PACKET_GFSK && rx->pktParams[5] == 0)
+			|| (rx->packetType == SUBGHZ_MODEL_PACKET_LORA && rx->pktParams[2] != 0)) {
+		length = payloadLength(rx);
+	}
+
+	for (uint16_t i = 0; i < length; i++) {
+		rx->buffer[(uint8_t) (rx->rxBase + i)] = tx->buffer[(uint8_t) (tx->txBase + i)];
+	}
+	rx->rxLength = length;
+	rx->rxStart = rx->rxBase;
+
+	uint16_t irq = SUBGHZ_IT_PREAMBLE_DETECTED | SUBGHZ_IT_RX_CPLT;
+	if (rx->packetType == SUBGHZ_MODEL_PACKET_LORA) {
+		irq |= rx->pktParams[2] ? 0 : SUBGHZ_IT_HEADER_VALID;
+	} else {
+		irq |= SUBGHZ_IT_SYNCWORD_VALID;
+	}
+
+	/* A different length, CRC or whitening configuration garbles the packet */
+	uint8_t garbled = length != txLength;
+	if (rx->packetType == SUBGHZ_MODEL_PACKET_GFSK) {
+		garbled |= rx->pktParams[7] != tx->pktParams[7] || rx->pktParams[8] != tx->pktParams[8];
+	} else if (rx->packetType == SUBGHZ_MODEL_PACKET_LORA) {
+		garbled |= rx->pktParams[4] != tx->pktParams[4];
+	}
+	if (garbled && crcEnabled(rx)) {
+		irq |= SUBGHZ_IT_CRC_ERROR;
+		rx->stats.rxCrcErrors++;
+	}
+
+	rx->stats.rxPackets++;
+
+	if (rx->rxContinuous) {
+		rx->opStart = now;
+	} else {
+		rx->mode = fallbackMode(rx);
+		rx->opEnd = 0;
+	}
+
+	latchIrq(rx, irq);
+}
+
+/* @brief: The packet of tx ends, every receiver listening since it started gets it */
+static void deliver(const SubghzModel_t *tx, uint64_t now) {
+	for (SubghzModel_t *rx = air; rx != NULL; rx = rx->next) {
+		if (rx == tx || rx->mode != SUBGHZ_MODEL_RX || rx->opStart > tx->opStart) {
+			continue;
+		}
+		if (rx->packetType != tx->packetType || rx->freqReg != tx->freqReg) {
+			continue;
+		}
+		if (!modulationMatches(rx, tx) || !syncWordMatches(rx, tx)) {
+			continue;
+		}
+
+		receive(rx, tx, now);
+	}
+}
+
+static void process(SubghzModel_t *model, uint64_t now) {
+	uint8_t timeout = model->opTimeout;
+	model->opEnd = 0;
+
+	if (model->mode == SUBGHZ_MODEL_TX) {
+		model->mode = fallbackMode(model);
+		if (timeout) {
+			latchIrq(model, SUBGHZ_IT_RX_TX_TIMEOUT);
+			return;
+		}
+
+		if (model->packetType == SUBGHZ_MODEL_PACKET_GFSK) {
+			captureTx(model, model->txBytes);
+		}
+
+		model->stats.txPackets++;
+		model->stats.txAirNs += now - model->opStart;
+		deliver(model, now);
+		latchIrq(model, SUBGHZ_IT_TX_CPLT);
+	} else if (model->mode == SUBGHZ_MODEL_RX) {
+		model->mode = SUBGHZ_MODEL_STDBY_RC;
+		model->stats.rxTimeouts++;
+		latchIrq(model, SUBGHZ_IT_RX_TX_TIMEOUT);
+	}
+}
+
+/* @brief: Instance with the earliest event due by limit */
+static SubghzModel_t *nextEvent(uint64_t limit) {
+	SubghzModel_t *next = NULL;
+
+	for (SubghzModel_t *model = air; model != NULL; model = model->next) {
+		if (model->opEnd && model->opEnd <= limit && (next == NULL || model->opEnd < next->opEnd)) {
+			next = model;
+		}
+	}
+
+	return next;
+}
+
+static void startTx(SubghzModel_t *model, uint32_t timeout) {
+	switchTo(model, SUBGHZ_MODEL_TX);
+
+	/* The packet goes on air once the PA has ramped up, at the end of BUSY */
+	uint64_t airNs = SubghzModel_TimeOnAirNs(model, payloadLength(model));
+	uint64_t timeoutNs = timeout * SUBGHZ_MODEL_STEP_NS;
+
+	model->opStart = model->busyUntil;
+	model->opEnd = model->opStart + airNs;
+	model->opTimeout = 0;
+	model->txBytes = payloadLength(model);
+	model->txCaptured = 0;
+	if (timeout && timeoutNs < airNs) {
+		model->opEnd = model->opStart + timeoutNs;
+		model->opTimeout = 1;
+	}
+}
+
+static void startRx(SubghzModel_t *model, uint32_t timeout) {
+	switchTo(model, SUBGHZ_MODEL_RX);
+
+	model->opStart = model->busyUntil;
+	model->rxContinuous = timeout == SUBGHZ_MODEL_RX_CONTINUOUS;
+	model->opTimeout = 1;
+	if (timeout && !model->rxContinuous) {
+		model->opEnd = model->opStart + timeout * SUBGHZ_MODEL_STEP_NS;
+	}
+}
+
+/********************************
+ * Model
+ ********************************/
+void SubghzModel_Init(SubghzModel_t *model, const char *name) {
+	SubghzModel_t *next = model->next;
+	void (*irqHandler)(SubghzModel_t *model) = model->irqHandler;
+	void *context = model->context;
+
+	/* Attachment and interrupt binding survive a reset */
+	memset(model, 0, sizeof(*model));
+	model->name = name;
+	model->next = next;
+	model->irqHandler = irqHandler;
+	model->context = context;
+
+	resetConfig(model);
+	model->mode = SUBGHZ_MODEL_STDBY_RC;
+	model->rssi = SUBGHZ_MODEL_DEFAULT_RSSI;
+	setBusy(model, SUBGHZ_MODEL_COLD_START_NS);
+}
+
+uint8_t SubghzModel_IsBusy(const SubghzModel_t *model) {
+	return Host_GetTimeNs() < model->busyUntil;
+}
+
+void SubghzModel_WaitBusy(SubghzModel_t *model) {
+	uint64_t now = Host_GetTimeNs();
+	if (now >= model->busyUntil) {
+		return;
+	}
+
+	model->stats.busyWaits++;
+	model->stats.busyWaitNs += model->busyUntil - now;
+
+	Host_SetTimeNs(model->busyUntil);
+	while (Host_GetTimeNs() < model->busyUntil) {
+		/* Real time clock, spin like the HAL does on the BUSY flag */
+	}
+}
+
+void SubghzModel_SetCmd(SubghzModel_t *model, uint8_t opcode, const uint8_t *params, uint16_t size) {
+	uint8_t p[16] = {0};
+
+	prepareAccess(model);
+	memcpy(p, params, size < sizeof(p) ? size : sizeof(p));
+
+	switch (opcode) {
+	case RADIO_SET_SLEEP:
+		model->mode = SUBGHZ_MODEL_SLEEP;
+		model->warmStart = (p[0] & 0x04) != 0;
+		model->opEnd = 0;
+		return;
+	case RADIO_SET_STANDBY:
+		switchTo(model, p[0] ? SUBGHZ_MODEL_STDBY_XOSC : SUBGHZ_MODEL_STDBY_RC);
+		return;
+	case RADIO_SET_FS:
+		switchTo(model, SUBGHZ_MODEL_FS);
+		return;
+	case RADIO_SET_TX:
+		startTx(model, readBe24(p));
+		return;
+	case RADIO_SET_RX:
+		startRx(model, readBe24(p));
+		return;
+	case RADIO_SET_TXCONTINUOUSWAVE:
+	case RADIO_SET_TXCONTINUOUSPREAMBLE:
+		/* On air until the next mode change, nothing is delivered */
+		switchTo(model, SUBGHZ_MODEL_TX);
+		return;
+	case RADIO_CALIBRATE:
+		setBusy(model, SUBGHZ_MODEL_CALIBRATE_NS);
+		return;
+	case RADIO_CALIBRATEIMAGE:
+		setBusy(model, SUBGHZ_MODEL_CALIBRATE_IMAGE_NS);
+		return;
+	case RADIO_SET_PACKETTYPE:
+		model->packetType = p[0];
+		break;
+	case RADIO_SET_RFFREQUENCY:
+		model->freqReg = ((uint32_t) readBe16(p) << 16) | readBe16(&p[2]);
+		break;
+	case RADIO_SET_MODULATIONPARAMS:
+		memset(model->modParams, 0, sizeof(model->modParams));
+		memcpy(model->modParams, p, size < sizeof(model->modParams) ? size : sizeof(model->modParams));
+		break;
+	case RADIO_SET_PACKETPARAMS:
+		memset(model->pktParams, 0, sizeof(model->pktParams));
+		memcpy(model->pktParams, p, size < sizeof(model->pktParams) ? size : sizeof(model->pktParams));
+		model->registers[SUBGHZ_MODEL_REG_PAYLOAD_LENGTH] = payloadLength(model);
+		break;
+	case RADIO_SET_BUFFERBASEADDRESS:
+		model->txBase = p[0];
+		model->rxBase = p[1];
+		break;
+	case RADIO_CFG_DIOIRQ:
+		model->irqMask = readBe16(&p[0]);
+		model->dioMask[0] = readBe16(&p[2]);
+		model->dioMask[1] = readBe16(&p[4]);
+		model->dioMask[2] = readBe16(&p[6]);
+		break;
+	case RADIO_CLR_IRQSTATUS:
+		model->irqStatus &= ~readBe16(p);
+		break;
+	case RADIO_SET_TXFALLBACKMODE:
+		model->fallbackMode = p[0];
+		break;
+	case RADIO_SET_TCXOMODE:
+		model->tcxoDelayNs = readBe24(&p[1]) * SUBGHZ_MODEL_STEP_NS;
+		break;
+	default:
+		break;
+	}
+
+	setBusy(model, SUBGHZ_MODEL_CMD_BUSY_NS);
+}
+
+void SubghzModel_GetCmd(SubghzModel_t *model, uint8_t opcode, uint8_t *data, uint16_t size) {
+	uint8_t r[4] = {0};
+	static const uint8_t modeCode[] = {0x0, 0x2, 0x3, 0x4, 0x5, 0x6};
+
+	prepareAccess(model);
+
+	switch (opcode) {
+	case RADIO_GET_STATUS:
+		r[0] = modeCode[model->mode] << 4;
+		break;
+	case RADIO_GET_PACKETTYPE:
+		r[0] = model->packetType;
+		break;
+	case RADIO_GET_IRQSTATUS:
+		r[0] = model->irqStatus >> 8;
+		r[1] = model->irqStatus & 0xFF;
+		break;
+	case RADIO_GET_RXBUFFERSTATUS:
+		r[0] = model->rxLength;
+		r[1] = model->rxStart;
+		break;
+	case RADIO_GET_PACKETSTATUS:
+		/* GFSK: status, RSSI sync, RSSI average. LoRa: RSSI, SNR, signal RSSI */
+		r[0] = model->packetType == SUBGHZ_MODEL_PACKET_LORA ? (uint8_t) (-2 * model->rssi) : 0;
+		r[1] = model->packetType == SUBGHZ_MODEL_PACKET_LORA ? 10 * 4 : (uint8_t) (-2 * model->rssi);
+		r[2] = (uint8_t) (-2 * model->rssi);
+		break;
+	case RADIO_GET_RSSIINST:
+		r[0] = (uint8_t) (-2 * model->rssi);
+		break;
+	default:
+		break;
+	}
+
+	memset(data, 0, size);
+	memcpy(data, r, size < sizeof(r) ? size : sizeof(r));
+}
+
+void SubghzModel_WriteBuffer(SubghzModel_t *model, uint8_t offset, const uint8_t *data, uint16_t size) {
+	prepareAccess(model);
+
+	for (uint16_t i = 0; i < size; i++) {
+		model->buffer[(uint8_t) (offset + i)] = data[i];
+	}
+}
+
+void SubghzModel_ReadBuffer(SubghzModel_t *model, uint8_t offset, uint8_t *data, uint16_t size) {
+	prepareAccess(model);
+
+	for (uint16_t i = 0; i < size; i++) {
+		data[i] = model->buffer[(uint8_t) (offset + i)];
+	}
+}
+
+void SubghzModel_WriteRegisters(SubghzModel_t *model, uint16_t address, const uint8_t *data, uint16_t size) {
+	prepareAccess(model);
+
+	for (uint16_t i = 0; i < size; i++) {
+		uint16_t reg = (address + i) % SUBGHZ_MODEL_REG_SIZE;
+		model->registers[reg] = data[i];
+
+		if (reg == SUBGHZ_MODEL_REG_PAYLOAD_LENGTH && streaming(model) && !model->opTimeout) {
+			extendTx(model);
+		}
+	}
+}
+
+void SubghzModel_ReadRegisters(SubghzModel_t *model, uint16_t address, uint8_t *data, uint16_t size) {
+	prepareAccess(model);
+
+	if (streaming(model)) {
+		model->registers[SUBGHZ_MODEL_REG_TX_POINTER] = model->txBase + txBytesSent(model, Host_GetTimeNs());
+	}
+
+	for (uint16_t i = 0; i < size; i++) {
+		data[i] = model->registers[(address + i) % SUBGHZ_MODEL_REG_SIZE];
+	}
+}
+
+void SubghzModel_RaiseIrq(SubghzModel_t *model, uint16_t irq) {
+	model->irqStatus |= irq;
+
+	if (model->irqHandler != NULL) {
+		model->irqHandler(model);
+	}
+}
+
+uint64_t SubghzModel_TimeOnAirNs(const SubghzModel_t *model, uint8_t payloadLength) {
+	double bitsPerSecond = bitRate(model);
+	uint32_t bits;
+
+	switch (model->packetType) {
+	case SUBGHZ_MODEL_PACKET_LORA:
+		return loraTimeOnAirNs(model, payloadLength);
+	case SUBGHZ_MODEL_PACKET_BPSK:
+		/* Preamble and sync are part of the DBPSK payload */
+		bits = payloadLength * 8;
+		break;
+	default:
+		bits = gfskHeaderBits(model) + payloadLength * 8 + gfskCrcBits(model);
+		break;
+	}
+
+	return bitsPerSecond > 0 ? (uint64_t) (bits * 1e9 / bitsPerSecond) : 0;
+}
+
+/********************************
+ * Air
+ ********************************/
+void SubghzAir_Attach(SubghzModel_t *model) {
+	for (SubghzModel_t *it = air; it != NULL; it = it->next) {
+		if (it == model) {
+			return;
+		}
+	}
+
+	model->next = air;
+	air = model;
+}
+
+void SubghzAir_Detach(SubghzModel_t *model) {
+	for (SubghzModel_t **it = &air; *it != NULL; it = &(*it)->next) {
+		if (*it == model) {
+			*it = model->next;
+			model->next = NULL;
+			return;
+		}
+	}
+}
+
+void SubghzAir_Poll(void) {
+	SubghzModel_t *model;
+
+	HostUsTimer_Poll();
+	while ((model = nextEvent(Host_GetTimeNs())) != NULL) {
+		process(model, model->opEnd);
+		HostUsTimer_Poll();
+	}
+}
+
+uint64_t SubghzAir_NextEventNs(void) {
+	SubghzModel_t *model = nextEvent(UINT64_MAX);
+	uint64_t timer = HostUsTimer_NextEventNs();
+
+	if (model == NULL || (timer != 0 && timer < model->opEnd)) {
+		return timer;
+	}
+
+	return model->opEnd;
+}
+
+void SubghzAir_Advance(uint64_t ns) {
+	uint64_t target = Host_GetTimeNs() + ns;
+
+	for (;;) {
+		SubghzModel_t *model = nextEvent(target);
+		uint64_t timer = HostUsTimer_NextEventNs();
+
+		/* A compare first, the packet it sends ends later */
+		if (timer != 0 && timer <= target && (model == NULL || timer <= model->opEnd)) {
+			Host_SetTimeNs(timer);
+			HostUsTimer_Poll();
+		} else if (model != NULL) {
+			Host_SetTimeNs(model->opEnd);
+			process(model, model->opEnd);
+		} else {
+			break;
+		}
+	}
+
+	Host_SetTimeNs(target);
+}
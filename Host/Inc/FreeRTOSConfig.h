@@ -0,0 +1,81 @@
+/*
+ * FreeRTOSConfig.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Host copy of Core/Inc/FreeRTOSConfig.h. Kernel sizes and features match the
+ * target, the Cortex-M specific parts (handler names, tickless STOP2, newlib
+ * reentrancy) are left out. Keep both in sync.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+extern uint32_t SystemCoreClock;
+
+#define configENABLE_FPU                         0
+#define configENABLE_MPU                         0
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+/* The idle task waits for interrupts in vApplicationIdleHook (Port/port.c) instead of spinning */
+#define configUSE_IDLE_HOOK                      1
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( SystemCoreClock )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 56 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)1024)
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 25 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             256
+
+#define configUSE_NEWLIB_REENTRANT               0
+
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        0
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTimerPendFunctionCall       1
+#define INCLUDE_xQueueGetMutexHolder         1
+#define INCLUDE_uxTaskGetStackHighWaterMark  1
+#define INCLUDE_eTaskGetState                1
+
+#define USE_FreeRTOS_HEAP_4
+
+/* Failed asserts abort the test instead of spinning forever */
+extern void Host_AssertFailed(const char *file, int line);
+#define configASSERT( x ) if ((x) == 0) { Host_AssertFailed(__FILE__, __LINE__); }
+
+#define configCOMMAND_INT_MAX_OUTPUT_SIZE 1
+
+/* Run time statistics from the emulated DWT cycle counter, see Lib/Src/Stats/stats.c */
+#define configGENERATE_RUN_TIME_STATS 1
+extern void Stats_InitRunTimeCounter(void);
+extern uint32_t Stats_GetRunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() Stats_InitRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE() Stats_GetRunTimeCounter()
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,59 @@
+/*
+ * cmsis_compiler.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Host stand-in for the CMSIS core intrinsics. Interrupt masking and the
+ * exception number are emulated by Host/Port, see host.h.
+ */
+
+#ifndef HOST_CMSIS_COMPILER_H_
+#define HOST_CMSIS_COMPILER_H_
+
+#include <stdint.h>
+
+#include "host.h"
+
+#ifndef __ASM
+#define __ASM __asm
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+
+#define __disable_irq() Host_DisableIrq()
+#define __enable_irq() Host_EnableIrq()
+#define __get_PRIMASK() Host_GetPrimask()
+#define __set_PRIMASK(x) Host_SetPrimask(x)
+#define __get_BASEPRI() (0U)
+#define __get_IPSR() Host_GetIpsr()
+
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __NOP() do { } while (0)
+#define __WFI() Host_WaitForInterrupt()
+
+#endif /* HOST_CMSIS_COMPILER_H_ */
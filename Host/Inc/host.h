@@ -0,0 +1,142 @@
+/*
+ * host.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Control interface of the host build. Tests and benchmarks use it to drive the
+ * fake peripherals in Host/Fake the way the hardware would.
+ */
+
+#ifndef HOST_HOST_H_
+#define HOST_HOST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************
+ * Types
+ ********************************/
+struct SubghzModel_s;
+
+typedef struct {
+	uint8_t opcode;
+	uint8_t params[16];
+	uint16_t size;
+} HostSubghzCmd_t;
+
+/********************************
+ * Interrupt Emulation
+ ********************************/
+/* PRIMASK and IPSR of the emulated core, shared by all threads of the process */
+void Host_DisableIrq(void);
+void Host_EnableIrq(void);
+uint32_t Host_GetPrimask(void);
+void Host_SetPrimask(uint32_t primask);
+uint32_t Host_GetIpsr(void);
+void Host_WaitForInterrupt(void);
+
+/* @brief: Runs handler as exception number irqn, with IPSR set for the duration of the call */
+void Host_RunIsr(uint32_t irqn, void (*handler)(void));
+
+/*
+ * @brief: Pends an interrupt, safe to call from any host thread. It runs on the core
+ * as soon as PRIMASK allows: right away before the scheduler starts, on the thread
+ * of the running task once it has.
+ */
+void Host_PendIrq(uint32_t irqn, void (*handler)(void));
+
+/* @brief: Monotonic time since the process started, or the virtual clock when it is enabled */
+uint64_t Host_GetTimeNs(void);
+
+/*
+ * @brief: Freezes the clock at the current time, from then on it only moves with
+ * Host_SetTimeNs() and HAL_Delay(). Makes the timing of the SUBGHZ model deterministic.
+ */
+void Host_SetVirtualTime(uint8_t enable);
+uint8_t Host_IsVirtualTime(void);
+
+/* @brief: Moves the virtual clock forward to ns, ignored in real time */
+void Host_SetTimeNs(uint64_t ns);
+
+/* @brief: configASSERT and Error_Handler, prints the location and aborts */
+void Host_AssertFailed(const char *file, int line);
+
+/********************************
+ * USART2
+ ********************************/
+/* @brief: Completes the pending TX DMA transfers, calling the TX complete interrupt until the trace FIFO is empty */
+void HostUart_Drain(void);
+
+/* @brief: Feeds bytes to the RX interrupt, one interrupt per byte like the real UART */
+void HostUart_Inject(const char *data, size_t len);
+
+/*
+ * @brief: Connects USART2 to a new pseudo-terminal at 115200 baud and returns the path
+ * of its slave side, also linked from link when it is not NULL. NULL on failure.
+ */
+const char *HostUart_OpenPty(const char *link);
+
+/* @brief: Everything transmitted so far, NUL terminated */
+const char *HostUart_Output(void);
+size_t HostUart_OutputLen(void);
+void HostUart_ClearOutput(void);
+
+/********************************
+ * FLASH
+ ********************************/
+typedef struct {
+	uint32_t erases;			/* Pages erased */
+	uint32_t programs;			/* Double words programmed */
+	uint32_t errors;			/* Accesses the real controller would have refused */
+} HostFlashStats_t;
+
+/* @brief: Erases the whole flash, like a fresh part, and clears the statistics */
+void HostFlash_Reset(void);
+const HostFlashStats_t *HostFlash_Stats(void);
+/* @brief: Erase count of a page, the wear the firmware put on it */
+uint32_t HostFlash_PageErases(uint32_t page);
+
+/********************************
+ * TIM2
+ ********************************/
+/* @brief: Time of the earliest armed compare of UsTimer, 0 when none is armed */
+uint64_t HostUsTimer_NextEventNs(void);
+
+/* @brief: Runs the TIM2 interrupt when a compare is due by the current host time */
+void HostUsTimer_Poll(void);
+
+/********************************
+ * SUBGHZ
+ ********************************/
+/* @brief: The radio behind hsubghz, attached to the air (Inc/subghz_model.h) */
+struct SubghzModel_s *HostSubghz_Model(void);
+
+/* @brief: Clears the command log, the radio state is kept */
+void HostSubghz_ClearLog(void);
+
+/* @brief: Commands sent with HAL_SUBGHZ_ExecSetCmd, oldest first */
+uint32_t HostSubghz_CmdCount(void);
+const HostSubghzCmd_t *HostSubghz_Cmd(uint32_t index);
+
+/* @brief: Index of the last command with this opcode, -1 if it was never sent */
+int32_t HostSubghz_FindLastCmd(uint8_t opcode);
+
+const uint8_t *HostSubghz_Buffer(void);
+uint8_t HostSubghz_Register(uint16_t address);
+
+/* @brief: Sets IRQ status bits and runs the SUBGHZ radio interrupt, whatever the radio is doing */
+void HostSubghz_RaiseIrq(uint16_t irq);
+
+/* @brief: Starts a thread running the radio events of the air in real time, through the radio interrupt */
+void HostSubghz_StartRealTime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HOST_H_ */
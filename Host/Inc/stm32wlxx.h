@@ -0,0 +1,15 @@
+/*
+ * stm32wlxx.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Host stand-in for the device header, everything needed lives in stm32wlxx_hal.h
+ */
+
+#ifndef HOST_STM32WLXX_H_
+#define HOST_STM32WLXX_H_
+
+#include "stm32wlxx_hal.h"
+
+#endif /* HOST_STM32WLXX_H_ */
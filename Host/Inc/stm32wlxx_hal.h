@@ -0,0 +1,306 @@
+/*
+ * stm32wlxx_hal.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Host stand-in for the STM32WLxx HAL. Only the types and functions used by the
+ * sources built in Host/CMakeLists.txt are declared, the implementations are in Host/Fake.
+ */
+
+#ifndef HOST_STM32WLXX_HAL_H_
+#define HOST_STM32WLXX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cmsis_compiler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************
+ * Common
+ ********************************/
+#define __IO volatile
+#define __weak __attribute__((weak))
+#define UNUSED(X) (void)X
+
+typedef enum {
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+	RESET = 0U,
+	SET = !RESET
+} FlagStatus, ITStatus;
+
+extern uint32_t SystemCoreClock;
+
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+/********************************
+ * Core (DWT cycle counter)
+ ********************************/
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+/* Every access samples the emulated cycle counter, see Host/Fake/fake_hal.c */
+DWT_Type *HostDwt(void);
+extern CoreDebug_Type HostCoreDebug;
+#define DWT (HostDwt())
+#define CoreDebug (&HostCoreDebug)
+
+/********************************
+ * RCC
+ ********************************/
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do { } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do { } while (0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE() do { } while (0)
+#define __HAL_RCC_GPIOA_CLK_DISABLE() do { } while (0)
+#define __HAL_RCC_GPIOB_CLK_DISABLE() do { } while (0)
+#define __HAL_RCC_GPIOC_CLK_DISABLE() do { } while (0)
+#define __HAL_RCC_SUBGHZSPI_CLK_ENABLE() do { } while (0)
+#define __HAL_RCC_SUBGHZSPI_CLK_DISABLE() do { } while (0)
+
+/********************************
+ * NVIC
+ ********************************/
+typedef enum {
+	SysTick_IRQn = -1,
+	TIM2_IRQn = 27,
+	USART2_IRQn = 37,
+	SUBGHZ_Radio_IRQn = 50
+} IRQn_Type;
+
+#define HAL_NVIC_SetPriority(IRQn, PreemptPriority, SubPriority) do { } while (0)
+#define HAL_NVIC_EnableIRQ(IRQn) do { } while (0)
+#define HAL_NVIC_DisableIRQ(IRQn) do { } while (0)
+
+/********************************
+ * GPIO
+ ********************************/
+typedef struct {
+	volatile uint32_t MODER;
+	volatile uint32_t ODR;
+	volatile uint32_t IDR;
+} GPIO_TypeDef;
+
+typedef struct {
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET = 0U,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef HostGpioA, HostGpioB, HostGpioC;
+#define GPIOA (&HostGpioA)
+#define GPIOB (&HostGpioB)
+#define GPIOC (&HostGpioC)
+
+#define GPIO_PIN_0 ((uint16_t) 0x0001)
+#define GPIO_PIN_1 ((uint16_t) 0x0002)
+#define GPIO_PIN_2 ((uint16_t) 0x0004)
+#define GPIO_PIN_3 ((uint16_t) 0x0008)
+#define GPIO_PIN_4 ((uint16_t) 0x0010)
+#define GPIO_PIN_5 ((uint16_t) 0x0020)
+#define GPIO_PIN_6 ((uint16_t) 0x0040)
+#define GPIO_PIN_7 ((uint16_t) 0x0080)
+#define GPIO_PIN_8 ((uint16_t) 0x0100)
+#define GPIO_PIN_9 ((uint16_t) 0x0200)
+#define GPIO_PIN_10 ((uint16_t) 0x0400)
+#define GPIO_PIN_11 ((uint16_t) 0x0800)
+#define GPIO_PIN_12 ((uint16_t) 0x1000)
+#define GPIO_PIN_13 ((uint16_t) 0x2000)
+#define GPIO_PIN_14 ((uint16_t) 0x4000)
+#define GPIO_PIN_15 ((uint16_t) 0x8000)
+
+#define GPIO_MODE_INPUT 0x00000000U
+#define GPIO_MODE_OUTPUT_PP 0x00000001U
+#define GPIO_NOPULL 0x00000000U
+#define GPIO_PULLUP 0x00000001U
+#define GPIO_PULLDOWN 0x00000002U
+#define GPIO_SPEED_FREQ_LOW 0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM 0x00000001U
+#define GPIO_SPEED_FREQ_HIGH 0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x00000003U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/********************************
+ * FLASH
+ ********************************/
+/*
+ * The flash memory map is HostFlash. Addresses are pointers cast to 32 bits like
+ * on the target, the fake maps them back with the low 32 bits of HostFlash.
+ */
+extern uint8_t HostFlash[];
+#define FLASH_BASE ((uint32_t) (uintptr_t) HostFlash)
+#define FLASH_SIZE (256 * 1024)
+#define FLASH_PAGE_SIZE 0x00000800U
+#define FLASH_PAGE_NB (FLASH_SIZE / FLASH_PAGE_SIZE)
+
+#define FLASH_TYPEERASE_PAGES 0x00000002U
+#define FLASH_TYPEPROGRAM_DOUBLEWORD 0x00000001U
+#define FLASH_FLAG_ALL_ERRORS 0x0000C3FAU
+#define __HAL_FLASH_CLEAR_FLAG(__FLAG__) do { } while (0)
+
+typedef struct {
+	uint32_t TypeErase;
+	uint32_t Page;
+	uint32_t NbPages;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError);
+
+/********************************
+ * UART
+ ********************************/
+typedef struct {
+	void *Instance;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/********************************
+ * SUBGHZ
+ ********************************/
+typedef enum {
+	HAL_SUBGHZ_CAD_CLEAR = 0x00U,
+	HAL_SUBGHZ_CAD_DETECTED = 0x01U,
+} HAL_SUBGHZ_CadStatusTypeDef;
+
+typedef struct {
+	uint32_t BaudratePrescaler;
+} SUBGHZ_InitTypeDef;
+
+typedef struct {
+	SUBGHZ_InitTypeDef Init;
+	uint8_t DeepSleep;
+	__IO uint32_t ErrorCode;
+} SUBGHZ_HandleTypeDef;
+
+#define SUBGHZSPI_BAUDRATEPRESCALER_4 0x00000008U
+
+#define SUBGHZ_IT_TX_CPLT 0x0001U
+#define SUBGHZ_IT_RX_CPLT 0x0002U
+#define SUBGHZ_IT_PREAMBLE_DETECTED 0x0004U
+#define SUBGHZ_IT_SYNCWORD_VALID 0x0008U
+#define SUBGHZ_IT_HEADER_VALID 0x0010U
+#define SUBGHZ_IT_HEADER_ERROR 0x0020U
+#define SUBGHZ_IT_CRC_ERROR 0x0040U
+#define SUBGHZ_IT_CAD_DONE 0x0080U
+#define SUBGHZ_IT_CAD_ACTIVITY_DETECTED 0x0100U
+#define SUBGHZ_IT_RX_TX_TIMEOUT 0x0200U
+
+typedef enum {
+	RADIO_SET_SLEEP = 0x84U,
+	RADIO_SET_STANDBY = 0x80U,
+	RADIO_SET_FS = 0xC1U,
+	RADIO_SET_TX = 0x83U,
+	RADIO_SET_RX = 0x82U,
+	RADIO_SET_RXDUTYCYCLE = 0x94U,
+	RADIO_SET_CAD = 0xC5U,
+	RADIO_SET_TXCONTINUOUSWAVE = 0xD1U,
+	RADIO_SET_TXCONTINUOUSPREAMBLE = 0xD2U,
+	RADIO_SET_PACKETTYPE = 0x8AU,
+	RADIO_SET_RFFREQUENCY = 0x86U,
+	RADIO_SET_TXPARAMS = 0x8EU,
+	RADIO_SET_PACONFIG = 0x95U,
+	RADIO_SET_CADPARAMS = 0x88U,
+	RADIO_SET_BUFFERBASEADDRESS = 0x8FU,
+	RADIO_SET_MODULATIONPARAMS = 0x8BU,
+	RADIO_SET_PACKETPARAMS = 0x8CU,
+	RADIO_RESET_STATS = 0x00U,
+	RADIO_CFG_DIOIRQ = 0x08U,
+	RADIO_CLR_IRQSTATUS = 0x02U,
+	RADIO_CALIBRATE = 0x89U,
+	RADIO_CALIBRATEIMAGE = 0x98U,
+	RADIO_SET_REGULATORMODE = 0x96U,
+	RADIO_SET_TCXOMODE = 0x97U,
+	RADIO_SET_TXFALLBACKMODE = 0x93U,
+	RADIO_SET_RFSWITCHMODE = 0x9DU,
+	RADIO_SET_STOPRXTIMERONPREAMBLE = 0x9FU,
+	RADIO_SET_LORASYMBTIMEOUT = 0xA0U,
+	RADIO_CLR_ERROR = 0x07U
+} SUBGHZ_RadioSetCmd_t;
+
+typedef enum {
+	RADIO_GET_STATUS = 0xC0U,
+	RADIO_GET_PACKETTYPE = 0x11U,
+	RADIO_GET_RXBUFFERSTATUS = 0x13U,
+	RADIO_GET_PACKETSTATUS = 0x14U,
+	RADIO_GET_RSSIINST = 0x15U,
+	RADIO_GET_STATS = 0x10U,
+	RADIO_GET_IRQSTATUS = 0x12U,
+	RADIO_GET_ERROR = 0x17U
+} SUBGHZ_RadioGetCmd_t;
+
+HAL_StatusTypeDef HAL_SUBGHZ_Init(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_MspInit(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_MspDeInit(SUBGHZ_HandleTypeDef *hsubghz);
+HAL_StatusTypeDef HAL_SUBGHZ_ExecSetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioSetCmd_t Command, uint8_t *pBuffer,
+		uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_ExecGetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioGetCmd_t Command, uint8_t *pBuffer,
+		uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_WriteBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_ReadBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_WriteRegisters(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pBuffer,
+		uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_ReadRegisters(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pBuffer,
+		uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZ_WriteRegister(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t Value);
+HAL_StatusTypeDef HAL_SUBGHZ_ReadRegister(SUBGHZ_HandleTypeDef *hsubghz, uint16_t Address, uint8_t *pValue);
+
+void HAL_SUBGHZ_IRQHandler(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_TxCpltCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_RxCpltCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_PreambleDetectedCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_SyncWordValidCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_HeaderValidCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_HeaderErrorCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_CRCErrorCallback(SUBGHZ_HandleTypeDef *hsubghz);
+void HAL_SUBGHZ_CADStatusCallback(SUBGHZ_HandleTypeDef *hsubghz, HAL_SUBGHZ_CadStatusTypeDef cadstatus);
+void HAL_SUBGHZ_RxTxTimeoutCallback(SUBGHZ_HandleTypeDef *hsubghz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32WLXX_HAL_H_ */
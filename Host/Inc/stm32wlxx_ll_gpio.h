@@ -0,0 +1,23 @@
+/*
+ * stm32wlxx_ll_gpio.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Host stand-in for the GPIO LL driver, used by the radio debug probes
+ */
+
+#ifndef HOST_STM32WLXX_LL_GPIO_H_
+#define HOST_STM32WLXX_LL_GPIO_H_
+
+#include "stm32wlxx_hal.h"
+
+static inline void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) {
+	GPIOx->ODR |= PinMask;
+}
+
+static inline void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) {
+	GPIOx->ODR &= ~PinMask;
+}
+
+#endif /* HOST_STM32WLXX_LL_GPIO_H_ */
@@ -0,0 +1,171 @@
+/*
+ * subghz_model.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Behavioural model of the STM32WL SUBGHZ radio for the host build. It takes
+ * the same commands, buffer and register accesses as the HAL and models the
+ * operating modes, BUSY timing, the IRQ status register and time on air.
+ * Models attached to the air exchange packets when their frequency, modulation
+ * and sync word match.
+ */
+
+#ifndef HOST_SUBGHZ_MODEL_H_
+#define HOST_SUBGHZ_MODEL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************
+ * Defines
+ ********************************/
+#define SUBGHZ_MODEL_REG_SIZE 0x1000
+#define SUBGHZ_MODEL_BUF_SIZE 256
+
+/* Packet types of RADIO_SET_PACKETTYPE */
+#define SUBGHZ_MODEL_PACKET_GFSK 0x00
+#define SUBGHZ_MODEL_PACKET_LORA 0x01
+#define SUBGHZ_MODEL_PACKET_BPSK 0x02
+
+/* RX/TX timeout of RADIO_SET_RX keeping the radio in RX after a packet */
+#define SUBGHZ_MODEL_RX_CONTINUOUS 0xFFFFFF
+
+/* GFSK packet engine: payload length and the buffer address of the next byte to send */
+#define SUBGHZ_MODEL_REG_PAYLOAD_LENGTH 0x06BB
+#define SUBGHZ_MODEL_REG_TX_POINTER 0x0802
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	SUBGHZ_MODEL_SLEEP = 0,
+	SUBGHZ_MODEL_STDBY_RC,
+	SUBGHZ_MODEL_STDBY_XOSC,
+	SUBGHZ_MODEL_FS,
+	SUBGHZ_MODEL_RX,
+	SUBGHZ_MODEL_TX,
+} SubghzModelMode_t;
+
+typedef struct {
+	uint64_t busyWaitNs;		/* Time spent waiting on BUSY */
+	uint32_t busyWaits;			/* Accesses that found BUSY high */
+	uint32_t txPackets;
+	uint32_t rxPackets;
+	uint32_t rxCrcErrors;
+	uint32_t rxTimeouts;
+	uint64_t txAirNs;			/* Total time on air of the transmitted packets */
+} SubghzModelStats_t;
+
+typedef struct SubghzModel_s SubghzModel_t;
+
+struct SubghzModel_s {
+	const char *name;
+
+	/* Called when an IRQ enabled on a DIO line is raised, the radio interrupt of the instance */
+	void (*irqHandler)(SubghzModel_t *model);
+	void *context;
+
+	/* Operating state */
+	SubghzModelMode_t mode;
+	uint8_t warmStart;			/* Configuration was retained by the last RADIO_SET_SLEEP */
+	uint8_t fallbackMode;		/* RADIO_SET_TXFALLBACKMODE, mode after TX and single RX */
+	uint64_t tcxoDelayNs;		/* RADIO_SET_TCXOMODE start-up delay */
+	uint64_t busyUntil;
+
+	/* IRQ */
+	uint16_t irqStatus;
+	uint16_t irqMask;
+	uint16_t dioMask[3];
+
+	/* Radio configuration */
+	uint8_t packetType;
+	uint32_t freqReg;
+	uint8_t modParams[8];
+	uint8_t pktParams[9];
+	uint8_t txBase;
+	uint8_t rxBase;
+	uint8_t registers[SUBGHZ_MODEL_REG_SIZE];
+	uint8_t buffer[SUBGHZ_MODEL_BUF_SIZE];
+
+	/* Current operation */
+	uint64_t opStart;			/* TX on air or RX listening since */
+	uint64_t opEnd;				/* TX end, RX or TX timeout, 0 when nothing is pending */
+	uint8_t opTimeout;			/* opEnd is a timeout rather than the end of the transmission */
+	uint8_t rxContinuous;
+
+	/*
+	 * GFSK TX reads the buffer from txBase until its pointer reaches txBase plus
+	 * the payload length register, moving the length during TX extends the packet
+	 */
+	uint32_t txBytes;			/* Payload bytes of the current packet */
+	uint32_t txCaptured;		/* Of them already appended to txCapture */
+
+	/* When set, every GFSK payload byte sent as it leaves the buffer */
+	uint8_t *txCapture;
+	uint32_t txCaptureSize;
+	uint32_t txCaptureLen;
+
+	/* Last received packet */
+	uint8_t rxLength;
+	uint8_t rxStart;
+	int8_t rssi;				/* dBm reported in the packet status */
+
+	SubghzModelStats_t stats;
+
+	SubghzModel_t *next;
+};
+
+/********************************
+ * Model
+ ********************************/
+/* @brief: Power on reset, the radio is in STDBY_RC with a default configuration */
+void SubghzModel_Init(SubghzModel_t *model, const char *name);
+
+/* @brief: Waits for BUSY to go low, advancing the virtual clock or spinning in real time */
+void SubghzModel_WaitBusy(SubghzModel_t *model);
+uint8_t SubghzModel_IsBusy(const SubghzModel_t *model);
+
+void SubghzModel_SetCmd(SubghzModel_t *model, uint8_t opcode, const uint8_t *params, uint16_t size);
+void SubghzModel_GetCmd(SubghzModel_t *model, uint8_t opcode, uint8_t *data, uint16_t size);
+void SubghzModel_WriteBuffer(SubghzModel_t *model, uint8_t offset, const uint8_t *data, uint16_t size);
+void SubghzModel_ReadBuffer(SubghzModel_t *model, uint8_t offset, uint8_t *data, uint16_t size);
+void SubghzModel_WriteRegisters(SubghzModel_t *model, uint16_t address, const uint8_t *data, uint16_t size);
+void SubghzModel_ReadRegisters(SubghzModel_t *model, uint16_t address, uint8_t *data, uint16_t size);
+
+/* @brief: Sets IRQ status bits and runs the radio interrupt, whatever the DIO masks */
+void SubghzModel_RaiseIrq(SubghzModel_t *model, uint16_t irq);
+
+/* @brief: Time on air of a packet with this payload length in the current configuration */
+uint64_t SubghzModel_TimeOnAirNs(const SubghzModel_t *model, uint8_t payloadLength);
+
+/********************************
+ * Air
+ ********************************/
+void SubghzAir_Attach(SubghzModel_t *model);
+void SubghzAir_Detach(SubghzModel_t *model);
+
+/*
+ * The air also runs the TIM2 compares (Fake/fake_us_timer.c), they send packets
+ * with deadlines between the radio events.
+ */
+/* @brief: Processes the TX ends, timeouts and compares due by the current host time */
+void SubghzAir_Poll(void);
+
+/* @brief: Time of the earliest pending radio event or compare, 0 when there is none */
+uint64_t SubghzAir_NextEventNs(void);
+
+/*
+ * @brief: Advances the virtual clock by ns, processing the radio events and the
+ * compares in time order. Their interrupts run at the time of their event.
+ */
+void SubghzAir_Advance(uint64_t ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_SUBGHZ_MODEL_H_ */
@@ -0,0 +1,447 @@
+/*
+ * port.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * FreeRTOS port for the host build, emulating a single core with POSIX threads.
+ *
+ * Before vTaskStartScheduler() nothing runs on its own: tests call into the
+ * firmware from main() and use the kernel objects without blocking on them.
+ * Once the scheduler starts every task runs on its own thread, and only the
+ * thread of the running task is ever released. Interrupts are pended by the
+ * tick and device threads and delivered to the running thread with SIGUSR1,
+ * whose handler runs the ISRs unless PRIMASK is set and performs the context
+ * switches they request, like PendSV on the target.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host.h"
+#include "stm32wlxx_hal.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* Exception numbers, the external interrupts start at 16 */
+#define HOST_EXCEPTION_COUNT 128
+#define HOST_IRQ_SIGNAL SIGUSR1
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	pthread_t thread;
+	sem_t run;
+	TaskFunction_t code;
+	void *params;
+	uint8_t deleted;
+} HostThread_t;
+
+/********************************
+ * Static Variables
+ ********************************/
+static volatile uint32_t primask = 0;
+static volatile uint32_t ipsr = 0;
+
+static uint32_t criticalNesting = 0;
+static uint32_t criticalPrimask = 0;
+
+static volatile uint8_t schedulerRunning = 0;
+static volatile uint8_t yieldPending = 0;
+
+/* Thread of the task the emulated core is executing */
+static HostThread_t *_Atomic running = NULL;
+static __thread HostThread_t *self = NULL;
+
+/* Interrupt controller, one pending bit and handler per exception number */
+static _Atomic uint64_t pending[HOST_EXCEPTION_COUNT / 64];
+static void (*volatile pendingIsr[HOST_EXCEPTION_COUNT])(void);
+
+/********************************
+ * Static Functions
+ ********************************/
+static HostThread_t *threadOf(TaskHandle_t task) {
+	/* pxTopOfStack is the first member of the TCB, pxPortInitialiseStack stored the thread there */
+	StackType_t *top = *(StackType_t **) task;
+	HostThread_t *thread;
+
+	memcpy(&thread, top, sizeof(thread));
+
+	return thread;
+}
+
+static void blockIrqSignal(sigset_t *old) {
+	sigset_t set;
+
+	sigemptyset(&set);
+	sigaddset(&set, HOST_IRQ_SIGNAL);
+	pthread_sigmask(SIG_BLOCK, &set, old);
+}
+
+static void restoreIrqSignal(const sigset_t *old) {
+	pthread_sigmask(SIG_SETMASK, old, NULL);
+}
+
+static void kick(void) {
+	HostThread_t *thread = running;
+
+	if (thread != NULL) {
+		pthread_kill(thread->thread, HOST_IRQ_SIGNAL);
+	}
+}
+
+static int32_t takePending(void) {
+	for (uint32_t word = 0; word < HOST_EXCEPTION_COUNT / 64; word++) {
+		uint64_t bits = atomic_load(&pending[word]);
+
+		while (bits != 0) {
+			uint32_t bit = __builtin_ctzll(bits);
+			uint64_t mask = 1ULL << bit;
+
+			if (atomic_fetch_and(&pending[word], ~mask) & mask) {
+				return word * 64 + bit;
+			}
+			bits = atomic_load(&pending[word]);
+		}
+	}
+
+	return -1;
+}
+
+/* @brief: Hands the core over to the task selected by the kernel, returns when this task runs again */
+static void switchContext(void) {
+	HostThread_t *current = self;
+
+	vTaskSwitchContext();
+	HostThread_t *next = threadOf(xTaskGetCurrentTaskHandle());
+	if (next == current) {
+		return;
+	}
+
+	running = next;
+	sem_post(&next->run);
+
+	if (current == NULL) {
+		return;
+	}
+	if (current->deleted) {
+		pthread_exit(NULL);
+	}
+
+	while (sem_wait(&current->run) != 0) {
+		/* Interrupted by a kick meant for the previous owner of the core */
+	}
+}
+
+/*
+ * @brief: Runs the pending interrupts and the context switch they request, when
+ * the core can take them. Called with the IRQ signal blocked.
+ */
+static void serviceInterrupts(void) {
+	/* Before the scheduler starts there is a single thread of execution, main() */
+	while ((!schedulerRunning || self == running) && primask == 0 && ipsr == 0) {
+		int32_t exception = takePending();
+		if (exception >= 0) {
+			Host_RunIsr((uint32_t) exception - 16, pendingIsr[exception]);
+			continue;
+		}
+
+		if (yieldPending) {
+			yieldPending = 0;
+			switchContext();
+			continue;
+		}
+
+		break;
+	}
+}
+
+static void serviceInterruptsFromTask(void) {
+	sigset_t old;
+
+	if (!schedulerRunning) {
+		serviceInterrupts();
+		return;
+	}
+
+	blockIrqSignal(&old);
+	serviceInterrupts();
+	restoreIrqSignal(&old);
+}
+
+static void irqSignalHandler(int sig) {
+	int savedErrno = errno;
+
+	(void) sig;
+	serviceInterrupts();
+
+	errno = savedErrno;
+}
+
+static void *threadMain(void *arg) {
+	HostThread_t *thread = arg;
+	sigset_t old;
+
+	self = thread;
+
+	/* Wait to be scheduled for the first time */
+	blockIrqSignal(&old);
+	while (sem_wait(&thread->run) != 0) {
+	}
+	sigemptyset(&old);
+	restoreIrqSignal(&old);
+
+	serviceInterruptsFromTask();
+
+	thread->code(thread->params);
+
+	/* Tasks must not return, the ARM port would fault here */
+	vTaskDelete(NULL);
+
+	return NULL;
+}
+
+static void tickIsr(void) {
+	uint32_t mask = ulPortSetInterruptMask();
+
+	if (xTaskIncrementTick() != pdFALSE) {
+		yieldPending = 1;
+	}
+
+	vPortClearInterruptMask(mask);
+}
+
+static void *tickThread(void *arg) {
+	struct timespec next;
+
+	(void) arg;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	for (;;) {
+		next.tv_nsec += 1000000000L / configTICK_RATE_HZ;
+		if (next.tv_nsec >= 1000000000L) {
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+		Host_PendIrq(SysTick_IRQn, tickIsr);
+	}
+
+	return NULL;
+}
+
+/********************************
+ * Interrupt Emulation
+ ********************************/
+void Host_DisableIrq(void) {
+	primask = 1;
+}
+
+void Host_EnableIrq(void) {
+	primask = 0;
+	serviceInterruptsFromTask();
+}
+
+uint32_t Host_GetPrimask(void) {
+	return primask;
+}
+
+void Host_SetPrimask(uint32_t mask) {
+	primask = mask;
+	if (mask == 0) {
+		serviceInterruptsFromTask();
+	}
+}
+
+uint32_t Host_GetIpsr(void) {
+	return ipsr;
+}
+
+void Host_WaitForInterrupt(void) {
+	sigset_t old;
+
+	if (!schedulerRunning || self == NULL) {
+		return;
+	}
+
+	/* Sleeps until a kick, the handler then runs the interrupt before WFI returns */
+	blockIrqSignal(&old);
+	uint8_t idle = 1;
+	for (uint32_t word = 0; word < HOST_EXCEPTION_COUNT / 64; word++) {
+		idle &= atomic_load(&pending[word]) == 0;
+	}
+	if (idle && !yieldPending) {
+		sigsuspend(&old);
+	}
+	restoreIrqSignal(&old);
+
+	serviceInterruptsFromTask();
+}
+
+void Host_RunIsr(uint32_t irqn, void (*handler)(void)) {
+	uint32_t prevIpsr = ipsr;
+
+	/* Exception number, external interrupts start at 16 */
+	ipsr = irqn + 16;
+	handler();
+	ipsr = prevIpsr;
+}
+
+void Host_PendIrq(uint32_t irqn, void (*handler)(void)) {
+	uint32_t exception = (irqn + 16) % HOST_EXCEPTION_COUNT;
+
+	pendingIsr[exception] = handler;
+	atomic_fetch_or(&pending[exception / 64], 1ULL << (exception % 64));
+
+	if (schedulerRunning) {
+		kick();
+	} else {
+		/* Taken right away unless masked, like a single threaded core */
+		serviceInterrupts();
+	}
+}
+
+/********************************
+ * Port Functions
+ ********************************/
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters) {
+	sigset_t old;
+
+	/* A task preempted inside malloc would deadlock the next one to call it */
+	blockIrqSignal(&old);
+
+	HostThread_t *thread = calloc(1, sizeof(HostThread_t));
+	configASSERT(thread != NULL);
+
+	thread->code = pxCode;
+	thread->params = pvParameters;
+	sem_init(&thread->run, 0, 0);
+
+	/* The thread waits until the task is scheduled for the first time */
+	pthread_create(&thread->thread, NULL, threadMain, thread);
+	pthread_detach(thread->thread);
+
+	restoreIrqSignal(&old);
+
+	pxTopOfStack -= sizeof(thread) / sizeof(StackType_t);
+	memcpy(pxTopOfStack, &thread, sizeof(thread));
+
+	return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void) {
+	struct sigaction action;
+	pthread_t tick;
+	sigset_t old;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = irqSignalHandler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaddset(&action.sa_mask, HOST_IRQ_SIGNAL);
+	sigaction(HOST_IRQ_SIGNAL, &action, NULL);
+
+	/* main() only starts the first task, interrupts are never delivered to it */
+	blockIrqSignal(&old);
+
+	criticalNesting = 0;
+	primask = 0;
+	schedulerRunning = 1;
+
+	pthread_create(&tick, NULL, tickThread, NULL);
+
+	HostThread_t *first = threadOf(xTaskGetCurrentTaskHandle());
+	running = first;
+	sem_post(&first->run);
+
+	for (;;) {
+		pause();
+	}
+
+	return pdFALSE;
+}
+
+void vPortEndScheduler(void) {
+}
+
+void vPortYield(void) {
+	if (!schedulerRunning) {
+		/* Only one thread of execution, a context switch never happens */
+		return;
+	}
+
+	/* Taken on the way out of the ISR or the critical section, like PendSV */
+	yieldPending = 1;
+	if (ipsr == 0 && primask == 0) {
+		serviceInterruptsFromTask();
+	}
+}
+
+void vPortEnterCritical(void) {
+	uint32_t mask = Host_GetPrimask();
+	Host_DisableIrq();
+
+	if (criticalNesting == 0) {
+		criticalPrimask = mask;
+	}
+	criticalNesting++;
+}
+
+void vPortExitCritical(void) {
+	configASSERT(criticalNesting);
+
+	criticalNesting--;
+	if (criticalNesting == 0) {
+		Host_SetPrimask(criticalPrimask);
+	}
+}
+
+uint32_t ulPortSetInterruptMask(void) {
+	uint32_t mask = Host_GetPrimask();
+	Host_DisableIrq();
+
+	return mask;
+}
+
+void vPortClearInterruptMask(uint32_t ulMask) {
+	Host_SetPrimask(ulMask);
+}
+
+void vPortDisableInterrupts(void) {
+	Host_DisableIrq();
+}
+
+void vPortEnableInterrupts(void) {
+	Host_EnableIrq();
+}
+
+void vPortTaskDeleted(void *task) {
+	HostThread_t *thread = threadOf((TaskHandle_t) task);
+
+	/* Exits at the context switch that follows, any other task is waiting to be scheduled */
+	thread->deleted = 1;
+	if (thread != self) {
+		pthread_cancel(thread->thread);
+	}
+}
+
+/* @brief: The idle task sleeps until the next interrupt, like WFI in the tickless idle of the target */
+void vApplicationIdleHook(void) {
+	Host_WaitForInterrupt();
+}
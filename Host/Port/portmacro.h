@@ -0,0 +1,87 @@
+/*
+ * portmacro.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * FreeRTOS port definitions for the host build. Interrupt masking maps to the
+ * PRIMASK emulation in Host/Port/port.c.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/********************************
+ * Types
+ ********************************/
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+/* Same width as on the target, so the static stacks keep their size */
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+/* Pointers are 64 bit, the kernel default of uint32_t would truncate them */
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+/********************************
+ * Architecture
+ ********************************/
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+
+extern void vPortYield( void );
+#define portYIELD() vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+
+/********************************
+ * Critical Sections
+ ********************************/
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern uint32_t ulPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( uint32_t ulMask );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE	__inline
+#define portFORCE_INLINE inline __attribute__(( always_inline))
+#define portMEMORY_BARRIER() __atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+/* Ends the thread of a deleted task */
+extern void vPortTaskDeleted( void *pvTask );
+#define traceTASK_DELETE( pxTCB ) vPortTaskDeleted( pxTCB )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
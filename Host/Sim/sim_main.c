@@ -0,0 +1,64 @@
+/*
+ * sim_main.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * The firmware on Linux: initTask, the CLI task and the timer daemon run under
+ * the scheduler of Host/Port/port.c, USART2 is a pseudo-terminal and SUBGHZ
+ * the radio model on a real time clock.
+ *   pwnrf_sim [-l link]
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "host.h"
+#include "usart.h"
+#include "subghz.h"
+#include "cmsis_os.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/********************************
+ * External Functions
+ ********************************/
+/* Core/Src/app_freertos.c */
+void MX_FREERTOS_Init(void);
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char *argv[]) {
+	const char *link = NULL;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+			link = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [-l link]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	const char *pty = HostUart_OpenPty(link);
+	if (pty == NULL) {
+		perror("pwnrf_sim: pseudo-terminal");
+		return 1;
+	}
+	printf("pwnRF: USART2 on %s\n", link != NULL ? link : pty);
+	fflush(stdout);
+
+	/* Same start-up as main() in Core/Src/main.c, clocks and GPIO need no set-up here */
+	MX_USART2_UART_Init();
+	MX_SUBGHZ_Init();
+	HostSubghz_StartRealTime();
+
+	osKernelInitialize();
+	MX_FREERTOS_Init();
+	osKernelStart();
+
+	/* Not reached, the scheduler keeps main() waiting */
+	return 1;
+}
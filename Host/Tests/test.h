@@ -0,0 +1,92 @@
+/*
+ * test.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Minimal test runner for the host build, a failed check reports the location
+ * and the test executable exits non-zero.
+ */
+
+#ifndef HOST_TESTS_TEST_H_
+#define HOST_TESTS_TEST_H_
+
+#include "host.h"
+#include "stm32wlxx_hal.h"
+#include "app_subghz_phy.h"
+#include "CLI/cli.h"
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_CLI.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define TEST_CHECK(cond) do { \
+		if (!(cond)) { \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define TEST_CHECK_STR(str, expected) do { \
+		if (strstr((str), (expected)) == NULL) { \
+			fprintf(stderr, "%s:%d: \"%s\" not found in \"%s\"\n", __FILE__, __LINE__, (expected), (str)); \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define TEST_RUN(test) do { \
+		uint32_t failures = testFailures; \
+		test(); \
+		printf("%s %s\n", failures == testFailures ? "PASS" : "FAIL", #test); \
+	} while (0)
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint32_t testFailures = 0;
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Same initialisation as initTask in Core/Src/app_freertos.c, without the scheduler */
+static inline void testBoot(void) {
+	MX_SubGHz_Phy_Init();
+	commandLineInit();
+	HostUart_Drain();
+}
+
+/* @brief: Runs a command line like the CLI task does and collects the whole response */
+static inline const char *testCommand(const char *line) {
+	static char response[2048];
+	char chunk[128];
+	size_t len = 0;
+	BaseType_t more;
+
+	response[0] = '\0';
+	do {
+		more = FreeRTOS_CLIProcessCommand(line, chunk, sizeof(chunk));
+		size_t chunkLen = strlen(chunk);
+		if (len + chunkLen < sizeof(response)) {
+			memcpy(&response[len], chunk, chunkLen + 1);
+			len += chunkLen;
+		}
+	} while (more != pdFALSE);
+
+	return response;
+}
+
+static inline int testResult(void) {
+	if (testFailures) {
+		printf("%lu check(s) failed\n", (unsigned long) testFailures);
+		return 1;
+	}
+
+	return 0;
+}
+
+#endif /* HOST_TESTS_TEST_H_ */
@@ -0,0 +1,155 @@
+/*
+ * test_btrace.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Binary trace round trip: frames emitted by the firmware on USART2, mixed with
+ * text holding the sync byte, decoded back into log lines by Tools/btrace
+ */
+
+/********************************
+ * Includes
+ ********************************/
+extern "C" {
+#include "test.h"
+
+#include "BTrace/btrace.h"
+#include "stm32_adv_trace.h"
+}
+
+#include "decoder.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_US 1000ULL
+
+/********************************
+ * Static Variables
+ ********************************/
+/* In .btrace_fmt the event id is the offset of the string, here the low 16 bits of its address */
+static const char fmtTx[] = "radio tx %u bytes at %u Hz";
+static const char fmtLine[] = "cli line %d";
+
+/********************************
+ * Helpers
+ ********************************/
+static void emit(const char *fmt, std::vector<uint32_t> args) {
+	BTrace_Emit(fmt, args.data(), args.size());
+}
+
+static void send(const std::string &text) {
+	UTIL_ADV_TRACE_Send((uint8_t *) text.data(), text.size());
+}
+
+/* @brief: Format strings indexed by event id, as readElfSection() returns them */
+static std::vector<char> formats(void) {
+	std::vector<char> table(0x10000 + 64, '\0');
+
+	for (const char *fmt : { fmtTx, fmtLine }) {
+		strcpy(&table[(uint16_t) (uintptr_t) fmt], fmt);
+	}
+
+	return table;
+}
+
+/* @brief: Decodes what the firmware wrote to USART2 */
+static std::string decode(void) {
+	btrace::Decoder decoder(formats());
+	std::ostringstream out;
+
+	HostUart_Drain();
+	for (size_t i = 0; i < HostUart_OutputLen(); i++) {
+		decoder.feed((uint8_t) HostUart_Output()[i], out);
+	}
+	decoder.finish(out);
+	HostUart_ClearOutput();
+
+	return out.str();
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testRoundTrip(void) {
+	HostUart_ClearOutput();
+	BTrace_Enable(1);
+
+	Host_SetTimeNs(Host_GetTimeNs() + 1500 * NS_PER_US);
+	emit(fmtTx, { 12, 433920000 });
+	Host_SetTimeNs(Host_GetTimeNs() + 250 * NS_PER_US);
+	emit(fmtLine, { (uint32_t) -3 });
+
+	std::string decoded = decode();
+	TEST_CHECK_STR(decoded.c_str(), "[     0.001500] radio tx 12 bytes at 433920000 Hz\n");
+	TEST_CHECK_STR(decoded.c_str(), "[     0.001750] cli line -3\n");
+
+	BTrace_Enable(0);
+}
+
+static void testEnableDelta(void) {
+	BTrace_Enable(1);
+	emit(fmtLine, { 1 });
+	BTrace_Enable(0);
+
+	/* Off for a while, the first event after enabling again counts from then */
+	Host_SetTimeNs(Host_GetTimeNs() + 10000 * NS_PER_US);
+	BTrace_Enable(1);
+	Host_SetTimeNs(Host_GetTimeNs() + 20 * NS_PER_US);
+	HostUart_Drain();
+	HostUart_ClearOutput();
+	emit(fmtLine, { 2 });
+
+	TEST_CHECK_STR(decode().c_str(), "[     0.000020] cli line 2\n");
+
+	BTrace_Enable(0);
+}
+
+static void testSyncInText(void) {
+	/* Raw upload echo: header bytes of every argument count, one followed by a plausible frame */
+	std::string raw = "raw \xF0\xF1\xF2\xF3\xF4 \xF1\x01\x02\x03\x04 end\r\n";
+
+	HostUart_ClearOutput();
+	BTrace_Enable(1);
+	send(raw);
+	Host_SetTimeNs(Host_GetTimeNs() + 5 * NS_PER_US);
+	emit(fmtTx, { 1, 2 });
+	send("\xF2");
+	emit(fmtLine, { 7 });
+	BTrace_Enable(0);
+
+	std::string decoded = decode();
+
+	/* The text comes through untouched, the frames behind it are still found */
+	TEST_CHECK(decoded.compare(0, raw.size(), raw) == 0);
+	TEST_CHECK_STR(decoded.c_str(), "radio tx 1 bytes at 2 Hz\n\xF2\n[");
+	TEST_CHECK_STR(decoded.c_str(), "] cli line 7\n");
+}
+
+static void testCrc(void) {
+	/* CRC-8, polynomial 0x07, no reflection: check value of "123456789" */
+	TEST_CHECK(btrace::crc8((const uint8_t *) "123456789", 9) == 0xF4);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	Host_SetVirtualTime(1);
+
+	TEST_RUN(testRoundTrip);
+	TEST_RUN(testEnableDelta);
+	TEST_RUN(testSyncInText);
+	TEST_RUN(testCrc);
+
+	Host_SetVirtualTime(0);
+
+	return testResult();
+}
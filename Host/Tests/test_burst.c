@@ -0,0 +1,201 @@
+/*
+ * test_burst.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Bursts: packets sent from the TX done interrupt, the gap between them, the
+ * measured duration, a burst cut short by a TX timeout and the sends held back
+ * while it runs
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "radio.h"
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+#include "Jobs/jobs.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_MS 1000000ULL
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Runs the radio until the burst ended, in virtual or real time */
+static void runBurst(uint8_t virtual) {
+	SubghzBurstStatus_t status;
+	uint64_t deadline = Host_GetTimeNs() + 5000 * NS_PER_MS;
+
+	do {
+		if (virtual) {
+			SubghzAir_Advance(NS_PER_MS);
+		} else {
+			SubghzAir_Poll();
+		}
+		SubghzApp_GetBurstStatus(&status);
+	} while (status.active && Host_GetTimeNs() < deadline);
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testBurst(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzBurstStatus_t status;
+	uint32_t before = model->stats.txPackets;
+
+	Host_SetVirtualTime(1);
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "burst!", 6, 5, 0));
+	TEST_CHECK(!SubghzApp_StartBurst((const uint8_t *) "busy", 4, 1, 0));
+	runBurst(1);
+	Host_SetVirtualTime(0);
+
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && !status.failed && status.sent == 5 && status.count == 5);
+	TEST_CHECK(model->stats.txPackets == before + 5);
+
+	/*
+	 * Back to back: the time on air and the turnaround of the radio only. Every
+	 * packet starts from STDBY_RC, with the TCXO start-up and calibration.
+	 */
+	uint32_t airUs = SubghzModel_TimeOnAirNs(model, 6) / 1000;
+	uint32_t turnaroundUs = model->tcxoDelayNs / 1000 + 3500;
+	TEST_CHECK(status.duration > 5 * airUs && status.duration < 5 * (airUs + turnaroundUs));
+}
+
+static void testGap(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzBurstStatus_t status;
+	uint32_t before = model->stats.txPackets;
+
+	TEST_CHECK(!SubghzApp_StartBurst((const uint8_t *) "gap", 3, 4, SUBGHZ_BURST_MAX_GAP_US + 1));
+
+	/* Below a tick, the TIM2 compare armed on TX done sends the next packet */
+	Host_SetVirtualTime(1);
+	SubghzModel_WaitBusy(model);
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "gap", 3, 4, 0));
+	runBurst(1);
+	SubghzApp_GetBurstStatus(&status);
+	uint32_t backToBack = status.duration;
+
+	/* Armed on the TX done of the first packet, never shorter than the gap */
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "gap", 3, 4, 500));
+	uint64_t txDone = SubghzAir_NextEventNs();
+	SubghzAir_Advance(txDone - Host_GetTimeNs());
+	uint64_t gapNs = HostUsTimer_NextEventNs() - txDone;
+	TEST_CHECK(gapNs >= 500000 && gapNs <= 501000);
+	runBurst(1);
+	Host_SetVirtualTime(0);
+
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && status.sent == 4);
+	TEST_CHECK(model->stats.txPackets == before + 8 && Radio.GetStatus() == RF_IDLE);
+
+	/* The three gaps add to the back to back burst, not rounded to ticks. Durations are whole us. */
+	TEST_CHECK(status.duration + 2 >= backToBack + 3 * 500 && status.duration <= backToBack + 3 * 501 + 2);
+
+	/* Stopped in a gap, the compare sends nothing */
+	Host_SetVirtualTime(1);
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "gap", 3, 4, 50000));
+	do {
+		SubghzAir_Advance(NS_PER_MS);
+		SubghzApp_GetBurstStatus(&status);
+	} while (status.sent == 0);
+	SubghzApp_StopBurst();
+	SubghzAir_Advance(100 * NS_PER_MS);
+	Host_SetVirtualTime(0);
+
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && status.sent == 1);
+	TEST_CHECK(model->stats.txPackets == before + 9);
+}
+
+static void testTimeout(void) {
+	SubghzBurstStatus_t status;
+
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "x", 1, 10, 0));
+	HostSubghz_RaiseIrq(SUBGHZ_IT_RX_TX_TIMEOUT);
+
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && status.failed && status.sent == 0);
+
+	/* The radio is free again */
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "x", 1, 10, 0));
+	SubghzApp_StopBurst();
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && status.sent == 0);
+	HostSubghz_RaiseIrq(SUBGHZ_IT_TX_CPLT);
+}
+
+static void testJobDuringBurst(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzBurstStatus_t status;
+	JobConfig_t job = { .period = 100, .freq = 868000000, .size = 3, .data = (const uint8_t *) "job" };
+	uint32_t freqReg = model->freqReg;
+
+	/* Added outside the CLI, the jobs timer never runs without the scheduler */
+	TEST_CHECK(Jobs_Add(&job, 0) >= 0);
+
+	Host_SetVirtualTime(1);
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "burst", 5, 3, 0));
+	uint32_t before = model->stats.txPackets;
+
+	/* The job is due, it waits for the burst and the radio keeps its packet */
+	TEST_CHECK(SubghzApp_RunJobs(0) == 1);
+	TEST_CHECK(!SubghzApp_Sent("x", 1));
+	TEST_CHECK_STR(testCommand("transmit x"), "Radio Busy");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "burst", 5) && model->freqReg == freqReg);
+	TEST_CHECK(Jobs_Get(0)->sent == 0);
+
+	runBurst(1);
+	SubghzApp_GetBurstStatus(&status);
+	TEST_CHECK(!status.active && status.sent == 3);
+	TEST_CHECK(model->stats.txPackets == before + 3);
+
+	/* Sent late once the burst ended, on its own frequency */
+	SubghzApp_RunJobs(0);
+	TEST_CHECK(Jobs_Get(0)->sent == 1 && model->freqReg != freqReg);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "job", 3));
+	SubghzAir_Advance(100 * NS_PER_MS);
+	Jobs_Clear();
+
+	/* The next burst is back on the base configuration */
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "burst", 5, 2, 0));
+	TEST_CHECK(model->freqReg == freqReg);
+	runBurst(1);
+	Host_SetVirtualTime(0);
+}
+
+static void testBurstCommand(void) {
+	/* A burst that runs waits in the CLI task, see test_sim */
+	TEST_CHECK_STR(testCommand("burst"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("burst 0 10 x"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("burst 10001 0 x"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("burst stop"), "No Burst");
+	TEST_CHECK_STR(testCommand("burst 10 100001 x"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("burst 10 100"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("burst 10 100 #99"), "Unknown Payload");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	SubghzApp_SetDatarate(50000);
+
+	TEST_RUN(testBurst);
+	TEST_RUN(testGap);
+	TEST_RUN(testTimeout);
+	TEST_RUN(testJobDuringBurst);
+	TEST_RUN(testBurstCommand);
+
+	return testResult();
+}
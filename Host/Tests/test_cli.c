@@ -0,0 +1,100 @@
+/*
+ * test_cli.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * CLI commands against the fake SUBGHZ, from the parsed line down to the radio commands
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "MemBudget/mem_budget.h"
+
+/********************************
+ * Tests
+ ********************************/
+static void testFreq(void) {
+	TEST_CHECK_STR(testCommand("freq"), "Frequency = 433.000 MHz");
+
+	TEST_CHECK_STR(testCommand("freq 868000000"), "Frequency Set Successfully");
+	TEST_CHECK_STR(testCommand("freq"), "Frequency = 868.000 MHz");
+
+	/* 868 MHz * 2^25 / 32 MHz, big endian */
+	int32_t idx = HostSubghz_FindLastCmd(RADIO_SET_RFFREQUENCY);
+	TEST_CHECK(idx >= 0);
+	if (idx >= 0) {
+		const HostSubghzCmd_t *cmd = HostSubghz_Cmd(idx);
+		TEST_CHECK(cmd->size == 4);
+		TEST_CHECK(cmd->params[0] == 0x36 && cmd->params[1] == 0x40 && cmd->params[2] == 0x00 && cmd->params[3] == 0x00);
+	}
+
+	TEST_CHECK_STR(testCommand("freq 12"), "Invalid Frequency");
+	TEST_CHECK_STR(testCommand("freq"), "Frequency = 868.000 MHz");
+}
+
+static void testSettings(void) {
+	TEST_CHECK_STR(testCommand("power 10"), "Power Set Successfully");
+	TEST_CHECK_STR(testCommand("power"), "Power = 10 dBm");
+	TEST_CHECK_STR(testCommand("power 40"), "Invalid Power");
+
+	TEST_CHECK_STR(testCommand("datarate 4800"), "Datarate Set Successfully");
+	TEST_CHECK_STR(testCommand("datarate"), "Datarate = 4800 bps");
+
+	TEST_CHECK_STR(testCommand("crc on"), "Turned CRC On");
+	TEST_CHECK_STR(testCommand("crc"), "CRC is On");
+	TEST_CHECK_STR(testCommand("crc off"), "Turned CRC Off");
+
+	TEST_CHECK_STR(testCommand("syncword 2 AB"), "Syncword Set Successfully");
+	TEST_CHECK_STR(testCommand("syncword"), "Syncword of size 2: AB");
+}
+
+static void testHelp(void) {
+	const char *help = testCommand("help");
+
+	TEST_CHECK_STR(help, "transmit [msg|#id]");
+	TEST_CHECK_STR(help, "freq [Hz]");
+	TEST_CHECK_STR(testCommand("nosuchcommand"), "Command not recognised");
+}
+
+static void testTransmit(void) {
+	uint32_t before = HostSubghz_CmdCount();
+
+	TEST_CHECK_STR(testCommand("transmit hello"), "Successful Transmission");
+
+	TEST_CHECK(HostSubghz_FindLastCmd(RADIO_SET_TX) >= (int32_t) before);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "hello", 5));
+
+	TEST_CHECK_STR(testCommand("transmit"), "Invalid Arguments");
+}
+
+static void testBudget(void) {
+	const char *budget = testCommand("budget");
+
+	TEST_CHECK_STR(budget, "  TRACE    fifo ");
+	TEST_CHECK(strstr(budget, "more not") == NULL);
+
+	/* A full table keeps counting */
+	for (uint32_t i = 0; i < MEM_BUDGET_MAX_ENTRIES; i++) {
+		MemBudget_Register("TEST", "filler", 1);
+	}
+	TEST_CHECK_STR(testCommand("budget"), " more not (MEM_BUDGET_MAX_ENTRIES)");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testFreq);
+	TEST_RUN(testSettings);
+	TEST_RUN(testHelp);
+	TEST_RUN(testTransmit);
+	TEST_RUN(testBudget);
+
+	return testResult();
+}
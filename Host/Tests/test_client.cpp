@@ -0,0 +1,186 @@
+/*
+ * test_client.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Tools/libpwnrf against the firmware under the scheduler, on the same
+ * pseudo-terminal a board's serial port would be: typed calls, errors,
+ * pipelined requests completing in order and batched configuration.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+extern "C" {
+#include "test.h"
+
+#include "usart.h"
+#include "subghz.h"
+#include "subghz_model.h"
+#include "cmsis_os.h"
+
+/* Core/Src/app_freertos.c */
+void MX_FREERTOS_Init(void);
+}
+
+#include "pwnrf.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/********************************
+ * Static Variables
+ ********************************/
+static const char *pty;
+static pwnrf::Client *client;
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: 1 if the future throws E */
+template<typename E, typename T>
+static bool throws(std::future<T> future) {
+	try {
+		future.get();
+	} catch (const E &) {
+		return true;
+	} catch (...) {
+	}
+
+	return false;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testGetSet(void) {
+	client->setFreq(868000000).get();
+	TEST_CHECK(client->getFreq().get() == 868000000);
+
+	client->setPower(10).get();
+	TEST_CHECK(client->getPower().get() == 10);
+
+	client->setCrc(false).get();
+	TEST_CHECK(!client->getCrc().get());
+	client->setCrc(true).get();
+	TEST_CHECK(client->getCrc().get());
+
+	client->setSyncword("AB").get();
+	TEST_CHECK(client->getSyncword().get() == "AB");
+
+	/* Raw lines come back without the prompt and, with echo off, without the line */
+	std::string help = client->command("datarate").get();
+	TEST_CHECK_STR(help.c_str(), "Datarate = ");
+	TEST_CHECK(help.find("> ") == std::string::npos);
+}
+
+static void testErrors(void) {
+	TEST_CHECK(throws<pwnrf::CommandError>(client->setPower(99)));
+	TEST_CHECK(throws<pwnrf::CommandError>(client->setFreq(100)));
+
+	/* The connection is still usable */
+	TEST_CHECK(client->getPower().get() == 10);
+}
+
+static void testPipeline(void) {
+	std::vector<std::future<void>> sets;
+	std::vector<std::future<uint32_t>> gets;
+
+	/* Far more than cliQueue holds, the window keeps every line */
+	for (uint32_t i = 0; i < 40; i++) {
+		sets.push_back(client->setDatarate(600 + i * 100));
+		gets.push_back(client->getDatarate());
+	}
+
+	for (uint32_t i = 0; i < 40; i++) {
+		sets[i].get();
+		TEST_CHECK(gets[i].get() == 600 + i * 100);
+	}
+}
+
+static void testConfigure(void) {
+	pwnrf::Config config;
+	config.freq = 433920000;
+	config.power = 14;
+	config.datarate = 1200;
+	config.preambleLength = 4;
+	config.syncword = "SYNC";
+
+	client->configure(config).get();
+	TEST_CHECK(client->getFreq().get() == 433920000);
+	TEST_CHECK(client->getPower().get() == 14);
+	TEST_CHECK(client->getDatarate().get() == 1200);
+	TEST_CHECK(client->getPreambleLength().get() == 4);
+	TEST_CHECK(client->getSyncword().get() == "SYNC");
+
+	/* One bad setting fails the batch, the others are still applied */
+	pwnrf::Config bad;
+	bad.power = 99;
+	bad.datarate = 2400;
+	TEST_CHECK(throws<pwnrf::CommandError>(client->configure(bad)));
+	TEST_CHECK(client->getDatarate().get() == 2400);
+}
+
+static void testSend(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	uint32_t before = radio->stats.txPackets;
+
+	client->send("hello").get();
+
+	/* A few bytes at 2400 bps, then TX done */
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+	TEST_CHECK(radio->stats.txPackets == before + 1);
+}
+
+/* @brief: Host thread using the library, ends the process with the result */
+static void *run(void *arg) {
+	(void) arg;
+
+	try {
+		pwnrf::Client connection(pty);
+		client = &connection;
+
+		TEST_RUN(testGetSet);
+		TEST_RUN(testErrors);
+		TEST_RUN(testPipeline);
+		TEST_RUN(testConfigure);
+		TEST_RUN(testSend);
+	} catch (const std::exception &e) {
+		fprintf(stderr, "%s\n", e.what());
+		testFailures++;
+	}
+
+	fflush(stdout);
+	_exit(testResult());
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	pthread_t thread;
+
+	pty = HostUart_OpenPty(NULL);
+	if (pty == NULL) {
+		printf("SKIP no pseudo-terminal\n");
+		return 0;
+	}
+
+	pthread_create(&thread, NULL, run, NULL);
+
+	/* Same start-up as the simulator */
+	MX_USART2_UART_Init();
+	MX_SUBGHZ_Init();
+	HostSubghz_StartRealTime();
+
+	osKernelInitialize();
+	MX_FREERTOS_Init();
+	osKernelStart();
+
+	return 1;
+}
@@ -0,0 +1,201 @@
+/*
+ * test_config.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Configuration journal: wear spread over its pages, saves cut short by a
+ * reset and the radio configuration restored at boot
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "radio_driver.h"
+#include "ConfigStore/config_store.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define CONFIG_OFFSET 0x36000
+#define CONFIG_PAGES 4
+#define CONFIG_FIRST_PAGE (CONFIG_OFFSET / FLASH_PAGE_SIZE)
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Reset of the board, the flash is kept */
+static void testReboot(void) {
+	HostSubghz_ClearLog();
+	MX_SubGHz_Phy_Init();
+}
+
+/* @brief: Frequency commands since the last reboot, every one of them to this frequency word */
+static uint32_t testFrequencyCmds(uint32_t word) {
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < HostSubghz_CmdCount(); i++) {
+		const HostSubghzCmd_t *cmd = HostSubghz_Cmd(i);
+
+		if (cmd->opcode == RADIO_SET_RFFREQUENCY) {
+			/* Big endian */
+			TEST_CHECK(cmd->params[0] == (uint8_t) (word >> 24) && cmd->params[1] == (uint8_t) (word >> 16)
+					&& cmd->params[2] == (uint8_t) (word >> 8) && cmd->params[3] == (uint8_t) word);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testJournal(void) {
+	uint8_t data[32], loaded[32];
+	uint32_t minErases = UINT32_MAX, maxErases = 0;
+
+	HostFlash_Reset();
+	ConfigStore_Init();
+	TEST_CHECK(!ConfigStore_Load(loaded, sizeof(loaded)));
+	TEST_CHECK(!ConfigStore_Save(data, 0));
+
+	for (uint32_t i = 0; i < 1000; i++) {
+		memset(data, i, sizeof(data));
+		TEST_CHECK(ConfigStore_Save(data, sizeof(data)));
+	}
+
+	TEST_CHECK(ConfigStore_Load(loaded, sizeof(loaded)) && !memcmp(loaded, data, sizeof(data)));
+	TEST_CHECK(!ConfigStore_Load(loaded, sizeof(loaded) - 1));
+
+	/* The same latest record after a reboot */
+	ConfigStore_Init();
+	memset(loaded, 0, sizeof(loaded));
+	TEST_CHECK(ConfigStore_Load(loaded, sizeof(loaded)) && !memcmp(loaded, data, sizeof(data)));
+
+	/* 40 byte records, 51 in a page: every page is erased once a turn of the journal */
+	for (uint32_t page = CONFIG_FIRST_PAGE; page < CONFIG_FIRST_PAGE + CONFIG_PAGES; page++) {
+		uint32_t erases = HostFlash_PageErases(page);
+		minErases = erases < minErases ? erases : minErases;
+		maxErases = erases > maxErases ? erases : maxErases;
+	}
+	TEST_CHECK(HostFlash_Stats()->erases == 1000 / 51);
+	TEST_CHECK(maxErases - minErases <= 1);
+	TEST_CHECK(HostFlash_PageErases(CONFIG_FIRST_PAGE - 1) == 0);
+	TEST_CHECK(HostFlash_PageErases(CONFIG_FIRST_PAGE + CONFIG_PAGES) == 0);
+	TEST_CHECK(HostFlash_Stats()->errors == 0);
+}
+
+static void testTornSave(void) {
+	uint8_t loaded[12];
+
+	HostFlash_Reset();
+	ConfigStore_Init();
+
+	TEST_CHECK(ConfigStore_Save("first save", 11));
+	TEST_CHECK(ConfigStore_Save("second save", 12));
+
+	/* Reset while the data of the second record was programmed */
+	memset(&HostFlash[CONFIG_OFFSET + 24 + 8 + 8], 0xFF, 8);
+	ConfigStore_Init();
+	TEST_CHECK(ConfigStore_Load(loaded, 11) && !memcmp(loaded, "first save", 11));
+
+	/* The next record goes after the torn one and is the latest */
+	TEST_CHECK(ConfigStore_Save("third save", 11));
+	ConfigStore_Init();
+	TEST_CHECK(ConfigStore_Load(loaded, 11) && !memcmp(loaded, "third save", 11));
+	TEST_CHECK(HostFlash_Stats()->errors == 0);
+}
+
+static void testTornErase(void) {
+	uint8_t data[32], loaded[32];
+
+	HostFlash_Reset();
+	ConfigStore_Init();
+
+	/* Fill the first page, a reset while erasing the second one leaves part of it programmed */
+	for (uint32_t i = 0; i < 51; i++) {
+		memset(data, i, sizeof(data));
+		TEST_CHECK(ConfigStore_Save(data, sizeof(data)));
+	}
+	memset(&HostFlash[CONFIG_OFFSET + FLASH_PAGE_SIZE], 0x12, 64);
+
+	ConfigStore_Init();
+	TEST_CHECK(ConfigStore_Load(loaded, sizeof(loaded)) && !memcmp(loaded, data, sizeof(data)));
+
+	/* The journal erases the page again and moves on */
+	memset(data, 0x77, sizeof(data));
+	TEST_CHECK(ConfigStore_Save(data, sizeof(data)));
+	TEST_CHECK(HostFlash_PageErases(CONFIG_FIRST_PAGE + 1) == 1);
+
+	ConfigStore_Init();
+	TEST_CHECK(ConfigStore_Load(loaded, sizeof(loaded)) && !memcmp(loaded, data, sizeof(data)));
+	TEST_CHECK(HostFlash_Stats()->errors == 0);
+}
+
+static void testRestore(void) {
+	char word[8];
+
+	HostFlash_Reset();
+	testReboot();
+
+	TEST_CHECK_STR(testCommand("config"), "Restore at Boot is On");
+	TEST_CHECK_STR(testCommand("config load"), "No Saved Configuration");
+	TEST_CHECK_STR(testCommand("freq 868000000"), "Frequency Set Successfully");
+	TEST_CHECK_STR(testCommand("power 10"), "Power Set Successfully");
+	TEST_CHECK_STR(testCommand("datarate 1200"), "Datarate Set Successfully");
+	TEST_CHECK_STR(testCommand("crc on"), "Turned CRC On");
+	SubghzApp_SetSyncword(2, "\x2D\xD4");
+	TEST_CHECK_STR(testCommand("config save"), "Configuration Saved");
+
+	TEST_CHECK_STR(testCommand("freq 915000000"), "Frequency Set Successfully");
+	testReboot();
+
+	/* The radio is only ever set to the saved configuration */
+	TEST_CHECK(SubghzApp_GetFreq() == 868000000 && SubghzApp_GetPower() == 10);
+	TEST_CHECK(SubghzApp_GetDatarate() == 1200 && SubghzApp_GetCRC());
+	TEST_CHECK(SubghzApp_GetSyncword(word) == 2 && !memcmp(word, "\x2D\xD4", 2));
+	TEST_CHECK(testFrequencyCmds(0x36400000) == 1);
+
+	/* Without restore the defaults are back, the saved configuration is kept */
+	TEST_CHECK_STR(testCommand("config restore off"), "Turned Restore at Boot Off");
+	testReboot();
+	TEST_CHECK(SubghzApp_GetFreq() == 433000000 && SubghzApp_GetPower() == 15);
+	TEST_CHECK(SubghzApp_GetDatarate() == 600 && !SubghzApp_GetCRC());
+	TEST_CHECK_STR(testCommand("config"), "Restore at Boot is Off");
+
+	TEST_CHECK_STR(testCommand("config load"), "Configuration Loaded");
+	TEST_CHECK(SubghzApp_GetFreq() == 868000000 && SubghzApp_GetDatarate() == 1200);
+	TEST_CHECK_STR(testCommand("freq"), "Frequency = 868.000 MHz");
+
+	TEST_CHECK_STR(testCommand("config restore on"), "Turned Restore at Boot On");
+	TEST_CHECK_STR(testCommand("freq 433000000"), "Frequency Set Successfully");
+	testReboot();
+	TEST_CHECK(SubghzApp_GetFreq() == 868000000);
+
+	TEST_CHECK_STR(testCommand("config restore"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("config erase"), "Invalid Arguments");
+
+	/* A fresh part boots with the defaults */
+	HostFlash_Reset();
+	testReboot();
+	TEST_CHECK(SubghzApp_GetFreq() == 433000000 && SubghzApp_GetPower() == 15);
+	TEST_CHECK_STR(testCommand("config load"), "No Saved Configuration");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testJournal);
+	TEST_RUN(testTornSave);
+	TEST_RUN(testTornErase);
+	TEST_RUN(testRestore);
+
+	return testResult();
+}
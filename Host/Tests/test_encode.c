@@ -0,0 +1,171 @@
+/*
+ * test_encode.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Table driven CRC and whitening against the catalogue check values and the
+ * bitwise references, and the encoding stage in front of the radio
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "Encode/encode.h"
+
+/********************************
+ * Static Variables
+ ********************************/
+static const uint8_t check[] = "123456789";
+
+/* CRC of "123456789" for every preset, in the order of Encode_CrcPresets */
+static const uint32_t checkValues[] = {
+	0xF4, 0xA1, 0x29B1, 0x31C3, 0x2189, 0xBB3D, 0x4B37, 0xC25A56, 0xCBF43926,
+};
+
+/* CC1101 PN9 sequence, the whitening of zeros */
+static const uint8_t pn9[] = {
+	0xFF, 0xE1, 0x1D, 0x9A, 0xED, 0x85, 0x33, 0x24, 0xEA, 0x7A, 0xD2, 0x39, 0x70, 0x97, 0x57, 0x0A,
+};
+
+static uint32_t randomState = 1;
+
+/********************************
+ * Helpers
+ ********************************/
+static uint8_t randomByte(void) {
+	randomState = randomState * 1103515245 + 12345;
+
+	return randomState >> 16;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testCrcCheckValues(void) {
+	static EncodeCrcTable_t table;
+	uint32_t i = 0;
+
+	for (const EncodeCrcPreset_t *preset = Encode_CrcPresets; preset->name != NULL; preset++, i++) {
+		Encode_CrcTableInit(&table, &preset->crc);
+
+		TEST_CHECK(Encode_Crc(&table, check, 9) == checkValues[i]);
+		TEST_CHECK(Encode_CrcBitwise(&preset->crc, check, 9) == checkValues[i]);
+	}
+	TEST_CHECK(i == sizeof(checkValues) / sizeof(checkValues[0]));
+
+	/* CRC-12/UMTS, an odd width with refin != refout */
+	const EncodeCrc_t umts = { 12, 0x80F, 0x000, 0x000, 0, 1 };
+	Encode_CrcTableInit(&table, &umts);
+	TEST_CHECK(Encode_Crc(&table, check, 9) == 0xDAF);
+}
+
+static void testCrcMatchesBitwise(void) {
+	static EncodeCrcTable_t table;
+	const EncodeCrc_t custom[] = {
+		{ 16, 0x8005, 0xFFFF, 0x0000, 0, 0 },
+		{ 8, 0x9B, 0xFF, 0x00, 1, 0 },
+		{ 32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, 1, 1 },
+	};
+	uint8_t data[80];
+
+	for (uint32_t i = 0; i < sizeof(data); i++) {
+		data[i] = randomByte();
+	}
+
+	for (const EncodeCrcPreset_t *preset = Encode_CrcPresets; preset->name != NULL; preset++) {
+		Encode_CrcTableInit(&table, &preset->crc);
+
+		/* Every length and alignment around the 4 byte steps */
+		for (uint32_t offset = 0; offset < 4; offset++) {
+			for (uint32_t len = 0; len <= 70; len++) {
+				TEST_CHECK(Encode_Crc(&table, &data[offset], len) == Encode_CrcBitwise(&preset->crc, &data[offset], len));
+			}
+		}
+	}
+
+	for (uint32_t c = 0; c < sizeof(custom) / sizeof(custom[0]); c++) {
+		Encode_CrcTableInit(&table, &custom[c]);
+
+		for (uint32_t len = 0; len <= 70; len++) {
+			TEST_CHECK(Encode_Crc(&table, data, len) == Encode_CrcBitwise(&custom[c], data, len));
+		}
+	}
+}
+
+static void testWhitening(void) {
+	static EncodeWhiteningTable_t table;
+	uint8_t data[sizeof(pn9)] = {0};
+	uint8_t reference[67], fast[67];
+
+	Encode_WhiteningTableInit(&table, &Encode_WhiteningPresets[0].whitening);
+	Encode_Whiten(&table, data, sizeof(data));
+	TEST_CHECK(!memcmp(data, pn9, sizeof(pn9)));
+
+	for (const EncodeWhiteningPreset_t *preset = Encode_WhiteningPresets; preset->name != NULL; preset++) {
+		for (uint32_t i = 0; i < sizeof(reference); i++) {
+			reference[i] = fast[i] = randomByte();
+		}
+
+		Encode_WhiteningTableInit(&table, &preset->whitening);
+		Encode_WhitenBitwise(&preset->whitening, reference, sizeof(reference));
+		Encode_Whiten(&table, fast, sizeof(fast));
+		TEST_CHECK(!memcmp(reference, fast, sizeof(fast)));
+	}
+
+	/* The MSB first variant is the same sequence with every byte reversed */
+	memset(data, 0, sizeof(data));
+	Encode_WhitenBitwise(&Encode_WhiteningPresets[1].whitening, data, sizeof(data));
+	TEST_CHECK(data[1] == 0x87 && data[2] == 0xB8);
+}
+
+static void testApply(void) {
+	uint8_t expected[11];
+
+	TEST_CHECK_STR(testCommand("encode crc crc16-ccitt"), "Software CRC Set Successfully");
+	TEST_CHECK_STR(testCommand("encode whitening pn9"), "Software Whitening Set Successfully");
+	TEST_CHECK_STR(testCommand("encode"), "CRC-16 poly=0x1021 init=0xffff xorout=0x0 ref=0/0");
+	TEST_CHECK_STR(testCommand("encode"), "Whitening PN9 taps=0x21 seed=0x1ff LSB first");
+
+	/* CRC appended MSB first, then payload and CRC whitened */
+	memcpy(expected, check, 9);
+	expected[9] = 0x29;
+	expected[10] = 0xB1;
+	for (uint32_t i = 0; i < sizeof(expected); i++) {
+		expected[i] ^= i < sizeof(pn9) ? pn9[i] : 0;
+	}
+
+	SubghzApp_Sent((char *) check, 9);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), expected, sizeof(expected)));
+
+	/* A custom CRC, reflected, appended LSB first */
+	TEST_CHECK_STR(testCommand("encode whitening off"), "Software Whitening Off");
+	TEST_CHECK_STR(testCommand("encode crc 16 0x8005 0xffff 0 1"), "Software CRC Set Successfully");
+	SubghzApp_Sent((char *) check, 9);
+	TEST_CHECK(HostSubghz_Buffer()[9] == 0x37 && HostSubghz_Buffer()[10] == 0x4B);
+
+	TEST_CHECK_STR(testCommand("encode crc 4 0x3"), "Invalid CRC");
+	TEST_CHECK_STR(testCommand("encode whitening 9 0x21 0"), "Invalid Whitening");
+	TEST_CHECK_STR(testCommand("encode off"), "Encoding Off");
+	TEST_CHECK_STR(testCommand("encode"), "CRC Off");
+
+	SubghzApp_Sent("pwnRF", 5);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwnRF", 5));
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testCrcCheckValues);
+	TEST_RUN(testCrcMatchesBitwise);
+	TEST_RUN(testWhitening);
+	TEST_RUN(testApply);
+
+	return testResult();
+}
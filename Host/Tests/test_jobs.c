@@ -0,0 +1,239 @@
+/*
+ * test_jobs.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Periodic TX jobs: deadline order, collisions resolved by priority or slip,
+ * skipped periods and the per job radio configuration
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "radio_driver.h"
+#include "Jobs/jobs.h"
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: 1 ms on air per payload byte */
+static uint32_t testAirtime(const JobConfig_t *config) {
+	return config->size;
+}
+
+static JobConfig_t testJob(uint32_t period, uint8_t priority, const char *payload) {
+	JobConfig_t config = {
+		.period = period,
+		.priority = priority,
+		.data = (const uint8_t *) payload,
+		.size = strlen(payload),
+	};
+
+	return config;
+}
+
+/* @brief: Runs the scheduler like its timer does until end, returns the packets sent */
+static uint32_t testRun(uint32_t now, uint32_t end) {
+	uint32_t packets = 0, onAirUntil = 0, wait;
+
+	while (now < end) {
+		int32_t job = Jobs_Next(now, &wait);
+
+		if (job >= 0) {
+			/* Never two packets on air */
+			TEST_CHECK(now >= onAirUntil);
+			onAirUntil = now + Jobs_Get(job)->airtime;
+			packets++;
+		}
+
+		now += wait != 0 ? wait : 1;
+	}
+
+	return packets;
+}
+
+static uint32_t testFrequencyCmds(void) {
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < HostSubghz_CmdCount(); i++) {
+		count += HostSubghz_Cmd(i)->opcode == RADIO_SET_RFFREQUENCY;
+	}
+
+	return count;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testJobsCommand(void) {
+	TEST_CHECK_STR(testCommand("jobs clear"), "Jobs Cleared");
+	TEST_CHECK_STR(testCommand("jobs"), "No Jobs");
+	TEST_CHECK_STR(testCommand("jobs add 0 beacon"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("jobs add 100 power=40 beacon"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("jobs add 100 freq=12 beacon"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("jobs add 100 rate=1200"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("jobs add 100 #99"), "Unknown Payload");
+
+	TEST_CHECK_STR(testCommand("jobs add 1000 freq=868000000 rate=1200 prio=2 hello world"), "Job 0 Added");
+	TEST_CHECK_STR(testCommand("jobs add 250 beacon"), "Job 1 Added");
+	TEST_CHECK_STR(testCommand("jobs"), "Job 0: 1000 ms, prio 2, 0 sent");
+	TEST_CHECK_STR(testCommand("jobs"), "Job 1: 250 ms, prio 0, 0 sent");
+
+	/* Both due, the higher priority one first at its own frequency */
+	uint32_t now = Jobs_Get(0)->next;
+	HostSubghz_ClearLog();
+	uint32_t wait = SubghzApp_RunJobs(now);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "hello world", 11));
+	TEST_CHECK(testFrequencyCmds() == 1);
+
+	/* 11 bytes, 3 sync bytes and 5 preamble bytes at 1200 bps */
+	TEST_CHECK(wait == 127);
+
+	/* Back to the current configuration for the next job */
+	SubghzApp_RunJobs(now + wait);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "beacon", 6));
+	TEST_CHECK(testFrequencyCmds() == 2);
+	TEST_CHECK(Jobs_Get(1)->lateLast == 127 && Jobs_Get(1)->slipped == 0);
+
+	/* The job configuration is only sent again when the radio lost it */
+	SubghzApp_RunJobs(now + 1000);
+	HostSubghz_ClearLog();
+	SubghzApp_RunJobs(now + 2000);
+	TEST_CHECK(testFrequencyCmds() == 0);
+	TEST_CHECK_STR(testCommand("transmit x"), "Successful Transmission");
+	TEST_CHECK(testFrequencyCmds() == 1);
+	SubghzApp_RunJobs(now + 3000);
+	TEST_CHECK(testFrequencyCmds() == 2);
+
+	TEST_CHECK_STR(testCommand("jobs"), "Job 0: 1000 ms, prio 2, 4 sent, 1.00/s, late 0/0/0 ms");
+	TEST_CHECK_STR(testCommand("jobs del 0"), "Job Removed");
+	TEST_CHECK_STR(testCommand("jobs del 0"), "Unknown Job");
+	TEST_CHECK_STR(testCommand("jobs del"), "Unknown Job");
+	TEST_CHECK_STR(testCommand("jobs"), "Job 1: 250 ms");
+	TEST_CHECK_STR(testCommand("jobs clear"), "Jobs Cleared");
+	TEST_CHECK_STR(testCommand("jobs"), "No Jobs");
+}
+
+static void testDeadlineOrder(void) {
+	JobConfig_t fast = testJob(100, 0, "0123456789");
+	JobConfig_t slow = testJob(150, 0, "0123456789");
+
+	Jobs_Init(testAirtime);
+	TEST_CHECK(Jobs_Add(&fast, 0) == 0);
+	TEST_CHECK(Jobs_Add(&slow, 0) == 1);
+
+	TEST_CHECK(testRun(0, 3000) == 30 + 20);
+	TEST_CHECK(Jobs_Get(0)->sent == 30 && Jobs_Get(1)->sent == 20);
+	TEST_CHECK(Jobs_Get(0)->skipped == 0 && Jobs_Get(1)->skipped == 0);
+
+	/* Only late by the airtime of the other job */
+	TEST_CHECK(Jobs_Get(0)->lateMax <= 10 && Jobs_Get(1)->lateMax <= 10);
+	TEST_CHECK(Jobs_Get(0)->lastSent - Jobs_Get(0)->firstSent == 2900);
+}
+
+static void testPriority(void) {
+	JobConfig_t low = testJob(100, 0, "012345678901234567890123456789");
+	JobConfig_t high = testJob(100, 1, "0123456789");
+	uint32_t wait;
+
+	/* Due together, the higher priority job goes first */
+	Jobs_Init(testAirtime);
+	Jobs_Add(&low, 0);
+	Jobs_Add(&high, 0);
+
+	TEST_CHECK(Jobs_Next(0, &wait) == 1 && wait == 10);
+	TEST_CHECK(Jobs_Next(5, &wait) == -1 && wait == 5);
+	TEST_CHECK(Jobs_Next(10, &wait) == 0 && wait == 30);
+	TEST_CHECK(Jobs_Get(0)->lateLast == 10 && Jobs_Get(0)->slipped == 0);
+
+	/* The low priority job would still be on air at the deadline of the high one, it slips */
+	Jobs_Clear();
+	Jobs_Add(&low, 0);
+	Jobs_Add(&high, 20);
+
+	TEST_CHECK(Jobs_Next(0, &wait) == -1 && wait == 20);
+	TEST_CHECK(Jobs_Next(20, &wait) == 1 && wait == 10);
+	TEST_CHECK(Jobs_Next(30, &wait) == 0);
+	TEST_CHECK(Jobs_Get(0)->lateLast == 30 && Jobs_Get(0)->slipped == 1);
+	TEST_CHECK(Jobs_Get(1)->lateLast == 0);
+
+	/* A lower priority job does not hold a packet back */
+	Jobs_Clear();
+	Jobs_Add(&high, 0);
+	Jobs_Add(&low, 5);
+	TEST_CHECK(Jobs_Next(0, &wait) == 0);
+	TEST_CHECK(Jobs_Get(0)->slipped == 0);
+}
+
+static void testSkip(void) {
+	JobConfig_t job = testJob(10, 0, "x");
+	uint32_t wait;
+
+	Jobs_Init(testAirtime);
+	Jobs_Add(&job, 0);
+
+	/* 35 ms late: three periods dropped, the job keeps its phase */
+	TEST_CHECK(Jobs_Next(35, &wait) == 0);
+	TEST_CHECK(Jobs_Get(0)->skipped == 3 && Jobs_Get(0)->lateLast == 35);
+	TEST_CHECK(Jobs_Get(0)->next == 40);
+
+	TEST_CHECK(Jobs_Next(36, &wait) == -1 && wait == 4);
+	TEST_CHECK(Jobs_Next(40, &wait) == 0 && Jobs_Get(0)->lateLast == 0);
+
+	/* The tick counter wraps */
+	Jobs_Clear();
+	Jobs_Add(&job, UINT32_MAX - 5);
+	TEST_CHECK(Jobs_Next(UINT32_MAX - 5, &wait) == 0);
+	TEST_CHECK(Jobs_Next(UINT32_MAX - 4, &wait) == -1 && wait == 9);
+	TEST_CHECK(Jobs_Next(4, &wait) == 0 && Jobs_Get(0)->lateLast == 0);
+}
+
+static void testSlots(void) {
+	JobConfig_t job = testJob(100, 0, "x");
+	JobConfig_t empty = testJob(100, 0, "");
+	uint8_t large[JOBS_MAX_PAYLOAD + 1] = {0};
+
+	Jobs_Init(testAirtime);
+	TEST_CHECK(Jobs_Add(&empty, 0) == -1);
+
+	job.data = large;
+	job.size = sizeof(large);
+	TEST_CHECK(Jobs_Add(&job, 0) == -1);
+
+	/* A stored payload stays in place */
+	job.stored = 1;
+	TEST_CHECK(Jobs_Add(&job, 0) == 0 && Jobs_Get(0)->config.data == large);
+
+	job = testJob(100, 0, "x");
+	for (uint32_t i = 1; i < JOBS_MAX; i++) {
+		TEST_CHECK(Jobs_Add(&job, 0) == (int32_t) i);
+	}
+	TEST_CHECK(Jobs_Add(&job, 0) == -1);
+	TEST_CHECK(Jobs_Count() == JOBS_MAX);
+
+	TEST_CHECK(Jobs_Remove(3) && !Jobs_Remove(3) && Jobs_Get(3) == NULL);
+	TEST_CHECK(Jobs_Add(&job, 0) == 3);
+	TEST_CHECK(Jobs_Get(3)->config.data == Jobs_Get(3)->payload);
+
+	Jobs_Clear();
+	TEST_CHECK(Jobs_Count() == 0);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testJobsCommand);
+	TEST_RUN(testDeadlineOrder);
+	TEST_RUN(testPriority);
+	TEST_RUN(testSkip);
+	TEST_RUN(testSlots);
+
+	return testResult();
+}
@@ -0,0 +1,196 @@
+/*
+ * test_ook.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * OOK symbol encoder: the pattern tables against the chip at a time
+ * reference, known PWM and Manchester frames, the PA keyed at the chip
+ * edges, and the `ook` command reaching the radio
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+#include "Ook/ook.h"
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint32_t randomState = 3;
+
+/********************************
+ * Helpers
+ ********************************/
+static uint32_t randomNumber(uint32_t max) {
+	randomState = randomState * 1103515245 + 12345;
+
+	return (randomState >> 8) % (max + 1);
+}
+
+static OokSymbol_t randomSymbol(uint16_t chipUs, uint32_t maxChips) {
+	uint32_t first = randomNumber(maxChips - 1);
+	uint32_t second = 1 + randomNumber(maxChips - 1 - first);
+
+	return (OokSymbol_t) { randomNumber(1), first * chipUs, second * chipUs };
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testMatchesReference(void) {
+	static uint8_t fast[OOK_MAX_CHIPS / 8], reference[OOK_MAX_CHIPS / 8];
+	OokEncoder_t encoder;
+
+	for (uint32_t run = 0; run < 500; run++) {
+		OokProtocol_t protocol = {
+			.chipUs = 100 + randomNumber(400),
+			.repeats = 1 + randomNumber(9),
+		};
+		protocol.zero = randomSymbol(protocol.chipUs, OOK_MAX_SYMBOL_CHIPS);
+		protocol.one = randomSymbol(protocol.chipUs, OOK_MAX_SYMBOL_CHIPS);
+		protocol.sync = randomNumber(1) ? randomSymbol(protocol.chipUs, 40) : (OokSymbol_t) { 0 };
+		protocol.gapUs = randomNumber(20) * protocol.chipUs;
+
+		uint8_t code[8];
+		uint32_t bits = 1 + randomNumber(63);
+		for (uint32_t i = 0; i < sizeof(code); i++) {
+			code[i] = randomNumber(255);
+		}
+
+		TEST_CHECK(Ook_Compile(&encoder, &protocol));
+
+		memset(fast, 0, sizeof(fast));
+		uint32_t chips = Ook_Encode(&encoder, code, bits, fast, sizeof(fast));
+		TEST_CHECK(chips == Ook_EncodeReference(&protocol, code, bits, reference, sizeof(reference)));
+		TEST_CHECK(!memcmp(fast, reference, (chips + 7) / 8));
+	}
+}
+
+static void testFrames(void) {
+	OokEncoder_t encoder;
+	uint8_t out[64];
+
+	/* EV1527 style after boot: 1:31 sync, then 1 = 1110 and 0 = 1000 */
+	const uint8_t code[] = { 0xA0 };
+	TEST_CHECK(Ook_Compile(&encoder, Ook_GetProtocol()));
+	TEST_CHECK(Ook_Encode(&encoder, code, 4, out, sizeof(out)) == 10 * (32 + 16));
+	TEST_CHECK(out[0] == 0x80 && out[1] == 0x00 && out[3] == 0x00);
+	TEST_CHECK(out[4] == 0xE8 && out[5] == 0xE8);
+
+	/* Manchester, 0 is high then low */
+	const OokProtocol_t manchester = { .chipUs = 500, .zero = { 1, 500, 500 }, .one = { 0, 500, 500 }, .repeats = 1 };
+	const uint8_t byte[] = { 0x0F };
+	TEST_CHECK(Ook_Compile(&encoder, &manchester));
+	TEST_CHECK(Ook_Encode(&encoder, byte, 8, out, sizeof(out)) == 16);
+	TEST_CHECK(out[0] == 0xAA && out[1] == 0x55);
+
+	/* Does not fit */
+	TEST_CHECK(Ook_Encode(&encoder, byte, 8, out, 1) == 0);
+
+	/* Symbols longer than a nibble pattern can hold */
+	const OokProtocol_t tooLong = { .chipUs = 100, .zero = { 1, 100, 1500 }, .one = { 1, 100, 100 }, .repeats = 1 };
+	TEST_CHECK(!Ook_Compile(&encoder, &tooLong));
+}
+
+static void testKeyed(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	/* 1100 1010 0001, runs of one to three chips ending in a pulse */
+	static const uint8_t chips[] = { 0xCA, 0x10 };
+	const uint32_t count = 12, chipUs = 400;
+
+	Host_SetVirtualTime(1);
+	SubghzModel_WaitBusy(radio);
+
+	TEST_CHECK_STR(testCommand("ook mode"), "OOK Mode = PA");
+	TEST_CHECK(SubghzApp_SendOok(chips, count, chipUs));
+
+	/* The frame owns the radio until it ended */
+	TEST_CHECK(SubghzApp_OokActive());
+	TEST_CHECK(!SubghzApp_Sent("x", 1));
+	TEST_CHECK(!SubghzApp_SendOok(chips, count, chipUs));
+	TEST_CHECK_STR(testCommand("ook send 24 a5a5a5"), "Radio Busy");
+
+	/* The first edge turns the carrier on the PA ramp before chip 0, the others follow from it */
+	uint64_t start = SubghzAir_NextEventNs() + SUBGHZ_OOK_PA_RAMP_US * 1000;
+	for (uint32_t i = 0; i < count; i++) {
+		SubghzAir_Advance(start + (i * chipUs + chipUs / 2) * 1000 - Host_GetTimeNs());
+		uint8_t on = (chips[i / 8] >> (7 - i % 8)) & 1;
+		TEST_CHECK((radio->mode == SUBGHZ_MODEL_TX) == on);
+		TEST_CHECK(radio->mode == SUBGHZ_MODEL_TX || radio->mode == SUBGHZ_MODEL_FS);
+	}
+
+	TEST_CHECK(SubghzApp_OokActive());
+	SubghzAir_Advance(start + count * chipUs * 1000 - Host_GetTimeNs());
+	TEST_CHECK(!SubghzApp_OokActive());
+	TEST_CHECK(radio->mode != SUBGHZ_MODEL_TX);
+	Host_SetVirtualTime(0);
+
+	/* Chips shorter than a keyed one are sent as 2-FSK */
+	TEST_CHECK(SubghzApp_SendOok(chips, count, SUBGHZ_OOK_MIN_KEYED_US - 1));
+	TEST_CHECK(!SubghzApp_OokActive() && radio->mode == SUBGHZ_MODEL_TX);
+}
+
+static void testOokCommand(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	OokEncoder_t encoder;
+	uint8_t expected[OOK_MAX_CHIPS / 8];
+	const uint8_t code[] = { 0xA5, 0xA5, 0xA5 };
+
+	/* The 2-FSK fallback, a packet of one bit per chip */
+	TEST_CHECK_STR(testCommand("ook mode am"), "Invalid Mode");
+	TEST_CHECK_STR(testCommand("ook mode fsk"), "OOK Mode Set Successfully");
+	TEST_CHECK_STR(testCommand("ook mode"), "OOK Mode = FSK");
+	SubghzApp_Sent("x", 1);
+	uint32_t freqReg = radio->freqReg;
+
+	TEST_CHECK_STR(testCommand("ook pwm 350 1051"), "Invalid Protocol");
+	TEST_CHECK_STR(testCommand("ook pwm 350 1050 350 10850"), "OOK Protocol Set Successfully");
+	TEST_CHECK_STR(testCommand("ook repeat 4 700"), "OOK Protocol Set Successfully");
+	TEST_CHECK_STR(testCommand("ook"), "OOK 350 us chips, 0=H350/1050 1=H1050/350 sync=H350/10850 gap=700 us x4");
+
+	TEST_CHECK_STR(testCommand("ook send 24 a5a5a5"), "OOK Transmission of 520 chips");
+	TEST_CHECK(Ook_Compile(&encoder, Ook_GetProtocol()));
+	TEST_CHECK(Ook_Encode(&encoder, code, 24, expected, sizeof(expected)) == 520);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), expected, 65));
+
+	/* Carrier on at the set frequency, off below it, then the next packet is FSK again */
+	TEST_CHECK(radio->freqReg != freqReg);
+	SubghzApp_Sent("x", 1);
+	TEST_CHECK(radio->freqReg == freqReg);
+
+	/* Half the offset parks the carrier half as far below */
+	TEST_CHECK_STR(testCommand("ook offset"), "OOK Offset = 100.000 kHz");
+	TEST_CHECK_STR(testCommand("ook offset 0"), "Invalid Offset");
+	TEST_CHECK_STR(testCommand("ook offset 200001"), "Invalid Offset");
+	TEST_CHECK_STR(testCommand("ook send 24 a5a5a5"), "OOK Transmission of 520 chips");
+	uint32_t below = freqReg - radio->freqReg;
+	TEST_CHECK_STR(testCommand("ook offset 50000"), "OOK Offset Set Successfully");
+	TEST_CHECK_STR(testCommand("ook send 24 a5a5a5"), "OOK Transmission of 520 chips");
+	TEST_CHECK(freqReg - radio->freqReg + 1 >= below / 2 && freqReg - radio->freqReg <= below / 2 + 1);
+	TEST_CHECK(SubghzApp_SetOokOffset(SUBGHZ_OOK_OFFSET));
+	SubghzApp_Sent("x", 1);
+
+	TEST_CHECK_STR(testCommand("ook repeat 10"), "OOK Protocol Set Successfully");
+	TEST_CHECK_STR(testCommand("ook send 64 ffffffffffffffff"), "OOK Frame Too Long");
+	TEST_CHECK_STR(testCommand("ook send 65 1"), "Invalid Code");
+	TEST_CHECK_STR(testCommand("ook mode pa"), "OOK Mode Set Successfully");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testMatchesReference);
+	TEST_RUN(testFrames);
+	TEST_RUN(testKeyed);
+	TEST_RUN(testOokCommand);
+
+	return testResult();
+}
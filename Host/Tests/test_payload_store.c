@@ -0,0 +1,175 @@
+/*
+ * test_payload_store.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Payload store: the log in flash, its index rebuilt at boot, records cut short
+ * by a reset and payloads sent by ID
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "PayloadStore/payload_store.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define STORE_OFFSET 0x38000
+#define STORE_SIZE (32 * 1024)
+
+/********************************
+ * Helpers
+ ********************************/
+static uint8_t inStore(const uint8_t *p) {
+	return p >= &HostFlash[STORE_OFFSET] && p < &HostFlash[STORE_OFFSET + STORE_SIZE];
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testLog(void) {
+	PayloadStoreUsage_t usage;
+	uint8_t large[255], size;
+
+	for (uint32_t i = 0; i < sizeof(large); i++) {
+		large[i] = i;
+	}
+
+	HostFlash_Reset();
+	PayloadStore_Init();
+	PayloadStore_GetUsage(&usage);
+	TEST_CHECK(usage.payloads == 0 && usage.used == 0 && usage.size == STORE_SIZE);
+
+	TEST_CHECK(PayloadStore_Add(1, (const uint8_t *) "hello", 5));
+	TEST_CHECK(PayloadStore_Add(2, large, sizeof(large)));
+	TEST_CHECK(!PayloadStore_Add(PAYLOAD_STORE_MAX_IDS, large, 1));
+	TEST_CHECK(!PayloadStore_Add(3, large, 0));
+
+	/* Read in place from flash */
+	const uint8_t *payload = PayloadStore_Get(2, &size);
+	TEST_CHECK(payload != NULL && inStore(payload) && size == 255 && !memcmp(payload, large, 255));
+
+	/* Replaced and deleted IDs stay in the log */
+	TEST_CHECK(PayloadStore_Add(1, (const uint8_t *) "pwnRF!", 6));
+	TEST_CHECK(PayloadStore_Delete(2));
+	TEST_CHECK(!PayloadStore_Delete(2));
+	TEST_CHECK(PayloadStore_Get(2, &size) == NULL);
+
+	payload = PayloadStore_Get(1, &size);
+	TEST_CHECK(payload != NULL && size == 6 && !memcmp(payload, "pwnRF!", 6));
+
+	PayloadStore_GetUsage(&usage);
+	TEST_CHECK(usage.payloads == 1 && usage.records == 4);
+	TEST_CHECK(usage.used == 8 + 8 + 8 + 256 + 8 + 8 + 8);
+	TEST_CHECK(HostFlash_Stats()->errors == 0);
+
+	/* The index after a reboot is the same */
+	PayloadStore_Init();
+	PayloadStore_GetUsage(&usage);
+	TEST_CHECK(usage.payloads == 1 && usage.records == 4 && usage.used == 304);
+	TEST_CHECK(PayloadStore_Get(1, &size) == payload);
+	TEST_CHECK(PayloadStore_Get(2, &size) == NULL);
+}
+
+static void testTornRecord(void) {
+	uint8_t size;
+
+	HostFlash_Reset();
+	PayloadStore_Init();
+
+	TEST_CHECK(PayloadStore_Add(7, (const uint8_t *) "first", 5));
+	TEST_CHECK(PayloadStore_Add(7, (const uint8_t *) "second!!!", 9));
+	TEST_CHECK(PayloadStore_Add(8, (const uint8_t *) "after", 5));
+
+	/* Reset while the second payload was programmed: its last double word is still erased */
+	memset(&HostFlash[STORE_OFFSET + 16 + 8 + 8], 0xFF, 8);
+	PayloadStore_Init();
+
+	/* The older record of the ID is back, the records after it are intact */
+	const uint8_t *payload = PayloadStore_Get(7, &size);
+	TEST_CHECK(payload != NULL && size == 5 && !memcmp(payload, "first", 5));
+	payload = PayloadStore_Get(8, &size);
+	TEST_CHECK(payload != NULL && size == 5 && !memcmp(payload, "after", 5));
+
+	/* New records go after the torn one */
+	TEST_CHECK(PayloadStore_Add(9, (const uint8_t *) "x", 1));
+	TEST_CHECK(HostFlash_Stats()->errors == 0);
+}
+
+static void testFullAndErase(void) {
+	PayloadStoreUsage_t usage;
+	uint8_t block[248], size;
+	uint32_t added = 0;
+
+	memset(block, 0xA5, sizeof(block));
+	HostFlash_Reset();
+	PayloadStore_Init();
+
+	while (PayloadStore_Add(added % PAYLOAD_STORE_MAX_IDS, block, sizeof(block))) {
+		added++;
+	}
+
+	/* 256 byte records fill the store exactly */
+	TEST_CHECK(added == STORE_SIZE / 256);
+	PayloadStore_GetUsage(&usage);
+	TEST_CHECK(usage.used == STORE_SIZE);
+
+	TEST_CHECK(PayloadStore_Erase());
+	TEST_CHECK(PayloadStore_Get(0, &size) == NULL);
+	PayloadStore_GetUsage(&usage);
+	TEST_CHECK(usage.used == 0 && usage.records == 0);
+
+	/* Only the pages of the store were erased, each once */
+	TEST_CHECK(HostFlash_Stats()->erases == STORE_SIZE / FLASH_PAGE_SIZE);
+	TEST_CHECK(HostFlash_PageErases(STORE_OFFSET / FLASH_PAGE_SIZE) == 1);
+	TEST_CHECK(HostFlash_PageErases(STORE_OFFSET / FLASH_PAGE_SIZE - 1) == 0);
+	TEST_CHECK(PayloadStore_Add(0, block, 1));
+}
+
+static void testPayloadCommand(void) {
+	HostFlash_Reset();
+	PayloadStore_Init();
+
+	TEST_CHECK_STR(testCommand("payload"), "0 Payloads, 0 Records, 0 of 32768 bytes used");
+	TEST_CHECK_STR(testCommand("upload clear"), "Upload Cleared");
+	TEST_CHECK_STR(testCommand("payload save 5"), "Upload Empty");
+	TEST_CHECK_STR(testCommand("upload hex 70 77 6e 00 52 46"), "Upload of 6 bytes");
+	TEST_CHECK_STR(testCommand("payload save 128"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("payload save 5"), "Payload 5 Saved, 6 bytes");
+	TEST_CHECK_STR(testCommand("payload 5"), "Payload 5: 6 bytes");
+	TEST_CHECK_STR(testCommand("payload 6"), "Unknown Payload");
+
+	TEST_CHECK_STR(testCommand("transmit #5"), "Successful Transmission");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwn\x00RF", 6));
+	TEST_CHECK_STR(testCommand("transmit #6"), "Unknown Payload");
+	TEST_CHECK_STR(testCommand("transmit #x"), "Unknown Payload");
+
+	TEST_CHECK_STR(testCommand("transmitContinuous 100 #5"), "Continuous Transmission Enabled");
+	TEST_CHECK_STR(testCommand("transmitContinuous 100 #9"), "Unknown Payload");
+	TEST_CHECK_STR(testCommand("transmitContinuous 0"), "Continuous Mode Stopped");
+
+	TEST_CHECK_STR(testCommand("payload delete 5"), "Payload Deleted");
+	TEST_CHECK_STR(testCommand("transmit #5"), "Unknown Payload");
+	TEST_CHECK_STR(testCommand("payload"), "0 Payloads, 2 Records, 24 of 32768 bytes used");
+	TEST_CHECK_STR(testCommand("payload erase"), "Payload Store Erased");
+	TEST_CHECK_STR(testCommand("payload"), "0 Payloads, 0 Records, 0 of 32768 bytes used");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testLog);
+	TEST_RUN(testTornRecord);
+	TEST_RUN(testFullAndErase);
+	TEST_RUN(testPayloadCommand);
+
+	return testResult();
+}
@@ -0,0 +1,132 @@
+/*
+ * test_radio.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * radio.c and radio_driver.c against the fake SUBGHZ: command sequence of a
+ * transmission and delivery of the radio interrupts
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "radio.h"
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: payload_integration() of radio.c as ST shipped it, bit at a time on an inverted copy */
+static void referenceIntegration(uint8_t *outBuffer, uint8_t *inBuffer, uint8_t size) {
+	uint8_t prevInt = 0;
+
+	for (int i = 0; i < size; i++) {
+		inBuffer[i] = ~inBuffer[i];
+		outBuffer[i] = 0;
+	}
+
+	for (int i = 0; i < size * 8; i++) {
+		uint8_t currBit = (inBuffer[i / 8] >> (7 - (i % 8))) & 0x01;
+		prevInt ^= currBit;
+		outBuffer[(i + 1) / 8] |= (prevInt << (7 - ((i + 1) % 8)));
+	}
+
+	outBuffer[size] = (prevInt << 7) | (prevInt << 6) | (((!prevInt) & 0x01) << 5);
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testSendSequence(void) {
+	uint32_t before = HostSubghz_CmdCount();
+
+	SubghzApp_Sent("pwnRF", 5);
+
+	int32_t params = HostSubghz_FindLastCmd(RADIO_SET_PACKETPARAMS);
+	int32_t tx = HostSubghz_FindLastCmd(RADIO_SET_TX);
+
+	/* The payload length is set, then the data is written and TX started */
+	TEST_CHECK(params >= (int32_t) before);
+	TEST_CHECK(tx > params);
+	TEST_CHECK(tx == (int32_t) HostSubghz_CmdCount() - 1);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwnRF", 5));
+
+	TEST_CHECK(Radio.GetStatus() == RF_TX_RUNNING);
+}
+
+static void testTxDone(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+
+	Host_SetVirtualTime(1);
+	SubghzApp_Sent("x", 1);
+	TEST_CHECK(Radio.GetStatus() == RF_TX_RUNNING);
+
+	/* The model ends the transmission after its time on air */
+	uint64_t airNs = SubghzModel_TimeOnAirNs(model, 1);
+	SubghzAir_Advance(airNs / 2);
+	TEST_CHECK(Radio.GetStatus() == RF_TX_RUNNING);
+	SubghzAir_Advance(airNs);
+	Host_SetVirtualTime(0);
+
+	/* OnTxDone ran and the IRQ status was cleared */
+	TEST_CHECK(Radio.GetStatus() == RF_IDLE);
+	TEST_CHECK(HostSubghz_FindLastCmd(RADIO_CLR_IRQSTATUS) >= 0);
+	TEST_CHECK(HostSubghz_FindLastCmd(RADIO_SET_STANDBY) > HostSubghz_FindLastCmd(RADIO_SET_TX));
+	TEST_CHECK(model->irqStatus == 0);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_RC);
+}
+
+static void testTxTimeout(void) {
+	SubghzApp_Sent("x", 1);
+
+	/* Injected, the TX timeout of the firmware is longer than the time on air */
+	HostSubghz_RaiseIrq(SUBGHZ_IT_RX_TX_TIMEOUT);
+
+	TEST_CHECK(Radio.GetStatus() == RF_IDLE);
+}
+
+static void testSigfoxIntegration(void) {
+	uint8_t payload[34], copy[34], expected[35];
+	uint32_t seed = 7;
+
+	Radio.SetTxConfig(MODEM_SIGFOX_TX, 14, 0, 0, 600, 0, 0, false, false, false, 0, false, 3000);
+
+	/* Every Sigfox payload size, the bytes written to the radio match bit for bit */
+	for (uint8_t size = 1; size <= sizeof(payload); size++) {
+		for (uint8_t i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			payload[i] = seed >> 16;
+		}
+		/* Both values of the parity carried into the end of frame byte */
+		payload[0] = size == 1 ? 0x00 : size == 2 ? 0xFF : payload[0];
+
+		memcpy(copy, payload, size);
+		memset(expected, 0, sizeof(expected));
+		referenceIntegration(expected, copy, size);
+
+		memcpy(copy, payload, size);
+		Radio.Send(payload, size);
+		TEST_CHECK(!memcmp(HostSubghz_Buffer(), expected, size + 1));
+
+		/* The caller's buffer is left alone */
+		TEST_CHECK(!memcmp(payload, copy, size));
+	}
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testSendSequence);
+	TEST_RUN(testTxDone);
+	TEST_RUN(testTxTimeout);
+	TEST_RUN(testSigfoxIntegration);
+
+	return testResult();
+}
@@ -0,0 +1,241 @@
+/*
+ * test_sim.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * The firmware under the scheduler, driven through the pseudo-terminal like a
+ * serial terminal would: echo, command responses, and transmissions from the
+ * CLI task and the timer daemon reaching the radio model.
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "usart.h"
+#include "subghz.h"
+#include "subghz_model.h"
+#include "cmsis_os.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define TEST_TIMEOUT_MS 5000
+
+/********************************
+ * Static Variables
+ ********************************/
+static const char *pty;
+static int fd;
+static char received[8192];
+static size_t receivedLen = 0;
+
+/********************************
+ * External Functions
+ ********************************/
+/* Core/Src/app_freertos.c */
+void MX_FREERTOS_Init(void);
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Reads from the terminal until expected arrives, 0 on timeout */
+static uint8_t waitFor(const char *expected) {
+	uint64_t deadline = Host_GetTimeNs() + TEST_TIMEOUT_MS * 1000000ULL;
+
+	while (strstr(received, expected) == NULL) {
+		uint64_t now = Host_GetTimeNs();
+		if (now >= deadline) {
+			return 0;
+		}
+
+		struct pollfd pfd = { .fd = fd, .events = POLLIN };
+		if (poll(&pfd, 1, (int) ((deadline - now) / 1000000ULL) + 1) <= 0) {
+			continue;
+		}
+
+		ssize_t len = read(fd, &received[receivedLen], sizeof(received) - receivedLen - 1);
+		if (len > 0) {
+			receivedLen += len;
+			received[receivedLen] = '\0';
+		}
+	}
+
+	return 1;
+}
+
+/* @brief: Types a command line and returns everything up to the next prompt */
+static const char *command(const char *line) {
+	receivedLen = 0;
+	received[0] = '\0';
+
+	(void) write(fd, line, strlen(line));
+	(void) write(fd, "\r\n", 2);
+
+	TEST_CHECK(waitFor("\r\n> "));
+
+	return received;
+}
+
+static void sleepMs(uint32_t ms) {
+	usleep(ms * 1000);
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testPrompt(void) {
+	/* The RAM budget is reported once at boot, before the first prompt */
+	TEST_CHECK(waitFor("> "));
+	TEST_CHECK_STR(received, "RAM budget (bytes)\r\n");
+	TEST_CHECK_STR(received, "  CLI      task ");
+	TEST_CHECK_STR(received, "  LATENCY  event ring ");
+	TEST_CHECK_STR(received, "  STATS    task snapshots ");
+	const char *ram2 = strstr(received, "\r\nRAM2 ");
+	TEST_CHECK(ram2 != NULL && ram2 < strstr(received, "> "));
+}
+
+static void testEcho(void) {
+	const char *response = command("freq");
+
+	/* The characters come back before the response */
+	TEST_CHECK_STR(response, "freq\r\n");
+	TEST_CHECK_STR(response, "Frequency = 433.000 MHz");
+}
+
+static void testTransmit(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	uint32_t before = radio->stats.txPackets;
+
+	const char *response = command("transmit hello");
+	TEST_CHECK_STR(response, "Successful Transmission");
+
+	/* 80 bits at 600 bps, then TX done */
+	sleepMs(500);
+	TEST_CHECK(radio->stats.txPackets == before + 1);
+	TEST_CHECK(radio->mode == SUBGHZ_MODEL_STDBY_RC);
+}
+
+static void testContinuous(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	uint32_t before = radio->stats.txPackets;
+
+	/* Sent by the timer daemon */
+	command("transmitContinuous 250 ping");
+	sleepMs(1100);
+	const char *response = command("transmitContinuous 0");
+	TEST_CHECK_STR(response, "Continuous Mode Stopped");
+	sleepMs(300);
+
+	uint32_t sent = radio->stats.txPackets - before;
+	TEST_CHECK(sent >= 3 && sent <= 5);
+}
+
+static void testBurst(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+	uint32_t before = radio->stats.txPackets;
+
+	/* The CLI task waits for the last TX done, the gaps are timed by the timer task */
+	const char *response = command("burst 3 20000 hello");
+	TEST_CHECK_STR(response, "Burst of 3 packets: ");
+	TEST_CHECK_STR(response, " packets/s");
+	TEST_CHECK(radio->stats.txPackets == before + 3);
+
+	const char *duration = strstr(response, "packets: ");
+	uint32_t airUs = SubghzModel_TimeOnAirNs(radio, 5) / 1000;
+	TEST_CHECK(duration != NULL && strtoul(duration + 9, NULL, 10) >= 3 * airUs + 2 * 20000);
+
+	/* Typing stops a long burst, the line then runs once the prompt is back */
+	receivedLen = 0;
+	received[0] = '\0';
+	(void) write(fd, "burst 1000 100000 hello\r\n", 25);
+	sleepMs(300);
+	(void) write(fd, "burst stop\r\n", 12);
+	TEST_CHECK(waitFor("No Burst\r\n> "));
+	TEST_CHECK_STR(received, "Burst Stopped after ");
+	TEST_CHECK(radio->stats.txPackets < before + 3 + 10);
+}
+
+static void testTimeline(void) {
+	SubghzModel_t *radio = HostSubghz_Model();
+
+	command("upload clear");
+	command("upload hex 70 77 6e 52 46");
+	TEST_CHECK_STR(command("payload save 3"), "Payload 3 Saved");
+	command("timeline clear");
+	command("timeline add 0 send 3");
+	command("timeline add 300 send 3");
+
+	/* Each deadline is a TIM2 compare, the daemon sends right after it */
+	uint32_t before = radio->stats.txPackets;
+	TEST_CHECK_STR(command("timeline run"), "Timeline Started");
+	sleepMs(700);
+	TEST_CHECK(radio->stats.txPackets == before + 2);
+
+	const char *response = command("timeline late");
+	TEST_CHECK_STR(response, "Entry 0: send, 1 runs, late ");
+	TEST_CHECK_STR(response, "Entry 1: send, 1 runs, late ");
+	TEST_CHECK_STR(command("timeline"), "Timeline Stopped, 2 Entries");
+}
+
+static void testBudget(void) {
+	const char *response = command("budget");
+
+	/* Modules initialised after the CLI task started are in it */
+	TEST_CHECK_STR(response, "RAM budget (bytes)\r\n");
+	TEST_CHECK_STR(response, "  TIMELINE entries ");
+	TEST_CHECK_STR(response, "\r\nRAM2 ");
+}
+
+/* @brief: Host thread playing the terminal, ends the process with the result */
+static void *client(void *arg) {
+	(void) arg;
+
+	fd = open(pty, O_RDWR | O_NOCTTY);
+	TEST_CHECK(fd >= 0);
+
+	TEST_RUN(testPrompt);
+	TEST_RUN(testEcho);
+	TEST_RUN(testTransmit);
+	TEST_RUN(testContinuous);
+	TEST_RUN(testBurst);
+	TEST_RUN(testTimeline);
+	TEST_RUN(testBudget);
+
+	fflush(stdout);
+	_exit(testResult());
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	pthread_t thread;
+
+	pty = HostUart_OpenPty(NULL);
+	if (pty == NULL) {
+		printf("SKIP no pseudo-terminal\n");
+		return 0;
+	}
+
+	pthread_create(&thread, NULL, client, NULL);
+
+	/* Same start-up as the simulator */
+	MX_USART2_UART_Init();
+	MX_SUBGHZ_Init();
+	HostSubghz_StartRealTime();
+
+	osKernelInitialize();
+	MX_FREERTOS_Init();
+	osKernelStart();
+
+	return 1;
+}
@@ -0,0 +1,234 @@
+/*
+ * test_standby.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Warm standby: the mode the radio falls back to after TX, the sleep after the
+ * idle timeout, the warm start sleep after every packet and the TX start latency
+ * and average current of each mode
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "radio.h"
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_MS 1000000ULL
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Sends a burst in virtual time, returns its duration in us */
+static uint32_t testBurst(uint32_t count) {
+	SubghzBurstStatus_t status;
+
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "warm", 4, count, 0));
+	do {
+		SubghzAir_Advance(NS_PER_MS);
+		SubghzApp_GetBurstStatus(&status);
+	} while (status.active);
+
+	TEST_CHECK(status.sent == count);
+
+	return status.duration;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testMeasure(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzStandbyLatency_t latency;
+
+	TEST_CHECK(SubghzApp_MeasureStandby(&latency));
+
+	/* STDBY_RC starts the TCXO and the XOSC before the PLL */
+	uint32_t tcxoUs = model->tcxoDelayNs / 1000;
+	TEST_CHECK(latency.startUs[SUBGHZ_STANDBY_RC] >= tcxoUs + 50);
+	TEST_CHECK(latency.startUs[SUBGHZ_STANDBY_XOSC] >= 40 && latency.startUs[SUBGHZ_STANDBY_XOSC] < 50);
+	TEST_CHECK(latency.startUs[SUBGHZ_STANDBY_FS] < 10);
+
+	/* A sleeping radio wakes in STDBY_RC, a warm start takes 340 us */
+	TEST_CHECK(latency.startUs[SUBGHZ_STANDBY_SLEEP] >= latency.startUs[SUBGHZ_STANDBY_RC] + 340);
+
+	/* Back in the current mode */
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_RC);
+}
+
+static void testFallback(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_XOSC, 0);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_XOSC && model->fallbackMode == 0x30);
+	testBurst(1);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_XOSC);
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_FS, 0);
+	testBurst(1);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_FS && model->fallbackMode == 0x40);
+
+	/* Never sleeps without an idle timeout */
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_FS);
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_RC, SUBGHZ_STANDBY_IDLE_MS);
+	testBurst(1);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_RC && model->fallbackMode == 0x20);
+}
+
+static void testSaved(void) {
+	SubghzStandbyLatency_t latency;
+
+	TEST_CHECK(SubghzApp_MeasureStandby(&latency));
+
+	/* Every packet but the first starts warm */
+	uint32_t cold = testBurst(5);
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_FS, 0);
+	uint32_t warm = testBurst(5);
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_RC, SUBGHZ_STANDBY_IDLE_MS);
+
+	uint32_t saved = latency.startUs[SUBGHZ_STANDBY_RC] - latency.startUs[SUBGHZ_STANDBY_FS];
+	TEST_CHECK(cold - warm >= 4 * saved);
+}
+
+static void testIdleSleep(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzStandbyLatency_t latency;
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_XOSC, 500);
+	testBurst(1);
+
+	/* The idle timer runs the sleep, the configuration is retained */
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_SLEEP && model->warmStart);
+
+	/* The next packet wakes the radio and it is warm again after it */
+	uint32_t before = model->stats.txPackets;
+	testBurst(1);
+	TEST_CHECK(model->stats.txPackets == before + 1);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_XOSC && model->fallbackMode == 0x30);
+
+	/* Busy on air */
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "x", 1, 1, 0));
+	TEST_CHECK(!SubghzApp_MeasureStandby(&latency));
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_TX);
+
+	/* The packet ends, the radio falls back to STDBY_XOSC */
+	do {
+		SubghzAir_Advance(NS_PER_MS);
+	} while (model->mode == SUBGHZ_MODEL_TX);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_XOSC);
+
+	/* Idle in the gap of a burst, the next packet is due */
+	SubghzBurstStatus_t status;
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "x", 1, 2, 1000));
+	do {
+		SubghzAir_Advance(NS_PER_MS);
+		SubghzApp_GetBurstStatus(&status);
+	} while (status.sent == 0);
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_XOSC);
+	SubghzApp_StopBurst();
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_SLEEP);
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_RC, SUBGHZ_STANDBY_IDLE_MS);
+}
+
+static void testSleep(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzStandbyLatency_t latency;
+
+	TEST_CHECK(SubghzApp_MeasureStandby(&latency));
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_SLEEP, SUBGHZ_STANDBY_IDLE_MS);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_SLEEP && model->warmStart && model->fallbackMode == 0x20);
+
+	/* The configuration is retained while the radio sleeps */
+	uint32_t freqReg = model->freqReg;
+	uint8_t modParams[sizeof(model->modParams)];
+	memcpy(modParams, model->modParams, sizeof(modParams));
+
+	/* Each packet wakes the radio, it sleeps again a tick after it was sent */
+	uint32_t before = model->stats.txPackets;
+	uint32_t duration = testBurst(2);
+	TEST_CHECK(model->stats.txPackets == before + 2);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_RC);
+	SubghzApp_IdleSleep();
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_SLEEP && model->warmStart);
+	TEST_CHECK(model->freqReg == freqReg && !memcmp(model->modParams, modParams, sizeof(modParams)));
+
+	/* Nothing but the wake and the start before each packet */
+	uint32_t airUs = SubghzModel_TimeOnAirNs(model, 4) / 1000;
+	TEST_CHECK(duration >= 2 * airUs + latency.startUs[SUBGHZ_STANDBY_SLEEP]);
+	TEST_CHECK(duration < 2 * (airUs + latency.startUs[SUBGHZ_STANDBY_SLEEP] + 200));
+
+	SubghzApp_SetStandby(SUBGHZ_STANDBY_RC, SUBGHZ_STANDBY_IDLE_MS);
+	TEST_CHECK(model->mode == SUBGHZ_MODEL_STDBY_RC);
+}
+
+static void testCurrent(void) {
+	SubghzStandbyLatency_t latency;
+
+	TEST_CHECK(SubghzApp_MeasureStandby(&latency));
+
+	/* A beacon every few seconds: the standby current dominates */
+	uint32_t rc = SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_RC, SUBGHZ_STANDBY_PERIOD_MS);
+	uint32_t xosc = SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_XOSC, SUBGHZ_STANDBY_PERIOD_MS);
+	uint32_t fs = SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_FS, SUBGHZ_STANDBY_PERIOD_MS);
+	uint32_t sleep = SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_SLEEP, SUBGHZ_STANDBY_PERIOD_MS);
+	TEST_CHECK(rc >= 600000 && rc < xosc && xosc < fs && fs == 2100000);
+	TEST_CHECK(sleep > 600 && sleep < rc / 100);
+
+	/* Packets back to back: the wake costs more than staying in STDBY_XOSC */
+	TEST_CHECK(SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_SLEEP, 1) > SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_XOSC, 1));
+	TEST_CHECK(SubghzApp_GetStandbyCurrent(&latency, SUBGHZ_STANDBY_SLEEP, 0) == 0);
+}
+
+static void testStandbyCommand(void) {
+	TEST_CHECK_STR(testCommand("standby"), "Standby STDBY_RC\r\n");
+	TEST_CHECK_STR(testCommand("standby hot"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("standby xosc"), "Standby Set to STDBY_XOSC");
+	TEST_CHECK_STR(testCommand("standby"), "Standby STDBY_XOSC, sleep after 1000 ms idle");
+	TEST_CHECK_STR(testCommand("standby fs 0"), "Standby Set to FS");
+	TEST_CHECK_STR(testCommand("standby"), "Standby FS, never sleeps");
+	TEST_CHECK_STR(testCommand("standby measure"), "TX start and average current, a packet every 5000 ms\r\nSTDBY_RC: ");
+	TEST_CHECK_STR(testCommand("standby measure 100"), "\r\n*FS: ");
+	TEST_CHECK_STR(testCommand("standby measure 100"), " uA\r\nSLEEP: ");
+	TEST_CHECK_STR(testCommand("standby measure 0"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("standby sleep"), "Standby Set to SLEEP");
+	TEST_CHECK_STR(testCommand("standby"), "Standby SLEEP\r\n");
+	TEST_CHECK_STR(testCommand("standby measure"), "*SLEEP: ");
+	TEST_CHECK_STR(testCommand("standby rc 1000"), "Standby Set to STDBY_RC");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	Host_SetVirtualTime(1);
+	SubghzApp_SetDatarate(50000);
+
+	TEST_RUN(testMeasure);
+	TEST_RUN(testFallback);
+	TEST_RUN(testSaved);
+	TEST_RUN(testIdleSleep);
+	TEST_RUN(testSleep);
+	TEST_RUN(testCurrent);
+	TEST_RUN(testStandbyCommand);
+
+	Host_SetVirtualTime(0);
+
+	return testResult();
+}
@@ -0,0 +1,152 @@
+/*
+ * test_stream.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Streaming TX: a packet longer than the radio buffer, refilled behind the
+ * packet engine, reaches the air as one gapless packet
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "radio.h"
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_MS 1000000ULL
+#define STREAM_SIZE 3000
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint8_t capture[4096];
+
+/********************************
+ * Helpers
+ ********************************/
+static uint8_t patternByte(uint32_t i) {
+	return (uint8_t) (i * 7 + (i >> 8));
+}
+
+static uint32_t patternFill(uint8_t *out, uint32_t size, void *context) {
+	uint32_t *offset = context;
+
+	for (uint32_t i = 0; i < size; i++) {
+		out[i] = patternByte((*offset)++);
+	}
+
+	return size;
+}
+
+static void captureStart(SubghzModel_t *model) {
+	model->txCapture = capture;
+	model->txCaptureSize = sizeof(capture);
+	model->txCaptureLen = 0;
+}
+
+/* @brief: Advances 1 ms at a time until the stream packet ended, refilling when refill is set */
+static void runStream(uint8_t refill) {
+	SubghzStreamStatus_t status;
+
+	for (uint32_t ms = 0; ms < 10000; ms++) {
+		SubghzAir_Advance(NS_PER_MS);
+		if (refill) {
+			SubghzApp_StreamRefill();
+		}
+
+		SubghzApp_GetStreamStatus(&status);
+		if (!status.active) {
+			return;
+		}
+	}
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testStream(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzStreamStatus_t status;
+	uint32_t offset = 0;
+
+	captureStart(model);
+	uint32_t packets = model->stats.txPackets;
+
+	TEST_CHECK(SubghzApp_StartStream(STREAM_SIZE, patternFill, &offset));
+	/* One stream at a time */
+	TEST_CHECK(!SubghzApp_StartStream(STREAM_SIZE, patternFill, &offset));
+	runStream(1);
+
+	SubghzApp_GetStreamStatus(&status);
+	TEST_CHECK(!status.active && !status.underrun);
+	TEST_CHECK(status.size == STREAM_SIZE && status.queued == STREAM_SIZE);
+
+	/* Every byte in order, in a single packet lasting the whole stream */
+	TEST_CHECK(model->stats.txPackets == packets + 1);
+	TEST_CHECK(model->txCaptureLen == STREAM_SIZE);
+	uint32_t mismatch = 0;
+	for (uint32_t i = 0; i < STREAM_SIZE; i++) {
+		mismatch += capture[i] != patternByte(i);
+	}
+	TEST_CHECK(mismatch == 0);
+	TEST_CHECK(Radio.GetStatus() == RF_IDLE);
+}
+
+static void testUnderrun(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+	SubghzStreamStatus_t status;
+	uint32_t offset = 0;
+
+	/* Nothing refills the buffer, the packet ends after the first bytes */
+	captureStart(model);
+	TEST_CHECK(SubghzApp_StartStream(1000, patternFill, &offset));
+	runStream(0);
+
+	SubghzApp_GetStreamStatus(&status);
+	TEST_CHECK(!status.active && status.underrun);
+	TEST_CHECK(status.queued == 255);
+	TEST_CHECK(model->txCaptureLen == 255);
+}
+
+static void testStreamCommand(void) {
+	SubghzModel_t *model = HostSubghz_Model();
+
+	TEST_CHECK_STR(testCommand("stream 0"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("stream 10 abc"), "Invalid Arguments");
+
+	captureStart(model);
+	TEST_CHECK_STR(testCommand("stream 600 a55a01"), "Streaming 600 bytes");
+	TEST_CHECK_STR(testCommand("stream 600"), "Stream Busy");
+	TEST_CHECK_STR(testCommand("stream"), "Stream On Air, 255 of 600 bytes queued");
+	runStream(1);
+
+	TEST_CHECK_STR(testCommand("stream"), "Stream Done, 600 of 600 bytes queued\r\n");
+	TEST_CHECK(model->txCaptureLen == 600);
+	TEST_CHECK(!memcmp(capture, "\xa5\x5a\x01\xa5\x5a\x01", 6));
+	TEST_CHECK(!memcmp(&capture[597], "\xa5\x5a\x01", 3));
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	Host_SetVirtualTime(1);
+	SubghzApp_SetDatarate(50000);
+
+	TEST_RUN(testStream);
+	TEST_RUN(testUnderrun);
+	TEST_RUN(testStreamCommand);
+
+	Host_SetVirtualTime(0);
+
+	return testResult();
+}
@@ -0,0 +1,222 @@
+/*
+ * test_subghz_model.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * SUBGHZ model: time on air, BUSY timing and packets exchanged over the air
+ * between the firmware radio and a second instance
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "radio.h"
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_MS 1000000ULL
+
+/********************************
+ * Static Variables
+ ********************************/
+static SubghzModel_t peer;
+static uint32_t peerIrqs = 0;
+
+/********************************
+ * Helpers
+ ********************************/
+static void peerIrq(SubghzModel_t *model) {
+	peerIrqs++;
+}
+
+static void setCmd(SubghzModel_t *model, uint8_t opcode, const uint8_t *params, uint16_t size) {
+	SubghzModel_SetCmd(model, opcode, params, size);
+	SubghzModel_WaitBusy(model);
+}
+
+/* @brief: Configures the peer for the packets the firmware sends, with this payload length */
+static void peerListen(uint8_t payloadLength, uint32_t timeout) {
+	SubghzModel_t *dut = HostSubghz_Model();
+	uint8_t freq[4] = {dut->freqReg >> 24, dut->freqReg >> 16, dut->freqReg >> 8, dut->freqReg};
+	uint8_t pkt[9];
+	uint8_t irq[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+	uint8_t rx[3] = {timeout >> 16, timeout >> 8, timeout};
+
+	memcpy(pkt, dut->pktParams, sizeof(pkt));
+	pkt[6] = payloadLength;
+
+	setCmd(&peer, RADIO_SET_PACKETTYPE, &dut->packetType, 1);
+	setCmd(&peer, RADIO_SET_RFFREQUENCY, freq, sizeof(freq));
+	setCmd(&peer, RADIO_SET_MODULATIONPARAMS, dut->modParams, sizeof(dut->modParams));
+	setCmd(&peer, RADIO_SET_PACKETPARAMS, pkt, sizeof(pkt));
+	SubghzModel_WriteRegisters(&peer, 0x06C0, &dut->registers[0x06C0], 8);
+	setCmd(&peer, RADIO_CFG_DIOIRQ, irq, sizeof(irq));
+	setCmd(&peer, RADIO_SET_RX, rx, sizeof(rx));
+}
+
+/* @brief: Sends from the firmware and lets the air run past the end of the packet */
+static void sendAndWait(char *msg, uint8_t size) {
+	SubghzModel_t *dut = HostSubghz_Model();
+
+	SubghzApp_Sent(msg, size);
+	TEST_CHECK(dut->opEnd > Host_GetTimeNs());
+	SubghzAir_Advance(dut->opEnd - Host_GetTimeNs() + NS_PER_MS);
+}
+
+static uint16_t peerIrqStatus(void) {
+	uint8_t status[2];
+
+	SubghzModel_GetCmd(&peer, RADIO_GET_IRQSTATUS, status, sizeof(status));
+	return ((uint16_t) status[0] << 8) | status[1];
+}
+
+static void peerClearIrq(void) {
+	uint8_t all[2] = {0xFF, 0xFF};
+
+	SubghzModel_SetCmd(&peer, RADIO_CLR_IRQSTATUS, all, sizeof(all));
+	peerIrqs = 0;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testTimeOnAir(void) {
+	SubghzModel_t model = {0};
+	SubghzModel_Init(&model, "toa");
+
+	/* GFSK 600 bps, 40 bit preamble, 16 bit sync, length byte, 2 byte CRC: 160 bits */
+	uint8_t gfskMod[8] = {0x1A, 0x0A, 0xAA, 0x00, 0x1A, 0x00, 0x0A, 0x3D};
+	uint8_t gfskPkt[9] = {0x00, 40, 0x04, 16, 0x00, 0x01, 10, 0x02, 0x00};
+	SubghzModel_SetCmd(&model, RADIO_SET_MODULATIONPARAMS, gfskMod, sizeof(gfskMod));
+	SubghzModel_SetCmd(&model, RADIO_SET_PACKETPARAMS, gfskPkt, sizeof(gfskPkt));
+	uint64_t toa = SubghzModel_TimeOnAirNs(&model, 10);
+	TEST_CHECK(toa > 266 * NS_PER_MS && toa < 267 * NS_PER_MS);
+
+	/* LoRa SF7 125 kHz 4/5, 8 symbol preamble, explicit header, CRC, 10 bytes: 41.216 ms */
+	uint8_t lora = SUBGHZ_MODEL_PACKET_LORA;
+	uint8_t loraMod[4] = {7, 0x04, 0x01, 0x00};
+	uint8_t loraPkt[6] = {0x00, 8, 0x00, 10, 0x01, 0x00};
+	SubghzModel_SetCmd(&model, RADIO_SET_PACKETTYPE, &lora, 1);
+	SubghzModel_SetCmd(&model, RADIO_SET_MODULATIONPARAMS, loraMod, sizeof(loraMod));
+	SubghzModel_SetCmd(&model, RADIO_SET_PACKETPARAMS, loraPkt, sizeof(loraPkt));
+	toa = SubghzModel_TimeOnAirNs(&model, 10);
+	TEST_CHECK(toa > 41200000ULL && toa < 41230000ULL);
+}
+
+static void testBusy(void) {
+	SubghzModel_t model = {0};
+	SubghzModel_Init(&model, "busy");
+	SubghzModel_WaitBusy(&model);
+
+	/* STDBY_RC to TX holds BUSY high for the switching time */
+	uint8_t timeout[3] = {0};
+	uint64_t start = Host_GetTimeNs();
+	SubghzModel_SetCmd(&model, RADIO_SET_TX, timeout, sizeof(timeout));
+	TEST_CHECK(SubghzModel_IsBusy(&model));
+	TEST_CHECK(model.mode == SUBGHZ_MODEL_TX);
+	SubghzModel_WaitBusy(&model);
+	TEST_CHECK(Host_GetTimeNs() - start == 126000);
+
+	/* A warm start wakes up faster than a cold one and keeps the configuration */
+	uint8_t warm = 0x04;
+	uint8_t sync[2] = {0x12, 0x34};
+	uint8_t read[2];
+	SubghzModel_WriteRegisters(&model, 0x06C0, sync, sizeof(sync));
+	SubghzModel_SetCmd(&model, RADIO_SET_SLEEP, &warm, 1);
+	TEST_CHECK(model.mode == SUBGHZ_MODEL_SLEEP);
+	start = Host_GetTimeNs();
+	SubghzModel_ReadRegisters(&model, 0x06C0, read, sizeof(read));
+	TEST_CHECK(Host_GetTimeNs() - start == 340000);
+	TEST_CHECK(!memcmp(read, sync, sizeof(sync)));
+	TEST_CHECK(model.mode == SUBGHZ_MODEL_STDBY_RC);
+
+	uint8_t cold = 0x00;
+	SubghzModel_SetCmd(&model, RADIO_SET_SLEEP, &cold, 1);
+	start = Host_GetTimeNs();
+	SubghzModel_ReadRegisters(&model, 0x06C0, read, sizeof(read));
+	TEST_CHECK(Host_GetTimeNs() - start == 3500000);
+	TEST_CHECK(read[0] == 0 && read[1] == 0);
+}
+
+static void testDelivery(void) {
+	TEST_CHECK_STR(testCommand("syncword 2 AB"), "Syncword Set Successfully");
+	peerListen(5, 0);
+	peerClearIrq();
+
+	sendAndWait("pwnRF", 5);
+
+	/* The firmware saw TX done and the peer got the packet */
+	TEST_CHECK(Radio.GetStatus() == RF_IDLE);
+	TEST_CHECK(peerIrqs == 1);
+	TEST_CHECK(peerIrqStatus() == (SUBGHZ_IT_PREAMBLE_DETECTED | SUBGHZ_IT_SYNCWORD_VALID | SUBGHZ_IT_RX_CPLT));
+	TEST_CHECK(peer.mode == SUBGHZ_MODEL_STDBY_RC);
+
+	uint8_t status[2];
+	uint8_t payload[5];
+	SubghzModel_GetCmd(&peer, RADIO_GET_RXBUFFERSTATUS, status, sizeof(status));
+	SubghzModel_ReadBuffer(&peer, status[1], payload, status[0]);
+	TEST_CHECK(status[0] == 5);
+	TEST_CHECK(!memcmp(payload, "pwnRF", 5));
+}
+
+static void testContinuousRx(void) {
+	peerListen(1, SUBGHZ_MODEL_RX_CONTINUOUS);
+	peerClearIrq();
+
+	for (uint8_t i = 0; i < 3; i++) {
+		sendAndWait("x", 1);
+	}
+
+	TEST_CHECK(peerIrqs == 3);
+	TEST_CHECK(peer.mode == SUBGHZ_MODEL_RX);
+}
+
+static void testMismatch(void) {
+	/* Different sync word: nothing is received and the RX timeout fires */
+	peerListen(5, 64000);		/* 1 s */
+	peer.registers[0x06C0] ^= 0xFF;
+	peerClearIrq();
+
+	sendAndWait("pwnRF", 5);
+	TEST_CHECK(peerIrqs == 0);
+	TEST_CHECK(peer.mode == SUBGHZ_MODEL_RX);
+
+	SubghzAir_Advance(1000 * NS_PER_MS);
+	TEST_CHECK(peerIrqStatus() == SUBGHZ_IT_RX_TX_TIMEOUT);
+	TEST_CHECK(peer.mode == SUBGHZ_MODEL_STDBY_RC);
+
+	/* Different frequency */
+	peerListen(5, 0);
+	peer.freqReg++;
+	peerClearIrq();
+
+	sendAndWait("pwnRF", 5);
+	TEST_CHECK(peerIrqs == 0);
+	TEST_CHECK(Radio.GetStatus() == RF_IDLE);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	Host_SetVirtualTime(1);
+	testBoot();
+
+	peer.irqHandler = peerIrq;
+	SubghzModel_Init(&peer, "peer");
+	SubghzAir_Attach(&peer);
+
+	TEST_RUN(testTimeOnAir);
+	TEST_RUN(testBusy);
+	TEST_RUN(testDelivery);
+	TEST_RUN(testContinuousRx);
+	TEST_RUN(testMismatch);
+
+	return testResult();
+}
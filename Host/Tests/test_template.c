@@ -0,0 +1,139 @@
+/*
+ * test_template.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Payload templates: compiling the fields, evaluating packets one after the
+ * other and the `template` command reaching the radio
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "Template/template.h"
+
+/********************************
+ * Tests
+ ********************************/
+static void testFields(void) {
+	static TemplateProgram_t program;
+	TemplateState_t state;
+	uint8_t out[TEMPLATE_MAX_PAYLOAD];
+
+	TEST_CHECK(Template_Compile(&program, "0xa55a len 'hi seq16:0x100:2 seq8le time32 sum8:2 xor8"));
+	TEST_CHECK(program.size == 14);
+	/* Literals and the length are in the image, not ops */
+	TEST_CHECK(program.opCount == 5);
+	Template_Reset(&program, &state, 0);
+
+	const uint8_t first[] = { 0xA5, 0x5A, 14, 'h', 'i', 0x01, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78 };
+	TEST_CHECK(Template_Evaluate(&program, &state, 0x12345678, out) == 14);
+	TEST_CHECK(!memcmp(out, first, sizeof(first)));
+
+	uint8_t sum = 0, xor = 0;
+	for (uint8_t i = 0; i < 12; i++) {
+		sum += i >= 2 ? out[i] : 0;
+		xor ^= out[i];
+	}
+	TEST_CHECK(out[12] == sum);
+	TEST_CHECK(out[13] == (uint8_t) (xor ^ sum));
+
+	/* Counters advance by their step once per packet */
+	Template_Evaluate(&program, &state, 0, out);
+	TEST_CHECK(out[5] == 0x01 && out[6] == 0x02 && out[7] == 0x01);
+	TEST_CHECK(state.packets == 2);
+
+	Template_Reset(&program, &state, 0);
+	Template_Evaluate(&program, &state, 0, out);
+	TEST_CHECK(out[5] == 0x01 && out[6] == 0x00 && out[7] == 0x00);
+
+	/* Little endian and wrap around */
+	TEST_CHECK(Template_Compile(&program, "seq16le:0xfffe sum16le"));
+	Template_Reset(&program, &state, 0);
+	Template_Evaluate(&program, &state, 0, out);
+	TEST_CHECK(out[0] == 0xFE && out[1] == 0xFF && out[2] == 0xFD && out[3] == 0x01);
+	Template_Evaluate(&program, &state, 0, out);
+	Template_Evaluate(&program, &state, 0, out);
+	TEST_CHECK(out[0] == 0x00 && out[1] == 0x00);
+}
+
+static void testRandom(void) {
+	static TemplateProgram_t program;
+	TemplateState_t state, again;
+	uint8_t a[TEMPLATE_MAX_PAYLOAD], b[TEMPLATE_MAX_PAYLOAD];
+
+	TEST_CHECK(Template_Compile(&program, "'R rand6"));
+
+	/* The same seed gives the same packets, successive packets differ */
+	Template_Reset(&program, &state, 1234);
+	Template_Reset(&program, &again, 1234);
+	Template_Evaluate(&program, &state, 0, a);
+	Template_Evaluate(&program, &again, 0, b);
+	TEST_CHECK(!memcmp(a, b, 7));
+	Template_Evaluate(&program, &state, 0, b);
+	TEST_CHECK(a[0] == 'R' && b[0] == 'R' && memcmp(&a[1], &b[1], 6));
+}
+
+static void testInvalid(void) {
+	static TemplateProgram_t program;
+	const char *invalid[] = {
+		"", "seq12", "seq40", "0xabc", "0xzz", "'", "time8", "rand0", "rand65",
+		"sum8", "0x01 sum8:1", "0x01 xor16", "seq8:1:2:3", "seq8 seq8 seq8 seq8 seq8", "foo",
+	};
+
+	for (uint32_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		if (Template_Compile(&program, invalid[i])) {
+			fprintf(stderr, "accepted \"%s\"\n", invalid[i]);
+			testFailures++;
+		}
+	}
+
+	/* The payload limit counts every field */
+	TEST_CHECK(Template_Compile(&program, "rand32 rand32"));
+	TEST_CHECK(!Template_Compile(&program, "rand32 rand32 len"));
+}
+
+static void testTemplateCommand(void) {
+	TEST_CHECK_STR(testCommand("template"), "Template Off");
+	TEST_CHECK_STR(testCommand("template send"), "Template Off");
+	TEST_CHECK_STR(testCommand("template 0x01 seq"), "Invalid Template");
+	TEST_CHECK_STR(testCommand("template 'pwn seq8:7 len xor8"), "Template Set Successfully, 6 bytes");
+
+	TEST_CHECK_STR(testCommand("template send"), "Successful Transmission");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwn\x07\x06", 5));
+	TEST_CHECK_STR(testCommand("template send"), "Successful Transmission");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwn\x08\x06", 5));
+	TEST_CHECK(HostSubghz_Buffer()[5] == ('p' ^ 'w' ^ 'n' ^ 0x08 ^ 0x06));
+
+	TEST_CHECK_STR(testCommand("template"), "Template of 6 bytes, 2 fields, 2 packets");
+	TEST_CHECK_STR(testCommand("template start 0"), "Invalid Arguments");
+
+	/* Seeding receives, which must not cut a burst short. It waits for the packet on air. */
+	HostSubghz_RaiseIrq(SUBGHZ_IT_TX_CPLT);
+	TEST_CHECK(SubghzApp_StartBurst((const uint8_t *) "x", 1, 1, 0));
+	TEST_CHECK_STR(testCommand("template start 100"), "Radio Busy");
+	HostSubghz_RaiseIrq(SUBGHZ_IT_TX_CPLT);
+	TEST_CHECK_STR(testCommand("template start 100"), "Continuous Transmission Enabled");
+	SubghzApp_StopContinuous();
+
+	TEST_CHECK_STR(testCommand("template off"), "Template Off");
+	TEST_CHECK_STR(testCommand("template start 100"), "Template Off");
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testFields);
+	TEST_RUN(testRandom);
+	TEST_RUN(testInvalid);
+	TEST_RUN(testTemplateCommand);
+
+	return testResult();
+}
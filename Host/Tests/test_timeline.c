@@ -0,0 +1,279 @@
+/*
+ * test_timeline.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Timeline sequencer: entries due at their offsets, loops, RX waits moving the
+ * entries after them, the lateness of each entry, the dry run and the timeline
+ * run by the application on its TIM2 clock
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "radio_driver.h"
+#include "Timeline/timeline.h"
+#include "PayloadStore/payload_store.h"
+
+#include "subghz_model.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define NS_PER_MS 1000000ULL
+
+/********************************
+ * Helpers
+ ********************************/
+/* @brief: Payload ID ms on air */
+static uint32_t testAirtime(uint32_t id) {
+	return id;
+}
+
+/* @brief: Action of the entry due at now, TIMELINE_ACTIONS for none */
+static uint32_t testNext(uint32_t now, uint32_t *wait) {
+	const TimelineEntry_t *entry = Timeline_Next(now, wait);
+
+	return entry != NULL ? entry->action : TIMELINE_ACTIONS;
+}
+
+static uint32_t testCmds(uint8_t opcode) {
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < HostSubghz_CmdCount(); i++) {
+		count += HostSubghz_Cmd(i)->opcode == opcode;
+	}
+
+	return count;
+}
+
+/********************************
+ * Tests
+ ********************************/
+static void testEntries(void) {
+	TimelineStatus_t status;
+	uint32_t wait;
+
+	TEST_CHECK(sizeof(TimelineEntry_t) == 8);
+
+	Timeline_Clear();
+	TEST_CHECK(!Timeline_Start(0));
+	TEST_CHECK(Timeline_Add(0, TIMELINE_FREQ, 868000000));
+	TEST_CHECK(Timeline_Add(10, TIMELINE_SEND, 1));
+	TEST_CHECK(Timeline_Add(10, TIMELINE_POWER, 14));
+	TEST_CHECK(!Timeline_Add(5, TIMELINE_SEND, 1));
+	TEST_CHECK(!Timeline_Add(TIMELINE_MAX_OFFSET + 1, TIMELINE_SEND, 1));
+	TEST_CHECK(!Timeline_Add(20, TIMELINE_ACTIONS, 0));
+	TEST_CHECK(Timeline_Add(30, TIMELINE_LOOP, 2));
+	TEST_CHECK(!Timeline_Add(40, TIMELINE_SEND, 1));
+	TEST_CHECK(Timeline_Count() == 4);
+
+	/* Entries due together run one after the other */
+	TEST_CHECK(Timeline_Start(1000));
+	TEST_CHECK(testNext(1000, &wait) == TIMELINE_FREQ);
+	TEST_CHECK(testNext(1000, &wait) == TIMELINE_ACTIONS && wait == 10);
+	TEST_CHECK(testNext(1012, &wait) == TIMELINE_SEND);
+	TEST_CHECK(testNext(1012, &wait) == TIMELINE_POWER);
+	TEST_CHECK(testNext(1012, &wait) == TIMELINE_ACTIONS && wait == 18);
+
+	/* A late entry does not move the next iteration */
+	TEST_CHECK(testNext(1030, &wait) == TIMELINE_FREQ);
+	TEST_CHECK(testNext(1030, &wait) == TIMELINE_ACTIONS && wait == 10);
+	Timeline_GetStatus(&status);
+	TEST_CHECK(status.running && status.iteration == 1 && status.index == 1 && status.lateMax == 2);
+
+	TEST_CHECK(testNext(1040, &wait) == TIMELINE_SEND);
+	TEST_CHECK(testNext(1040, &wait) == TIMELINE_POWER);
+
+	/* The second iteration was the last */
+	TEST_CHECK(testNext(1060, &wait) == TIMELINE_ACTIONS && wait == TIMELINE_NO_DEADLINE);
+	Timeline_GetStatus(&status);
+	TEST_CHECK(!status.running && status.iteration == 2);
+
+	/* Each entry ran twice, the send 2 ms late in the first iteration */
+	const TimelineLate_t *late = Timeline_GetLate(1);
+	TEST_CHECK(late->runs == 2 && late->lateLast == 0 && late->lateMax == 2 && late->lateSum == 2);
+	TEST_CHECK(Timeline_GetLate(0)->runs == 2 && Timeline_GetLate(3)->runs == 2);
+	TEST_CHECK(Timeline_GetLate(4) == NULL && Timeline_Get(4) == NULL);
+	TEST_CHECK(Timeline_Get(2)->action == TIMELINE_POWER);
+
+	/* A loop needs time to pass */
+	Timeline_Clear();
+	TEST_CHECK(!Timeline_Add(0, TIMELINE_LOOP, 0));
+	for (uint32_t i = 0; i < TIMELINE_MAX_ENTRIES; i++) {
+		TEST_CHECK(Timeline_Add(i, TIMELINE_POWER, 10));
+	}
+	TEST_CHECK(!Timeline_Add(TIMELINE_MAX_ENTRIES, TIMELINE_POWER, 10));
+}
+
+static void testRx(void) {
+	uint32_t wait;
+
+	Timeline_Clear();
+	Timeline_Add(0, TIMELINE_RX, 100);
+	Timeline_Add(10, TIMELINE_SEND, 1);
+	Timeline_Add(50, TIMELINE_LOOP, 0);
+
+	/* A packet after 30 ms, the entries after the RX move by 30 ms */
+	Timeline_Start(UINT32_MAX - 10);
+	TEST_CHECK(testNext(UINT32_MAX - 10, &wait) == TIMELINE_RX && wait == 100);
+	TEST_CHECK(testNext(UINT32_MAX, &wait) == TIMELINE_ACTIONS && wait == 90);
+	TEST_CHECK(!Timeline_RxExpired(UINT32_MAX));
+	TEST_CHECK(Timeline_RxDone(19));
+	TEST_CHECK(!Timeline_RxDone(19));
+	TEST_CHECK(testNext(19, &wait) == TIMELINE_ACTIONS && wait == 10);
+	TEST_CHECK(testNext(29, &wait) == TIMELINE_SEND);
+
+	/* Nothing received, the wait ends at the timeout */
+	TEST_CHECK(testNext(69, &wait) == TIMELINE_RX);
+	TEST_CHECK(!Timeline_RxExpired(168));
+	TEST_CHECK(Timeline_RxExpired(169));
+	TEST_CHECK(Timeline_RxDone(169));
+	TEST_CHECK(testNext(179, &wait) == TIMELINE_SEND);
+
+	Timeline_Stop();
+	TEST_CHECK(!Timeline_RxDone(200));
+}
+
+static void testDryRun(void) {
+	TimelineDryRun_t result;
+
+	Timeline_Clear();
+	Timeline_Add(0, TIMELINE_SEND, 20);
+	Timeline_Add(10, TIMELINE_SEND, 5);
+	Timeline_Add(40, TIMELINE_RX, 100);
+	Timeline_Add(50, TIMELINE_SEND, 30);
+
+	/* The second packet starts with the first still on air */
+	Timeline_DryRun(testAirtime, &result);
+	TEST_CHECK(result.duration == 180 && result.airtime == 55 && result.packets == 3);
+	TEST_CHECK(result.overlaps == 1 && !result.forever);
+
+	Timeline_Add(200, TIMELINE_LOOP, 3);
+	Timeline_DryRun(testAirtime, &result);
+	TEST_CHECK(result.duration == 900 && result.airtime == 165 && result.packets == 9 && result.overlaps == 3);
+
+	Timeline_Clear();
+	Timeline_Add(0, TIMELINE_SEND, 20);
+	Timeline_Add(100, TIMELINE_LOOP, 0);
+	Timeline_DryRun(testAirtime, &result);
+	TEST_CHECK(result.duration == 100 && result.airtime == 20 && result.forever);
+}
+
+static void testTimelineCommand(void) {
+	HostFlash_Reset();
+	PayloadStore_Init();
+	TEST_CHECK_STR(testCommand("upload clear"), "Upload Cleared");
+	TEST_CHECK_STR(testCommand("upload hex 70 77 6e 52 46"), "Upload of 5 bytes");
+	TEST_CHECK_STR(testCommand("payload save 3"), "Payload 3 Saved");
+
+	TEST_CHECK_STR(testCommand("timeline clear"), "Timeline Cleared");
+	TEST_CHECK_STR(testCommand("timeline run"), "Timeline Empty");
+	TEST_CHECK_STR(testCommand("timeline add 0 freq 12"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline add 0 jump 1"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline add 0 send"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline add 0 power 23"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline add 0 freq 868000000"), "Entry 0 Added");
+	TEST_CHECK_STR(testCommand("timeline add 0 send 3"), "Entry 1 Added");
+	TEST_CHECK_STR(testCommand("timeline add 100 rx 500"), "Entry 2 Added");
+	TEST_CHECK_STR(testCommand("timeline add 50 send 3"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline add 110 send 3"), "Entry 3 Added");
+	TEST_CHECK_STR(testCommand("timeline add 1000 loop"), "Entry 4 Added");
+	TEST_CHECK_STR(testCommand("timeline add 1100 send 3"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("timeline"), "Timeline Stopped, 5 Entries");
+
+	/* The RX waits 500 ms, 174 ms on air for 5 bytes at 600 bps */
+	TEST_CHECK_STR(testCommand("timeline dry"), "5 Entries: 1500 ms, 348 ms on air, 2 packets, 0 overlaps per iteration, loops forever");
+
+	TEST_CHECK_STR(testCommand("timeline run"), "Timeline Started");
+	TEST_CHECK_STR(testCommand("timeline"), "Timeline Running, entry 0 of 5");
+	TEST_CHECK_STR(testCommand("timeline stop"), "Timeline Stopped");
+	TEST_CHECK(HostUsTimer_NextEventNs() == 0);
+
+	/* Run by hand, the timer daemon does not run here */
+	uint32_t now = 5000;
+	Timeline_Start(now);
+	HostSubghz_ClearLog();
+	TEST_CHECK(SubghzApp_RunTimeline(now) == 100);
+	TEST_CHECK(SubghzApp_GetFreq() == 868000000);
+	TEST_CHECK(testCmds(RADIO_SET_TX) == 1);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwnRF", 5));
+
+	/* Listening without a radio timeout */
+	HostSubghz_ClearLog();
+	TEST_CHECK(SubghzApp_RunTimeline(now + 100) == 500);
+	TEST_CHECK(testCmds(RADIO_SET_RX) == 1);
+	TEST_CHECK(SubghzApp_RunTimeline(now + 300) == 300);
+
+	/* Nothing received, standby at the timeout, the next entry 10 ms later */
+	HostSubghz_ClearLog();
+	TEST_CHECK(SubghzApp_RunTimeline(now + 600) == 10);
+	TEST_CHECK(testCmds(RADIO_SET_STANDBY) == 1 && testCmds(RADIO_SET_TX) == 0);
+	TEST_CHECK(SubghzApp_RunTimeline(now + 610) == 890);
+
+	/* Back to the TX packet parameters */
+	TEST_CHECK(testCmds(RADIO_SET_TX) == 1 && testCmds(RADIO_SET_PACKETPARAMS) >= 1);
+
+	/* One line per entry, the loop not reached yet */
+	TEST_CHECK_STR(testCommand("timeline late"), "Entry 0: freq, 1 runs, late 0/0/0 ms\r\n"
+			"Entry 1: send, 1 runs, late 0/0/0 ms\r\nEntry 2: rx, 1 runs, late 0/0/0 ms\r\n"
+			"Entry 3: send, 1 runs, late 0/0/0 ms\r\nEntry 4: loop, 0 runs, late 0/0/0 ms");
+
+	TEST_CHECK_STR(testCommand("timeline clear"), "Timeline Cleared");
+	TEST_CHECK_STR(testCommand("timeline"), "Timeline Stopped, 0 Entries");
+}
+
+static void testRxDone(void) {
+	HostFlash_Reset();
+	PayloadStore_Init();
+	PayloadStore_Add(1, (const uint8_t *) "ack", 3);
+
+	Timeline_Clear();
+	Timeline_Add(0, TIMELINE_RX, 1000);
+	Timeline_Add(20, TIMELINE_SEND, 1);
+
+	/* The clock of the timeline starts at 0 and counts on TIM2 */
+	Host_SetVirtualTime(1);
+	SubghzModel_WaitBusy(HostSubghz_Model());
+	uint64_t start = Host_GetTimeNs();
+	TEST_CHECK(SubghzApp_StartTimeline());
+	TEST_CHECK(HostUsTimer_NextEventNs() == start);
+	SubghzApp_RunTimeline(0);
+
+	/* A packet 7 ms later ends the wait from the radio interrupt */
+	Host_SetTimeNs(Host_GetTimeNs() + 7 * NS_PER_MS);
+	HostSubghz_RaiseIrq(SUBGHZ_IT_RX_CPLT);
+
+	TimelineStatus_t status;
+	Timeline_GetStatus(&status);
+	TEST_CHECK(status.running && !status.waitingRx && status.index == 1);
+
+	/* The send follows 20 ms after the packet, on the TIM2 clock */
+	uint32_t now = (Host_GetTimeNs() - start) / NS_PER_MS;
+	uint32_t wait = SubghzApp_RunTimeline(now);
+	TEST_CHECK(wait > 0 && wait <= 20);
+	SubghzApp_RunTimeline(now + wait);
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "ack", 3));
+
+	SubghzApp_StopTimeline();
+	Host_SetVirtualTime(0);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testEntries);
+	TEST_RUN(testRx);
+	TEST_RUN(testDryRun);
+	TEST_RUN(testTimelineCommand);
+	TEST_RUN(testRxDone);
+
+	return testResult();
+}
@@ -0,0 +1,143 @@
+/*
+ * test_upload.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Binary payload upload: hex, base64 and raw decoding into the payload buffer
+ * and full size payloads with spaces and zero bytes reaching the radio
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "test.h"
+
+#include "subghz_phy_app.h"
+#include "subghz_model.h"
+#include "Upload/upload.h"
+
+/********************************
+ * Tests
+ ********************************/
+static void testHex(void) {
+	Upload_Clear();
+
+	TEST_CHECK(Upload_AppendHex("00ff 7E", 7) == 3);
+	TEST_CHECK(Upload_AppendHex("a5", 2) == 1);
+	TEST_CHECK(Upload_GetSize() == 4);
+	TEST_CHECK(!memcmp(Upload_GetData(), "\x00\xff\x7e\xa5", 4));
+
+	/* Nothing is appended from an invalid line */
+	TEST_CHECK(Upload_AppendHex("01 2", 4) == 0);
+	TEST_CHECK(Upload_AppendHex("0g", 2) == 0);
+	TEST_CHECK(Upload_AppendHex("0 1", 3) == 0);
+	TEST_CHECK(Upload_GetSize() == 4);
+
+	/* Up to the largest payload */
+	char line[2 * UPLOAD_MAX_PAYLOAD];
+	memset(line, 'e', sizeof(line));
+	Upload_Clear();
+	TEST_CHECK(Upload_AppendHex(line, sizeof(line)) == UPLOAD_MAX_PAYLOAD);
+	TEST_CHECK(Upload_AppendHex("00", 2) == 0);
+	TEST_CHECK(Upload_GetSize() == UPLOAD_MAX_PAYLOAD);
+}
+
+static void testBase64(void) {
+	Upload_Clear();
+
+	TEST_CHECK(Upload_AppendBase64("cHduUkY=", 8) == 5);
+	TEST_CHECK(Upload_AppendBase64("AP8=", 4) == 2);
+	TEST_CHECK(Upload_AppendBase64("+/8A AA==", 9) == 4);
+	TEST_CHECK(Upload_GetSize() == 11);
+	TEST_CHECK(!memcmp(Upload_GetData(), "pwnRF\x00\xff\xfb\xff\x00\x00", 11));
+
+	const char *invalid[] = { "cHdu=", "cHd", "A===", "AA=A", "AA==AAAA", "cH*u", "" };
+	for (uint32_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		if (Upload_AppendBase64(invalid[i], strlen(invalid[i])) != 0) {
+			fprintf(stderr, "accepted \"%s\"\n", invalid[i]);
+			testFailures++;
+		}
+	}
+	TEST_CHECK(Upload_GetSize() == 11);
+}
+
+static void testRaw(void) {
+	Upload_AppendHex("01", 2);
+
+	TEST_CHECK(!Upload_StartRaw(0, 0));
+	TEST_CHECK(!Upload_StartRaw(UPLOAD_MAX_PAYLOAD + 1, 0));
+
+	/* Any byte value, line endings included */
+	TEST_CHECK(Upload_StartRaw(4, 100));
+	TEST_CHECK(Upload_GetSize() == 0);
+	TEST_CHECK(Upload_RawByte('\r', 100) == UPLOAD_RAW_MORE);
+	TEST_CHECK(Upload_RawByte('\n', 200) == UPLOAD_RAW_MORE);
+	TEST_CHECK(Upload_RawByte(0x00, 300) == UPLOAD_RAW_MORE);
+	TEST_CHECK(Upload_RawByte('\b', 400) == UPLOAD_RAW_DONE);
+	TEST_CHECK(Upload_RawByte('x', 400) == UPLOAD_RAW_IDLE);
+	TEST_CHECK(Upload_GetSize() == 4);
+	TEST_CHECK(!memcmp(Upload_GetData(), "\r\n\x00\b", 4));
+
+	/* A sender that went quiet gives the UART back to the command line */
+	TEST_CHECK(Upload_StartRaw(4, 1000));
+	TEST_CHECK(Upload_RawByte('a', 1000) == UPLOAD_RAW_MORE);
+	TEST_CHECK(Upload_RawByte('b', 1000 + UPLOAD_RAW_TIMEOUT_MS + 1) == UPLOAD_RAW_IDLE);
+	TEST_CHECK(!Upload_RawPending());
+	TEST_CHECK(Upload_GetSize() == 0);
+}
+
+static void testUploadCommand(void) {
+	TEST_CHECK_STR(testCommand("upload clear"), "Upload Cleared");
+	TEST_CHECK_STR(testCommand("upload send"), "Upload Empty");
+	TEST_CHECK_STR(testCommand("upload hex 0g"), "Invalid Data");
+	TEST_CHECK_STR(testCommand("upload hex"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("upload hex 70 77 6e 00"), "Upload of 4 bytes");
+	TEST_CHECK_STR(testCommand("upload b64 AFJG"), "Upload of 7 bytes");
+	TEST_CHECK_STR(testCommand("upload"), "Upload of 7 bytes");
+
+	TEST_CHECK_STR(testCommand("upload send"), "Successful Transmission");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "pwn\x00\x00RF", 7));
+
+	/* A full size payload over several lines */
+	char line[128];
+	testCommand("upload clear");
+	for (uint32_t sent = 0; sent < UPLOAD_MAX_PAYLOAD; sent += 50) {
+		uint32_t len = snprintf(line, sizeof(line), "upload hex ");
+		for (uint32_t i = sent; i < sent + 50 && i < UPLOAD_MAX_PAYLOAD; i++) {
+			len += snprintf(&line[len], sizeof(line) - len, "%02lx", (unsigned long) (i & 0xFF));
+		}
+		testCommand(line);
+	}
+	TEST_CHECK_STR(testCommand("upload"), "Upload of 255 bytes");
+	TEST_CHECK_STR(testCommand("upload send"), "Successful Transmission");
+	TEST_CHECK(HostSubghz_Model()->registers[SUBGHZ_MODEL_REG_PAYLOAD_LENGTH] == 255);
+	TEST_CHECK(HostSubghz_Buffer()[0] == 0 && HostSubghz_Buffer()[254] == 254);
+
+	TEST_CHECK_STR(testCommand("upload raw 300"), "Invalid Arguments");
+	TEST_CHECK_STR(testCommand("upload raw 2"), "Send 2 Raw Bytes");
+	TEST_CHECK(Upload_RawPending());
+	Upload_Clear();
+}
+
+static void testTransmitSpaces(void) {
+	/* The message is the rest of the line */
+	TEST_CHECK_STR(testCommand("transmit hello pwn world"), "Successful Transmission");
+	TEST_CHECK(!memcmp(HostSubghz_Buffer(), "hello pwn world", 15));
+	TEST_CHECK(HostSubghz_Model()->registers[SUBGHZ_MODEL_REG_PAYLOAD_LENGTH] == 15);
+}
+
+/********************************
+ * Main
+ ********************************/
+int main(void) {
+	testBoot();
+
+	TEST_RUN(testHex);
+	TEST_RUN(testBase64);
+	TEST_RUN(testRaw);
+	TEST_RUN(testUploadCommand);
+	TEST_RUN(testTransmitSpaces);
+
+	return testResult();
+}
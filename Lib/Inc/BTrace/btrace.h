@@ -0,0 +1,47 @@
+/*
+ * btrace.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_BTRACE_BTRACE_H_
+#define INC_BTRACE_BTRACE_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define BTRACE_MAX_ARGS 4
+
+/* Frame header byte, the low nibble holds the argument count. Never valid ASCII, so frames
+ * can share the UART with the CLI and the text logs. Raw upload echo can hold it, a frame
+ * ends with a CRC-8 of the bytes before it so the decoder only accepts real ones. */
+#define BTRACE_SYNC 0xF0
+#define BTRACE_CRC_POLY 0x07
+
+/* Format strings live in .btrace_fmt, an INFO section of the ELF that is never flashed.
+ * The event id on the wire is the string's offset in that section. */
+#define BTRACE_SECTION __attribute__((section(".btrace_fmt")))
+
+/* @brief: Emits a binary trace event with up to BTRACE_MAX_ARGS integer arguments.
+ * Only %d %i %u %x %X %c conversions are understood by the decoder (Tools/btrace). */
+#define BTRACE(fmt, ...) do { \
+		static const char btraceFmt[] BTRACE_SECTION = fmt; \
+		const uint32_t btraceArgs[] = { 0, ##__VA_ARGS__ }; \
+		_Static_assert(sizeof(btraceArgs) / sizeof(uint32_t) <= BTRACE_MAX_ARGS + 1, "BTRACE: too many arguments"); \
+		BTrace_Emit(btraceFmt, &btraceArgs[1], sizeof(btraceArgs) / sizeof(uint32_t) - 1); \
+	} while (0)
+
+/********************************
+ * Interface Functions
+ ********************************/
+void BTrace_Init(void);
+void BTrace_Enable(uint8_t enable);
+uint8_t BTrace_IsEnabled(void);
+
+/* Use BTRACE(), safe from any task or interrupt */
+void BTrace_Emit(const char *fmt, const uint32_t *args, uint32_t nargs);
+
+#endif /* INC_BTRACE_BTRACE_H_ */
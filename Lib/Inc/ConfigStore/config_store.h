@@ -0,0 +1,46 @@
+/*
+ * config_store.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_CONFIGSTORE_CONFIG_STORE_H_
+#define INC_CONFIGSTORE_CONFIG_STORE_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define CONFIG_STORE_MAGIC 0xC0F6
+
+/********************************
+ * Types
+ ********************************/
+/* Record of the journal, one double word in front of its data padded to a double word */
+typedef struct {
+	uint16_t magic;
+	uint16_t sequence;		/* One more than the record before, the highest valid one is the latest */
+	uint8_t size;
+	uint8_t check;			/* ~size, a header programmed in full */
+	uint16_t crc;			/* CRC-16/CCITT-FALSE of the data */
+} ConfigRecord_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/*
+ * Small records in internal flash, a journal spread over the pages of the
+ * CONFIG region. Records are appended to a page until it is full, then the
+ * next page is erased and written, so every page is erased once every
+ * full turn of the journal. The latest record survives a reset in the middle
+ * of a save or of an erase.
+ */
+void ConfigStore_Init(void);
+
+uint8_t ConfigStore_Save(const void *data, uint8_t size);
+/* @brief: Copies the latest record to data, only when it has this size */
+uint8_t ConfigStore_Load(void *data, uint8_t size);
+
+#endif /* INC_CONFIGSTORE_CONFIG_STORE_H_ */
@@ -0,0 +1,96 @@
+/*
+ * encode.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_ENCODE_ENCODE_H_
+#define INC_ENCODE_ENCODE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define ENCODE_CRC_SLICES 4 /* Slice-by-4, one table per byte folded in a step */
+#define ENCODE_MAX_OVERHEAD 4 /* Bytes added to a payload, the largest CRC */
+
+/********************************
+ * Types
+ ********************************/
+/* CRC in the usual catalogue form, e.g. CRC-16/CCITT-FALSE is {16, 0x1021, 0xFFFF, 0x0000, 0, 0} */
+typedef struct {
+	uint8_t width;				/* 8 to 32 bits */
+	uint32_t poly;				/* MSB first, without the x^width term */
+	uint32_t init;
+	uint32_t xorout;
+	uint8_t refin, refout;
+} EncodeCrc_t;
+
+/*
+ * Fibonacci LFSR, PN9 (x^9 + x^5 + 1) is {9, 0x021, 0x1FF, 0}. Every step
+ * outputs stage 0 and shifts right, the parity of the tapped stages enters
+ * at the top. The bits of a byte are whitened LSB first unless msbFirst.
+ */
+typedef struct {
+	uint8_t degree;				/* 8 to 16 stages */
+	uint16_t taps;				/* Bit n taps stage n */
+	uint16_t seed;
+	uint8_t msbFirst;
+} EncodeWhitening_t;
+
+typedef struct {
+	EncodeCrc_t crc;
+	uint32_t table[ENCODE_CRC_SLICES][256];
+} EncodeCrcTable_t;
+
+/* State after 8 steps, from the low and the high byte of the state before */
+typedef struct {
+	EncodeWhitening_t whitening;
+	uint16_t next[2][256];
+} EncodeWhiteningTable_t;
+
+typedef struct {
+	const char *name;
+	EncodeCrc_t crc;
+} EncodeCrcPreset_t;
+
+typedef struct {
+	const char *name;
+	EncodeWhitening_t whitening;
+} EncodeWhiteningPreset_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/* Kernels, tables are built once per configuration */
+void Encode_CrcTableInit(EncodeCrcTable_t *table, const EncodeCrc_t *crc);
+uint32_t Encode_Crc(const EncodeCrcTable_t *table, const uint8_t *data, size_t len);
+void Encode_WhiteningTableInit(EncodeWhiteningTable_t *table, const EncodeWhitening_t *whitening);
+void Encode_Whiten(const EncodeWhiteningTable_t *table, uint8_t *data, size_t len);
+
+/* Bit at a time references of the kernels above */
+uint32_t Encode_CrcBitwise(const EncodeCrc_t *crc, const uint8_t *data, size_t len);
+void Encode_WhitenBitwise(const EncodeWhitening_t *whitening, uint8_t *data, size_t len);
+
+/* NULL terminated */
+extern const EncodeCrcPreset_t Encode_CrcPresets[];
+extern const EncodeWhiteningPreset_t Encode_WhiteningPresets[];
+
+/* Payload encoding stage in front of the radio, both parts are off after boot */
+void Encode_Init(void);
+void Encode_SetCrc(const EncodeCrc_t *crc);					/* NULL turns it off */
+void Encode_SetWhitening(const EncodeWhitening_t *whitening);	/* NULL turns it off */
+const EncodeCrc_t *Encode_GetCrc(void);						/* NULL when off */
+const EncodeWhitening_t *Encode_GetWhitening(void);			/* NULL when off */
+
+/*
+ * Appends the CRC of in (LSB first when refout, MSB first otherwise), then
+ * whitens payload and CRC. Returns the length written to out, 0 if it does
+ * not fit in size.
+ */
+size_t Encode_Apply(const uint8_t *in, size_t len, uint8_t *out, size_t size);
+
+#endif /* INC_ENCODE_ENCODE_H_ */
@@ -0,0 +1,30 @@
+/*
+ * flash.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_FLASH_FLASH_H_
+#define INC_FLASH_FLASH_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* The flash is programmed a double word at a time */
+#define FLASH_ALIGN 8
+
+/********************************
+ * Interface Functions
+ ********************************/
+/* CRC-16/CCITT-FALSE of the records of the flash stores */
+uint16_t Flash_Crc16(const uint8_t *data, uint32_t size);
+uint8_t Flash_IsErased(const uint8_t *addr, uint32_t size);
+
+/* The flash has to be unlocked around these */
+uint8_t Flash_Program(const uint8_t *addr, const uint8_t *data, uint32_t size);
+uint8_t Flash_ErasePages(const uint8_t *addr, uint32_t pages);
+
+#endif /* INC_FLASH_FLASH_H_ */
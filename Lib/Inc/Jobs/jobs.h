@@ -0,0 +1,77 @@
+/*
+ * jobs.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_JOBS_JOBS_H_
+#define INC_JOBS_JOBS_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define JOBS_MAX 8
+#define JOBS_MAX_PAYLOAD 64			/* Copied payloads, stored ones are read in place */
+#define JOBS_NO_DEADLINE UINT32_MAX
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	uint32_t period;			/* ms */
+	uint32_t freq;				/* Hz, 0 for the current frequency */
+	uint32_t bitRate;			/* bps, 0 for the current datarate */
+	uint8_t power;				/* dBm, 0 for the current power */
+	uint8_t priority;			/* The higher one goes first when two jobs collide */
+	uint8_t stored;				/* data stays valid (payload store), it is not copied */
+	uint8_t size;
+	const uint8_t *data;
+} JobConfig_t;
+
+typedef struct {
+	uint8_t active;
+	uint8_t deferred;			/* The next packet waits for a higher priority job */
+	JobConfig_t config;
+	uint8_t payload[JOBS_MAX_PAYLOAD];
+
+	uint32_t next;				/* Deadline of the next packet, ms tick */
+	uint32_t firstSent, lastSent;	/* Ticks of the first and the last packet, the achieved rate */
+	uint32_t airtime;			/* ms, of the last packet */
+
+	uint32_t sent;
+	uint32_t slipped;			/* Packets sent late behind a higher priority job */
+	uint32_t skipped;			/* Periods dropped after falling a whole period behind */
+	uint32_t lateLast, lateMax, lateSum;
+} Job_t;
+
+/* @brief: Time on air of a packet of the job, ms */
+typedef uint32_t (*JobsAirtime_t)(const JobConfig_t *config);
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Jobs_Init(JobsAirtime_t airtime);
+
+/* @brief: Adds a job due at now, returns its index or -1 when every slot is taken */
+int32_t Jobs_Add(const JobConfig_t *config, uint32_t now);
+uint8_t Jobs_Remove(uint8_t index);
+void Jobs_Clear(void);
+
+/* @brief: NULL for a free slot */
+const Job_t *Jobs_Get(uint8_t index);
+uint32_t Jobs_Count(void);
+
+/*
+ * @brief: Earliest deadline first, the highest priority among the jobs due.
+ * A job is held back (slips) when its airtime would run into the deadline of a
+ * higher priority job, and none starts while the last one is on air. A job a
+ * whole period behind drops the periods it missed instead of catching up.
+ * Returns the job to send now or -1, wait is the ms until the next call
+ * (JOBS_NO_DEADLINE without jobs).
+ */
+int32_t Jobs_Next(uint32_t now, uint32_t *wait);
+
+#endif /* INC_JOBS_JOBS_H_ */
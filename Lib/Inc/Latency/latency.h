@@ -0,0 +1,47 @@
+/*
+ * latency.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_LATENCY_LATENCY_H_
+#define INC_LATENCY_LATENCY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define LATENCY_RING_SIZE 64 /* Power of two */
+#define LATENCY_BUCKETS 21 /* log2(us) buckets, the last one collects everything above ~1 s */
+
+/********************************
+ * Types
+ ********************************/
+/* Points on the path from a CLI line to the end of the RF packet, in the order they are hit */
+typedef enum {
+	LATENCY_UART_LINE,
+	LATENCY_DEQUEUE,
+	LATENCY_HANDLER,
+	LATENCY_RADIO_SEND,
+	LATENCY_SET_TX,
+	LATENCY_TX_DONE,
+	LATENCY_STAGE_COUNT
+} LatencyStage_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Latency_Init(void);
+
+/* Timestamps a stage, safe from any task or interrupt */
+void Latency_Mark(LatencyStage_t stage);
+
+void Latency_Reset(void);
+
+/* Formats line <index> of the histogram report into buf, returns 1 while more lines follow */
+uint8_t Latency_GetLine(uint32_t index, char *buf, size_t len);
+
+#endif /* INC_LATENCY_LATENCY_H_ */
@@ -0,0 +1,30 @@
+/*
+ * mem_budget.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_MEMBUDGET_MEM_BUDGET_H_
+#define INC_MEMBUDGET_MEM_BUDGET_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* Places a buffer in the otherwise unused RAM2 bank (see .ram2 in the linker script).
+ * The startup code does not clear it, so the owner has to initialise it. */
+#define RAM2_BUFFER __attribute__((section(".ram2")))
+
+/* One entry per MemBudget_Register call, the report counts the ones that did not fit */
+#define MEM_BUDGET_MAX_ENTRIES 40
+
+/********************************
+ * Interface Functions
+ ********************************/
+void MemBudget_Register(const char *subsystem, const char *name, uint32_t bytes);
+uint8_t MemBudget_GetLine(uint32_t index, char *buf, size_t len);
+
+#endif /* INC_MEMBUDGET_MEM_BUDGET_H_ */
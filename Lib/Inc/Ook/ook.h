@@ -0,0 +1,74 @@
+/*
+ * ook.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_OOK_OOK_H_
+#define INC_OOK_OOK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define OOK_MAX_SYMBOL_CHIPS 14 /* 4 symbols of a nibble pattern fit in 56 bits */
+#define OOK_MAX_CHIPS (255 * 8) /* One radio packet of the 2-FSK fallback */
+#define OOK_MAX_CODE_BITS 64
+#define OOK_SEND_BUSY UINT32_MAX /* Ook_Send: the radio is busy, nothing was sent */
+
+/********************************
+ * Types
+ ********************************/
+/* A carrier on/off pair: startHigh ? on for firstUs then off : off for firstUs then on */
+typedef struct {
+	uint8_t startHigh;
+	uint16_t firstUs, secondUs;
+} OokSymbol_t;
+
+/*
+ * Frame: sync symbol (skipped when its durations are 0), the code MSB first,
+ * then gapUs of silence. Sent repeats times back to back. Every duration is
+ * rounded to whole chips of chipUs.
+ */
+typedef struct {
+	uint16_t chipUs;
+	OokSymbol_t zero, one, sync;
+	uint32_t gapUs;
+	uint8_t repeats;
+} OokProtocol_t;
+
+/* Chip patterns, LSB aligned, first chip in the most significant position */
+typedef struct {
+	OokProtocol_t protocol;
+	uint64_t nibble[16];
+	uint8_t nibbleChips[16];
+	uint16_t symbol[2];
+	uint8_t symbolChips[2];
+	uint16_t syncChips[2];		/* First and second part of the sync symbol */
+	uint32_t gapChips;
+} OokEncoder_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/* Returns 0 if a symbol is longer than OOK_MAX_SYMBOL_CHIPS or rounds to no chips */
+uint8_t Ook_Compile(OokEncoder_t *encoder, const OokProtocol_t *protocol);
+
+/* Chips are packed MSB first, 1 is carrier on. Returns the chip count, 0 if they do not fit in size bytes */
+uint32_t Ook_Encode(const OokEncoder_t *encoder, const uint8_t *code, uint32_t bits, uint8_t *out, size_t size);
+
+/* Chip at a time reference of Ook_Encode */
+uint32_t Ook_EncodeReference(const OokProtocol_t *protocol, const uint8_t *code, uint32_t bits, uint8_t *out, size_t size);
+
+/* Protocol used by Ook_Send, EV1527 style PWM after boot */
+void Ook_Init(void);
+uint8_t Ook_SetProtocol(const OokProtocol_t *protocol);
+const OokProtocol_t *Ook_GetProtocol(void);
+
+/* Encodes the code with the current protocol and transmits it, returns the chip count, 0 or OOK_SEND_BUSY */
+uint32_t Ook_Send(const uint8_t *code, uint32_t bits);
+
+#endif /* INC_OOK_OOK_H_ */
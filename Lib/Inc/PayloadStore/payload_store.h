@@ -0,0 +1,60 @@
+/*
+ * payload_store.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_PAYLOADSTORE_PAYLOAD_STORE_H_
+#define INC_PAYLOADSTORE_PAYLOAD_STORE_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define PAYLOAD_STORE_MAX_IDS 128
+#define PAYLOAD_STORE_MAGIC 0x50AD
+
+/********************************
+ * Types
+ ********************************/
+/*
+ * Record of the log, programmed as one double word in front of its payload.
+ * The payload follows padded to a double word.
+ */
+typedef struct {
+	uint16_t magic;
+	uint8_t id;
+	uint8_t size;			/* 0 deletes the ID */
+	uint16_t crc;			/* CRC-16/CCITT-FALSE of the payload */
+	uint16_t check;			/* ~(id | size << 8), a header programmed in full */
+} PayloadRecord_t;
+
+typedef struct {
+	uint32_t payloads;		/* IDs with a payload */
+	uint32_t records;		/* Records in the log, replaced and deleted ones included */
+	uint32_t used;			/* Bytes of the log */
+	uint32_t size;			/* Bytes of the store */
+} PayloadStoreUsage_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/*
+ * Payloads in internal flash, an append-only log of records. Adding a payload
+ * with an ID already in use replaces it, the space of replaced and deleted
+ * payloads only comes back with PayloadStore_Erase. The index of the latest
+ * record of every ID is rebuilt from the log at boot.
+ */
+void PayloadStore_Init(void);
+
+uint8_t PayloadStore_Add(uint8_t id, const uint8_t *data, uint8_t size);
+uint8_t PayloadStore_Delete(uint8_t id);
+uint8_t PayloadStore_Erase(void);
+
+/* @brief: The payload in flash, read in place. NULL when the ID has none. */
+const uint8_t *PayloadStore_Get(uint8_t id, uint8_t *size);
+void PayloadStore_GetUsage(PayloadStoreUsage_t *usage);
+
+#endif /* INC_PAYLOADSTORE_PAYLOAD_STORE_H_ */
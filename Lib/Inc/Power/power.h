@@ -0,0 +1,31 @@
+/*
+ * power.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_POWER_POWER_H_
+#define INC_POWER_POWER_H_
+
+#include <stdint.h>
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	uint64_t runMs;     /* Time spent executing (including idle spinning) */
+	uint64_t sleepMs;   /* Time spent in SLEEP (stop mode blocked) */
+	uint64_t stop2Ms;   /* Time spent in STOP2 */
+	uint32_t sleepCount;
+	uint32_t stop2Count;
+} PowerStats_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Power_Init(void);
+void Power_GetStats(PowerStats_t *stats);
+void Power_AlarmIRQHandler(void);
+
+#endif /* INC_POWER_POWER_H_ */
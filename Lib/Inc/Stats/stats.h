@@ -0,0 +1,54 @@
+/*
+ * stats.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_STATS_STATS_H_
+#define INC_STATS_STATS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define STATS_MAX_TASKS 8
+#define STATS_MAX_QUEUES 4
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	STATS_IRQ_USART2,
+	STATS_IRQ_TIM1,
+	STATS_IRQ_SUBGHZ,
+	STATS_IRQ_COUNT
+} StatsIrq_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Stats_Init(void);
+
+/* FreeRTOS run time counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS / portGET_RUN_TIME_COUNTER_VALUE) */
+void Stats_InitRunTimeCounter(void);
+uint32_t Stats_GetRunTimeCounter(void);
+void Stats_AddSleepTime(uint32_t us);
+
+/* CPU cycles since boot including the time spent in SLEEP/STOP2, for measuring intervals */
+uint64_t Stats_GetCycles(void);
+
+void Stats_CountIrq(StatsIrq_t irq);
+void Stats_RecordTurnaround(uint32_t cycles);
+void Stats_CountTraceOverrun(void);
+
+void Stats_RegisterQueue(const char *name, void *queue);
+void Stats_SampleQueue(void *queue);
+void Stats_CountQueueDrop(void *queue);
+
+/* Formats line <index> of the report into buf, returns 1 while more lines follow */
+uint8_t Stats_GetLine(uint32_t index, char *buf, size_t len);
+
+#endif /* INC_STATS_STATS_H_ */
@@ -0,0 +1,96 @@
+/*
+ * template.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_TEMPLATE_TEMPLATE_H_
+#define INC_TEMPLATE_TEMPLATE_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define TEMPLATE_MAX_PAYLOAD 64
+#define TEMPLATE_MAX_OPS 16
+#define TEMPLATE_MAX_COUNTERS 4
+
+#define TEMPLATE_WIDTH_MASK 0x7F
+#define TEMPLATE_LITTLE_ENDIAN 0x80
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	TEMPLATE_OP_SEQ,		/* Counter arg, then advanced by its step */
+	TEMPLATE_OP_TIME,		/* ms since boot */
+	TEMPLATE_OP_RANDOM,		/* width random bytes */
+	TEMPLATE_OP_SUM,		/* Sum of the bytes from arg up to the field */
+	TEMPLATE_OP_XOR,		/* XOR of the bytes from arg up to the field */
+	TEMPLATE_OP_LENGTH,		/* Only while compiling, folded into the image */
+} TemplateOpcode_t;
+
+/* Writes width bytes at offset, big endian unless TEMPLATE_LITTLE_ENDIAN is set in width */
+typedef struct {
+	uint8_t opcode;
+	uint8_t offset;
+	uint8_t width;
+	uint8_t arg;
+} TemplateOp_t;
+
+typedef struct {
+	uint32_t start, step;
+} TemplateCounter_t;
+
+/* Literal bytes are in the image once, per packet only the ops run */
+typedef struct {
+	uint8_t image[TEMPLATE_MAX_PAYLOAD];
+	uint8_t size;
+	TemplateOp_t ops[TEMPLATE_MAX_OPS];
+	uint8_t opCount;
+	TemplateCounter_t counters[TEMPLATE_MAX_COUNTERS];
+	uint8_t counterCount;
+} TemplateProgram_t;
+
+typedef struct {
+	uint32_t counter[TEMPLATE_MAX_COUNTERS];
+	uint32_t random;		/* xorshift32 state */
+	uint32_t packets;
+} TemplateState_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/*
+ * Space separated fields, in payload order:
+ *   0x<hex>                    literal bytes
+ *   '<text>                    literal ASCII
+ *   seq8..seq32[le][:start[:step]]  counter, one step per packet
+ *   time16|time32[le]          ms since boot
+ *   rand<n>                    n random bytes
+ *   len                        payload length byte
+ *   sum8|sum16[le]|xor8[:from] checksum of the bytes from <from> up to the field
+ * Returns 0 on a syntax error or a payload over TEMPLATE_MAX_PAYLOAD.
+ */
+uint8_t Template_Compile(TemplateProgram_t *program, const char *spec);
+
+/* Counters back to their start, seed 0 picks a fixed one */
+void Template_Reset(const TemplateProgram_t *program, TemplateState_t *state, uint32_t seed);
+
+/* Writes one packet, returns its size */
+uint8_t Template_Evaluate(const TemplateProgram_t *program, TemplateState_t *state, uint32_t nowMs, uint8_t *out);
+
+/* Template used by continuous mode */
+void Template_Init(void);
+uint8_t Template_Set(const char *spec);
+void Template_Clear(void);
+void Template_Restart(uint32_t seed);
+const TemplateProgram_t *Template_Get(void);
+uint32_t Template_GetPackets(void);
+
+/* Next packet of the template, 0 when there is none */
+uint8_t Template_Next(uint8_t *out, uint32_t nowMs);
+
+#endif /* INC_TEMPLATE_TEMPLATE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * timeline.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_TIMELINE_TIMELINE_H_
+#define INC_TIMELINE_TIMELINE_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define TIMELINE_MAX_ENTRIES 64
+#define TIMELINE_MAX_OFFSET 0xFFFFFF		/* ms, 24 bits */
+#define TIMELINE_NO_DEADLINE UINT32_MAX
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	TIMELINE_FREQ,			/* arg Hz */
+	TIMELINE_POWER,			/* arg dBm */
+	TIMELINE_PRESET,		/* The saved radio configuration */
+	TIMELINE_SEND,			/* arg payload ID of the payload store */
+	TIMELINE_RX,			/* Receive until a packet or arg ms, later entries move by the time waited */
+	TIMELINE_LOOP,			/* Back to the first entry, arg times in all (0 forever), the last entry */
+	TIMELINE_ACTIONS,
+} TimelineAction_t;
+
+/* 8 bytes an entry */
+typedef struct {
+	uint32_t offset : 24;	/* ms from the start of the timeline, or of the loop iteration */
+	uint32_t action : 8;
+	uint32_t arg;
+} TimelineEntry_t;
+
+typedef struct {
+	uint32_t duration;		/* ms, RX waits as long as their timeout */
+	uint32_t airtime;		/* ms */
+	uint32_t packets;
+	uint32_t overlaps;		/* Packets sent while the one before is still on air */
+	uint8_t forever;		/* Loops forever, the figures are of one iteration */
+} TimelineDryRun_t;
+
+typedef struct {
+	uint8_t running;
+	uint8_t waitingRx;
+	uint32_t index;			/* Next entry */
+	uint32_t iteration;
+	uint32_t lateMax;		/* ms, the latest an entry ran */
+} TimelineStatus_t;
+
+/* How late an entry ran since the timeline started, ms */
+typedef struct {
+	uint32_t runs;
+	uint32_t lateLast, lateMax, lateSum;
+} TimelineLate_t;
+
+/* @brief: Time on air of a payload of the payload store, ms */
+typedef uint32_t (*TimelineAirtime_t)(uint32_t id);
+
+/********************************
+ * Interface Functions
+ ********************************/
+extern const char *const Timeline_ActionNames[TIMELINE_ACTIONS];
+
+void Timeline_Init(void);
+
+/* @brief: Appends an entry, offsets never go back and nothing follows a loop */
+uint8_t Timeline_Add(uint32_t offset, TimelineAction_t action, uint32_t arg);
+void Timeline_Clear(void);
+uint32_t Timeline_Count(void);
+/* @brief: Entry at index, NULL past the last one */
+const TimelineEntry_t *Timeline_Get(uint32_t index);
+
+void Timeline_DryRun(TimelineAirtime_t airtime, TimelineDryRun_t *result);
+
+/*
+ * Execution: Timeline_Next returns the entries due at now one by one, then
+ * NULL with the ms until the next one in wait. Entries run at their offsets
+ * from the start, a late entry does not move the ones after it.
+ */
+uint8_t Timeline_Start(uint32_t now);
+void Timeline_Stop(void);
+const TimelineEntry_t *Timeline_Next(uint32_t now, uint32_t *wait);
+
+/* @brief: Ends the wait of an RX entry, returns 1 if there was one */
+uint8_t Timeline_RxDone(uint32_t now);
+/* @brief: An RX entry waited for its whole timeout */
+uint8_t Timeline_RxExpired(uint32_t now);
+
+void Timeline_GetStatus(TimelineStatus_t *status);
+/* @brief: Lateness of an entry, NULL past the last one */
+const TimelineLate_t *Timeline_GetLate(uint32_t index);
+
+#endif /* INC_TIMELINE_TIMELINE_H_ */
@@ -0,0 +1,53 @@
+/*
+ * upload.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef INC_UPLOAD_UPLOAD_H_
+#define INC_UPLOAD_UPLOAD_H_
+
+#include <stdint.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define UPLOAD_MAX_PAYLOAD 255
+
+/* A raw upload is abandoned when no byte arrived for this long */
+#define UPLOAD_RAW_TIMEOUT_MS 1000
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	UPLOAD_RAW_IDLE,		/* No raw upload, the byte is not part of one */
+	UPLOAD_RAW_MORE,		/* Stored, more bytes expected */
+	UPLOAD_RAW_DONE,		/* Stored, the upload is complete */
+} UploadRawResult_t;
+
+/********************************
+ * Interface Functions
+ ********************************/
+/*
+ * Binary payload buffer filled from the CLI. Text encodings are decoded
+ * straight into it and can be appended over several lines, a raw upload
+ * stores the bytes as the UART receives them.
+ */
+void Upload_Init(void);
+void Upload_Clear(void);
+
+/* Decode and append, returns the bytes added. 0 and nothing appended when invalid or too long. */
+uint32_t Upload_AppendHex(const char *text, uint32_t len);
+uint32_t Upload_AppendBase64(const char *text, uint32_t len);
+
+/* Replaces the payload with the next size bytes received, fed by Upload_RawByte */
+uint8_t Upload_StartRaw(uint32_t size, uint32_t nowMs);
+uint8_t Upload_RawPending(void);
+UploadRawResult_t Upload_RawByte(uint8_t byte, uint32_t nowMs);
+
+const uint8_t *Upload_GetData(void);
+uint8_t Upload_GetSize(void);
+
+#endif /* INC_UPLOAD_UPLOAD_H_ */
@@ -0,0 +1,48 @@
+/*
+ * us_timer.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * One-shot compares of TIM2, a free running 1 MHz counter. Each user owns one
+ * of the four compare channels and is called from the TIM2 interrupt when the
+ * counter reaches its deadline, below the 1 ms tick of the FreeRTOS timers.
+ */
+
+#ifndef INC_USTIMER_US_TIMER_H_
+#define INC_USTIMER_US_TIMER_H_
+
+#include <stdint.h>
+
+/********************************
+ * Types
+ ********************************/
+typedef enum {
+	US_TIMER_BURST,				/* Gap between two packets of a burst */
+	US_TIMER_OOK,				/* Chip edges of an OOK frame keyed with the PA */
+	US_TIMER_TIMELINE,			/* Deadline of the next timeline entry */
+	US_TIMER_COUNT				/* At most 4, one per compare channel */
+} UsTimerChannel_t;
+
+/* @brief: Runs in the TIM2 interrupt, the channel is already stopped and may be started again */
+typedef void (*UsTimerCallback_t)(void);
+
+/********************************
+ * Interface Functions
+ ********************************/
+void UsTimer_Init(void);
+
+/* @brief: The counter, us. It wraps after 71 minutes and stops in STOP2. */
+uint32_t UsTimer_Now(void);
+
+/*
+ * @brief: Calls callback once the counter reaches at, right away when at already
+ * passed. Starting an armed channel again replaces its deadline. STOP2 is held
+ * off while any channel is armed, the counter would stop.
+ */
+void UsTimer_Start(UsTimerChannel_t channel, uint32_t at, UsTimerCallback_t callback);
+void UsTimer_Stop(UsTimerChannel_t channel);
+
+void UsTimer_IRQHandler(void);
+
+#endif /* INC_USTIMER_US_TIMER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * btrace.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "BTrace/btrace.h"
+#include "Stats/stats.h"
+#include "MemBudget/mem_budget.h"
+
+#include "stm32_adv_trace.h"
+
+#include "main.h"
+
+/********************************
+ * Defines
+ ********************************/
+/* Header + 16 bit id + delta and arguments as LEB128 varints (5 bytes max each) + CRC */
+#define BTRACE_FRAME_MAX (1 + 2 + 5 * (1 + BTRACE_MAX_ARGS) + 1)
+
+/********************************
+ * Static Variables
+ ********************************/
+static volatile uint8_t btraceEnabled = 0;
+static uint64_t lastCycles = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t btracePutVarint(uint8_t *buf, uint32_t value) {
+	uint32_t len = 0;
+
+	while (value >= 0x80) {
+		buf[len++] = (value & 0x7F) | 0x80;
+		value >>= 7;
+	}
+	buf[len++] = value;
+
+	return len;
+}
+
+static uint8_t btraceCrc8(const uint8_t *data, uint32_t len) {
+	uint8_t crc = 0;
+
+	for (uint32_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? crc << 1 ^ BTRACE_CRC_POLY : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void BTrace_Init(void) {
+	/* Frames are built on the stack of the caller and queued in the TRACE fifo */
+	MemBudget_Register("BTRACE", "state", sizeof(btraceEnabled) + sizeof(lastCycles));
+}
+
+void BTrace_Enable(uint8_t enable) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* The first event after enabling carries the time since it was enabled */
+	if (enable && !btraceEnabled) {
+		lastCycles = Stats_GetCycles();
+	}
+	btraceEnabled = enable;
+
+	__set_PRIMASK(primask);
+}
+
+uint8_t BTrace_IsEnabled(void) {
+	return btraceEnabled;
+}
+
+void BTrace_Emit(const char *fmt, const uint32_t *args, uint32_t nargs) {
+	uint8_t frame[BTRACE_FRAME_MAX];
+	uint32_t len = 0;
+
+	if (!btraceEnabled) {
+		return;
+	}
+
+	uint16_t id = (uint16_t) (uintptr_t) fmt;
+	frame[len++] = BTRACE_SYNC | nargs;
+	frame[len++] = id & 0xFF;
+	frame[len++] = id >> 8;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* The delta is taken and the frame queued atomically, so the stream stays in time order */
+	uint32_t cyclesPerUs = SystemCoreClock / 1000000;
+	uint64_t now = Stats_GetCycles();
+	uint64_t deltaUs = (now - lastCycles) / cyclesPerUs;
+	if (deltaUs > UINT32_MAX) {
+		deltaUs = UINT32_MAX;
+	}
+	len += btracePutVarint(&frame[len], deltaUs);
+
+	for (uint32_t i = 0; i < nargs; i++) {
+		len += btracePutVarint(&frame[len], args[i]);
+	}
+	frame[len] = btraceCrc8(frame, len);
+	len++;
+
+	if (UTIL_ADV_TRACE_Send(frame, len) == UTIL_ADV_TRACE_OK) {
+		/* Keep the sub-microsecond remainder for the next delta */
+		lastCycles += deltaUs * cyclesPerUs;
+	} else {
+		Stats_CountTraceOverrun();
+	}
+
+	__set_PRIMASK(primask);
+}
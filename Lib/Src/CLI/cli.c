@@ -11,17 +11,31 @@
 #include "CLI/cli.h"
 
 #include "subghz_phy_app.h"
+#include "Power/power.h"
+#include "MemBudget/mem_budget.h"
+#include "Stats/stats.h"
+#include "Latency/latency.h"
+#include "BTrace/btrace.h"
+#include "Encode/encode.h"
+#include "Ook/ook.h"
+#include "Template/template.h"
+#include "Upload/upload.h"
+#include "PayloadStore/payload_store.h"
 
 #include "FreeRTOS.h"
 #include "cmsis_os.h"
 #include "FreeRTOS_CLI.h"
 
+#include "stm32_adv_trace.h"
+#include "stm32_adv_trace_if.h"
+
 #include "main.h"
 #include "stm32wlxx_hal.h"
 
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <inttypes.h>
 
 /********************************
  * Defines
@@ -29,6 +43,9 @@
 #define CLI_BUF_SIZE 128
 #define CLI_QUEUE_SIZE 5
 #define CLI_HISTORY_QUEUE_SIZE 5
+#define CLI_STACK_SIZE 1024
+
+#define CLI_FLAG_TX_SPACE 0x01
 
 #define ANSI_CURSOR_UP 'A'
 #define ANSI_CURSOR_DOWN 'B'
@@ -40,9 +57,12 @@
 #define CLI_CLEAR_TO_SCREEN_END "\e[0J"
 
 /********************************
- * External Variables
+ * Types
  ********************************/
-extern UART_HandleTypeDef huart2;
+typedef struct {
+	uint64_t stamp; /* Stats_GetCycles() when the line was completed in the ISR, counts the sleep after it */
+	char line[CLI_BUF_SIZE];
+} CliLine_t;
 
 /********************************
  * Function Prototypes
@@ -58,6 +78,24 @@ static BaseType_t commandWhiteningCallback(char *pcWriteBuffer, size_t xWriteBuf
 static BaseType_t commandSyncwordCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
 static BaseType_t commandTransmitCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
 static BaseType_t commandTransmitContinuousCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandStatsCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandBudgetCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandLatencyCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandBTraceCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandEchoCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandEncodeCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandOokCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandTemplateCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandStreamCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandUploadCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandPayloadCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandConfigCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandJobsCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandTimelineCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandBurstCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static BaseType_t commandStandbyCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString);
+static const uint8_t *paramStoredPayload(const char *param, uint8_t *size);
+static void cliRxCallback(uint8_t *pData, uint16_t size, uint8_t error);
 
 /********************************
  * Static Variables
@@ -88,7 +126,7 @@ static const CLI_Command_Definition_t commandFreqDeviation = {
 
 static const CLI_Command_Definition_t commandPower = {
     "power",
-    "power [dBm]: Get/Set the current transmitting power\r\n",
+    "power [dBm|stats]: Get/Set the current transmitting power or show time spent in each low power mode\r\n",
     commandPowerCallback,
     -1
 };
@@ -130,37 +168,204 @@ static const CLI_Command_Definition_t commandSyncword = {
 
 static const CLI_Command_Definition_t commandTransmit = {
     "transmit",
-    "transmit [msg]: Transmits a message using the SUBGHZ peripheral\r\n",
+    "transmit [msg|#id]: Transmits a message, or a payload of the payload store, using the SUBGHZ peripheral\r\n",
     commandTransmitCallback,
     -1
 };
 
 static const CLI_Command_Definition_t commandTransmitContinuous = {
     "transmitContinuous",
-    "transmitContinuous [ms] [msg]: Transmits a message using the SUBGHZ peripheral every ms. Pass 0ms to stop\r\n",
+    "transmitContinuous [ms] [msg|#id]: Transmits a message using the SUBGHZ peripheral every ms. Pass 0ms to stop\r\n",
     commandTransmitContinuousCallback,
     -1
 };
 
+static const CLI_Command_Definition_t commandStats = {
+    "stats",
+    "stats: Shows CPU usage per task since the last call, stack and heap low-water marks, queue fill levels and IRQ counts\r\n",
+    commandStatsCallback,
+    0
+};
+
+static const CLI_Command_Definition_t commandBudget = {
+    "budget",
+    "budget: Shows the RAM of the statically allocated objects of each module, RAM1 and RAM2 usage\r\n",
+    commandBudgetCallback,
+    0
+};
+
+static const CLI_Command_Definition_t commandLatency = {
+    "latency",
+    "latency [reset]: Shows histograms of each stage from a received line to the end of the RF packet\r\n",
+    commandLatencyCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandBTrace = {
+    "btrace",
+    "btrace [on|off]: Get/Set binary event tracing, decode the output with Tools/btrace\r\n",
+    commandBTraceCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandEcho = {
+    "echo",
+    "echo [on|off]: Get/Set the echo of typed characters, off for clients that pipeline commands\r\n",
+    commandEchoCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandEncode = {
+    "encode",
+    "encode [crc|whitening <preset>|<params>|off]: Get/Set the software CRC and whitening of every payload\r\n",
+    commandEncodeCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandOok = {
+    "ook",
+    "ook [pwm <s> <l>|manchester <h> [sH sL]|repeat <n> [gap]|send <bits> <hex>|mode [pa|fsk]|offset [Hz]]: On-off keying\r\n",
+    commandOokCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandTemplate = {
+    "template",
+    "template [off|send|start <ms>|<fields>]: Payload with per packet fields (seq, time, rand, len, sum), see the README\r\n",
+    commandTemplateCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandStream = {
+    "stream",
+    "stream [<bytes> [hex pattern]]: One packet of up to 16M bytes, refilled while on air (byte counter by default)\r\n",
+    commandStreamCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandUpload = {
+    "upload",
+    "upload [hex <hex>|b64 <base64>|raw <bytes>|send|clear]: Binary payload of up to 255 bytes, hex and b64 append\r\n",
+    commandUploadCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandPayload = {
+    "payload",
+    "payload [<id>|save <id>|delete <id>|erase]: Payloads in flash sent with #id, save stores the upload\r\n",
+    commandPayloadCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandConfig = {
+    "config",
+    "config [save|load|restore on|off]: Saves/Loads the radio configuration in flash, restore applies it at boot\r\n",
+    commandConfigCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandJobs = {
+    "jobs",
+    "jobs [add <ms> [freq=|power=|rate=|prio=<n>] <msg|#id>|del <n>|clear]: Periodic TX jobs, rate and lateness\r\n",
+    commandJobsCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandTimeline = {
+    "timeline",
+    "timeline [add <ms> <freq|power|preset|send|rx|loop> [n]|run|stop|dry|late|clear]: Timed RF sequence run on the device\r\n",
+    commandTimelineCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandBurst = {
+    "burst",
+    "burst <count> <gap_us> <msg|#id>|stop: Sends count packets, gap_us after each TX done. A key stops it\r\n",
+    commandBurstCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t commandStandby = {
+    "standby",
+    "standby [rc|xosc|fs [idle_ms]|sleep|measure [period_ms]]: Get/Set the radio mode between packets, compare TX start, current\r\n",
+    commandStandbyCallback,
+    -1
+};
+
+static const CLI_Command_Definition_t *const cliCommands[] = {
+	&commandClear,
+	&commandFreq,
+	&commandFreqDeviation,
+	&commandPower,
+	&commandDatarate,
+	&commandPreamble,
+	&commandCRC,
+	&commandWhitening,
+	&commandSyncword,
+	&commandTransmit,
+	&commandTransmitContinuous,
+	&commandStats,
+	&commandBudget,
+	&commandLatency,
+	&commandBTrace,
+	&commandEcho,
+	&commandEncode,
+	&commandOok,
+	&commandTemplate,
+	&commandStream,
+	&commandUpload,
+	&commandPayload,
+	&commandConfig,
+	&commandJobs,
+	&commandTimeline,
+	&commandBurst,
+	&commandStandby,
+};
+#define CLI_COMMAND_COUNT (sizeof(cliCommands) / sizeof(cliCommands[0]))
+
+/* Command list storage, so registration does not touch the heap */
+static CLI_Definition_List_Item_t cliCommandItems[CLI_COMMAND_COUNT];
 
 /* UART Receive */
-uint8_t cliByteRecved;
 static uint8_t recvBuf[CLI_BUF_SIZE] = {0};
 static uint32_t recvBufSize = 0;
-static uint8_t responseSent = 0;
+/* Set by every received byte, a key cuts the wait of a command short */
+static volatile uint8_t recvAny = 0;
+
+/* Repeated pattern of the `stream` command, a byte counter when empty */
+static uint8_t streamPattern[8];
+static uint8_t streamPatternLen = 0;
+static uint32_t streamOffset = 0;
+
+/* Typed characters are echoed back unless a client turned it off */
+static volatile uint8_t echo = 1;
+
+/* UART Transmit, set while the task waits for trace FIFO space */
+static volatile uint8_t txWaiting = 0;
 
 /* FreeRTOS Threads */
 static osThreadId_t cliThread;
+static uint32_t cliThreadStack[CLI_STACK_SIZE / sizeof(uint32_t)];
+static StaticTask_t cliThreadCb;
 static osThreadAttr_t cliThreadAttr = {
 		.name = "cliThread",
-		.stack_size = 1024,
+		.cb_mem = &cliThreadCb,
+		.cb_size = sizeof(cliThreadCb),
+		.stack_mem = cliThreadStack,
+		.stack_size = sizeof(cliThreadStack),
 		.priority = osPriorityAboveNormal
 };
 
 /* FreeRTOS Queues */
 static osMessageQueueId_t cliQueue;
+static uint8_t cliQueueStorage[CLI_QUEUE_SIZE * sizeof(CliLine_t)];
+static StaticQueue_t cliQueueCb;
 static osMessageQueueAttr_t cliQueueAttr = {
-		.name = "cliQueue"
+		.name = "cliQueue",
+		.cb_mem = &cliQueueCb,
+		.cb_size = sizeof(cliQueueCb),
+		.mq_mem = cliQueueStorage,
+		.mq_size = sizeof(cliQueueStorage)
 };
 
 uint8_t ansi_code = 0;
@@ -234,7 +439,13 @@ static BaseType_t commandPowerCallback(char *pcWriteBuffer, size_t xWriteBufferL
 	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
 
 	if (param == NULL) { /* No arguments */
-		snprintf(pcWriteBuffer, xWriteBufferLen, "Power = %lu dBm\r\n", SubghzApp_GetPower());
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Power = %" PRIu32 " dBm\r\n", SubghzApp_GetPower());
+	} else if (!strncmp(param, "stats", paramLen)) {
+		PowerStats_t stats;
+		Power_GetStats(&stats);
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Run %" PRIu32 " ms | Sleep %" PRIu32 " ms (%" PRIu32 ") | Stop2 %" PRIu32 " ms (%" PRIu32 ")\r\n",
+				(uint32_t) stats.runMs, (uint32_t) stats.sleepMs, stats.sleepCount, (uint32_t) stats.stop2Ms, stats.stop2Count);
 	} else {
 		uint32_t newPower = atoll(param);
 
@@ -257,7 +468,7 @@ static BaseType_t commandDatarateCallback(char *pcWriteBuffer, size_t xWriteBuff
 	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
 
 	if (param == NULL) { /* No arguments */
-		snprintf(pcWriteBuffer, xWriteBufferLen, "Datarate = %lu bps\r\n", SubghzApp_GetDatarate());
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Datarate = %" PRIu32 " bps\r\n", SubghzApp_GetDatarate());
 	} else {
 		uint32_t newDatarate = atoll(param);
 
@@ -280,7 +491,7 @@ static BaseType_t commandPreambleCallback(char *pcWriteBuffer, size_t xWriteBuff
 
 	if (param == NULL) { /* No arguments */
 		uint32_t len = SubghzApp_GetPreambleLength();
-		snprintf(pcWriteBuffer, xWriteBufferLen, "Preamble Length = %lu byte%s\r\n", len, (len == 0 || len > 1) ? "s" : "");
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Preamble Length = %" PRIu32 " byte%s\r\n", len, (len == 0 || len > 1) ? "s" : "");
 	} else {
 		uint32_t newPreamble = atoll(param);
 
@@ -365,7 +576,7 @@ static BaseType_t commandSyncwordCallback(char *pcWriteBuffer, size_t xWriteBuff
 		uint32_t len = SubghzApp_GetSyncword(word);
 
 		word[len] = '\x00';
-		snprintf(pcWriteBuffer, xWriteBufferLen, "Syncword of size %ld: %s\r\n", len, word);
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Syncword of size %" PRId32 ": %s\r\n", len, word);
 
 		return pdFALSE;
 	}
@@ -387,14 +598,32 @@ static BaseType_t commandSyncwordCallback(char *pcWriteBuffer, size_t xWriteBuff
 }
 
 static BaseType_t commandTransmitCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	Latency_Mark(LATENCY_HANDLER);
+
 	memset(pcWriteBuffer, 0, xWriteBufferLen);
 
 	BaseType_t paramLen;
 	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
 
-	if (param != NULL && strlen(param) < 64) {
-		SubghzApp_Sent((char *) param, strlen(param));
-		strcpy(pcWriteBuffer, "Successful Transmission\r\n");
+	if (param != NULL && param[0] == '#') {
+		/* Sent from flash, the radio reads it in place */
+		uint8_t size;
+		const uint8_t *payload = paramStoredPayload(param, &size);
+
+		if (payload == NULL) {
+			strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		} else if (SubghzApp_Sent((char *) payload, size)) {
+			strcpy(pcWriteBuffer, "Successful Transmission\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		}
+	} else if (param != NULL) {
+		/* The message is the rest of the line, spaces included */
+		if (SubghzApp_Sent((char *) param, strlen(param))) {
+			strcpy(pcWriteBuffer, "Successful Transmission\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		}
 	} else {
 		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
 	}
@@ -423,7 +652,17 @@ static BaseType_t commandTransmitContinuousCallback(char *pcWriteBuffer, size_t
 
 	param = FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLen);
 
-	if (param != NULL && strlen(param) < 64) {
+	if (param != NULL && param[0] == '#') {
+		uint8_t size;
+		const uint8_t *payload = paramStoredPayload(param, &size);
+
+		if (payload != NULL) {
+			SubghzApp_StartContinuousRef(payload, size, ms);
+			strcpy(pcWriteBuffer, "Continuous Transmission Enabled\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		}
+	} else if (param != NULL && strlen(param) <= 64) {
 		SubghzApp_StartContinuous((char *) param, strlen(param), ms);
 		strcpy(pcWriteBuffer, "Continuous Transmission Enabled\r\n");
 	} else {
@@ -434,50 +673,1026 @@ static BaseType_t commandTransmitContinuousCallback(char *pcWriteBuffer, size_t
 }
 
 
+static BaseType_t commandStatsCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static uint32_t line = 0;
 
-static void cliTask (void *argument) {
-	static char rxdata[CLI_BUF_SIZE];
-	static char txdata[CLI_BUF_SIZE];
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	/* One line per call, FreeRTOS_CLIProcessCommand keeps calling while pdTRUE is returned */
+	if (Stats_GetLine(line, pcWriteBuffer, xWriteBufferLen)) {
+		line++;
+		return pdTRUE;
+	}
 
-	HAL_UART_Transmit(&huart2, (uint8_t *) "> ", 2, 10);
-	HAL_UART_Transmit(&huart2, (uint8_t *) CLI_SAVE_CURSOR_POS, sizeof(CLI_SAVE_CURSOR_POS), 10);
+	line = 0;
+	return pdFALSE;
+}
 
-	HAL_UART_Receive_IT(&huart2, &cliByteRecved, 1);
+static BaseType_t commandBudgetCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static uint32_t line = 0;
 
-	for (;;) {
-		memset(rxdata, 0, CLI_BUF_SIZE);
-		if (osMessageQueueGet(cliQueue, rxdata, 0, osWaitForever) == osOK) {
-			/* Received Command */
-			static uint8_t moreData;
-
-			/* Add to history array */
-			if (strlen(rxdata) != 0) {
-				if (historyLen != CLI_HISTORY_QUEUE_SIZE) {
-					strncpy(cliHistory[historyLen], rxdata, CLI_BUF_SIZE);
-					historyLen++;
-				} else {
-					historyStart = (historyStart + 1) % CLI_HISTORY_QUEUE_SIZE;
-					strncpy(cliHistory[historyStart - 1], rxdata, CLI_BUF_SIZE);
-				}
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	/* Built on demand, every module has registered by now */
+	if (MemBudget_GetLine(line, pcWriteBuffer, xWriteBufferLen)) {
+		line++;
+		return pdTRUE;
+	}
+
+	line = 0;
+	return pdFALSE;
+}
+
+static BaseType_t commandLatencyCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static uint32_t line = 0;
+
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+
+	if (param != NULL) {
+		if (!strcmp(param, "reset")) {
+			Latency_Reset();
+			strcpy(pcWriteBuffer, "Latency histograms cleared\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		}
+		return pdFALSE;
+	}
+
+	if (Latency_GetLine(line, pcWriteBuffer, xWriteBufferLen)) {
+		line++;
+		return pdTRUE;
+	}
+
+	line = 0;
+	return pdFALSE;
+}
+
+static BaseType_t commandBTraceCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+
+	if (param == NULL) {
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Binary Trace: %s\r\n", BTrace_IsEnabled() ? "on" : "off");
+	} else if (!strcmp(param, "on")) {
+		BTrace_Enable(1);
+		strcpy(pcWriteBuffer, "Binary Trace Enabled\r\n");
+	} else if (!strcmp(param, "off")) {
+		BTrace_Enable(0);
+		strcpy(pcWriteBuffer, "Binary Trace Disabled\r\n");
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandEchoCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+
+	if (param == NULL) {
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Echo is %s\r\n", echo ? "On" : "Off");
+	} else if (!strcmp(param, "on")) {
+		echo = 1;
+		strcpy(pcWriteBuffer, "Echo On\r\n");
+	} else if (!strcmp(param, "off")) {
+		echo = 0;
+		strcpy(pcWriteBuffer, "Echo Off\r\n");
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static uint8_t paramIs(const char *param, BaseType_t paramLen, const char *word) {
+	return param != NULL && (size_t) paramLen == strlen(word) && !strncmp(param, word, paramLen);
+}
+
+/* @brief: Numeric parameter <index> (decimal or 0x hex), def when missing */
+static uint32_t paramNumber(const char *pcCommandString, UBaseType_t index, uint32_t def) {
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, index, &paramLen);
+
+	return param != NULL ? strtoul(param, NULL, 0) : def;
+}
+
+/* @brief: Value of a name=<n> option, NULL for another parameter */
+static const char *paramOption(const char *param, const char *name) {
+	size_t len = strlen(name);
+
+	return !strncmp(param, name, len) && param[len] == '=' ? &param[len + 1] : NULL;
+}
+
+static BaseType_t commandEncodeCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, valueLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const char *value = FreeRTOS_CLIGetParameter(pcCommandString, 2, &valueLen);
+
+	if (param == NULL) { /* No arguments */
+		const EncodeCrc_t *crc = Encode_GetCrc();
+		const EncodeWhitening_t *whitening = Encode_GetWhitening();
+		size_t len = 0;
+
+		if (crc != NULL) {
+			len += snprintf(pcWriteBuffer, xWriteBufferLen, "CRC-%u poly=0x%" PRIx32 " init=0x%" PRIx32 " xorout=0x%" PRIx32 " ref=%u/%u\r\n",
+					crc->width, crc->poly, crc->init, crc->xorout, crc->refin, crc->refout);
+		} else {
+			len += snprintf(pcWriteBuffer, xWriteBufferLen, "CRC Off\r\n");
+		}
+
+		if (whitening != NULL) {
+			snprintf(&pcWriteBuffer[len], xWriteBufferLen - len, "Whitening PN%u taps=0x%x seed=0x%x %s first\r\n",
+					whitening->degree, whitening->taps, whitening->seed, whitening->msbFirst ? "MSB" : "LSB");
+		} else {
+			snprintf(&pcWriteBuffer[len], xWriteBufferLen - len, "Whitening Off\r\n");
+		}
+	} else if (paramIs(param, paramLen, "off")) {
+		Encode_SetCrc(NULL);
+		Encode_SetWhitening(NULL);
+		strcpy(pcWriteBuffer, "Encoding Off\r\n");
+	} else if (paramIs(param, paramLen, "crc") && value != NULL) {
+		EncodeCrc_t crc;
+		const EncodeCrcPreset_t *preset = Encode_CrcPresets;
+
+		while (preset->name != NULL && !paramIs(value, valueLen, preset->name)) {
+			preset++;
+		}
+
+		if (paramIs(value, valueLen, "off")) {
+			Encode_SetCrc(NULL);
+			strcpy(pcWriteBuffer, "Software CRC Off\r\n");
+			return pdFALSE;
+		} else if (preset->name != NULL) {
+			crc = preset->crc;
+		} else {
+			crc.width = paramNumber(pcCommandString, 2, 0);
+			crc.poly = paramNumber(pcCommandString, 3, 0);
+			crc.init = paramNumber(pcCommandString, 4, 0);
+			crc.xorout = paramNumber(pcCommandString, 5, 0);
+			crc.refin = crc.refout = paramNumber(pcCommandString, 6, 0) != 0;
+
+			uint32_t mask = crc.width == 32 ? 0xFFFFFFFF : (1UL << crc.width) - 1;
+			if (crc.width < 8 || crc.width > 32 || crc.poly == 0 || (crc.poly & ~mask) || (crc.init & ~mask) || (crc.xorout & ~mask)) {
+				strcpy(pcWriteBuffer, "Invalid CRC\r\n");
+				return pdFALSE;
+			}
+		}
+
+		Encode_SetCrc(&crc);
+		strcpy(pcWriteBuffer, "Software CRC Set Successfully\r\n");
+	} else if (paramIs(param, paramLen, "whitening") && value != NULL) {
+		EncodeWhitening_t whitening;
+		const EncodeWhiteningPreset_t *preset = Encode_WhiteningPresets;
+
+		while (preset->name != NULL && !paramIs(value, valueLen, preset->name)) {
+			preset++;
+		}
+
+		if (paramIs(value, valueLen, "off")) {
+			Encode_SetWhitening(NULL);
+			strcpy(pcWriteBuffer, "Software Whitening Off\r\n");
+			return pdFALSE;
+		} else if (preset->name != NULL) {
+			whitening = preset->whitening;
+			whitening.seed = paramNumber(pcCommandString, 3, whitening.seed);
+		} else {
+			whitening.degree = paramNumber(pcCommandString, 2, 0);
+			whitening.taps = paramNumber(pcCommandString, 3, 0);
+			whitening.seed = paramNumber(pcCommandString, 4, 0xFFFF);
+			whitening.msbFirst = paramIs(FreeRTOS_CLIGetParameter(pcCommandString, 5, &valueLen), valueLen, "msb");
+		}
+
+		/* An all zero state never leaves zero */
+		if (whitening.degree < 8 || whitening.degree > 16 || whitening.taps == 0) {
+			strcpy(pcWriteBuffer, "Invalid Whitening\r\n");
+			return pdFALSE;
+		}
+		whitening.seed &= (1UL << whitening.degree) - 1;
+		if (whitening.seed == 0) {
+			strcpy(pcWriteBuffer, "Invalid Whitening\r\n");
+			return pdFALSE;
+		}
+
+		Encode_SetWhitening(&whitening);
+		strcpy(pcWriteBuffer, "Software Whitening Set Successfully\r\n");
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+	while (b != 0) {
+		uint32_t t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+static char ookLevel(const OokSymbol_t *symbol) {
+	return symbol->startHigh ? 'H' : 'L';
+}
+
+static BaseType_t commandOokCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	OokProtocol_t protocol = *Ook_GetProtocol();
+
+	if (param == NULL) { /* No arguments */
+		snprintf(pcWriteBuffer, xWriteBufferLen, "OOK %u us chips, 0=%c%u/%u 1=%c%u/%u sync=%c%u/%u gap=%" PRIu32 " us x%u\r\n",
+				protocol.chipUs, ookLevel(&protocol.zero), protocol.zero.firstUs, protocol.zero.secondUs,
+				ookLevel(&protocol.one), protocol.one.firstUs, protocol.one.secondUs,
+				ookLevel(&protocol.sync), protocol.sync.firstUs, protocol.sync.secondUs, protocol.gapUs, protocol.repeats);
+	} else if (paramIs(param, paramLen, "pwm") || paramIs(param, paramLen, "manchester")) {
+		uint8_t pwm = paramIs(param, paramLen, "pwm");
+		uint32_t first = paramNumber(pcCommandString, 2, 0);
+		uint32_t second = pwm ? paramNumber(pcCommandString, 3, 0) : first;
+		uint32_t syncHigh = paramNumber(pcCommandString, pwm ? 4 : 3, 0);
+		uint32_t syncLow = paramNumber(pcCommandString, pwm ? 5 : 4, 0);
+
+		/* PWM: 0 is a short pulse, 1 a long one. Manchester: 0 is high then low */
+		protocol.zero = (OokSymbol_t) { 1, first, second };
+		protocol.one = pwm ? (OokSymbol_t) { 1, second, first } : (OokSymbol_t) { 0, first, second };
+		protocol.sync = (OokSymbol_t) { 1, syncHigh, syncLow };
+
+		/* The chip is the largest unit every duration is a multiple of */
+		protocol.chipUs = gcd(gcd(first, second), gcd(syncHigh, syncLow));
+
+		if (first == 0 || second == 0 || first > UINT16_MAX || second > UINT16_MAX || syncHigh > UINT16_MAX || syncLow > UINT16_MAX
+				|| protocol.chipUs > UINT16_MAX || !Ook_SetProtocol(&protocol)) {
+			strcpy(pcWriteBuffer, "Invalid Protocol\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "OOK Protocol Set Successfully\r\n");
+		}
+	} else if (paramIs(param, paramLen, "repeat")) {
+		protocol.repeats = paramNumber(pcCommandString, 2, 0);
+		protocol.gapUs = paramNumber(pcCommandString, 3, protocol.gapUs);
+
+		if (paramNumber(pcCommandString, 2, 0) > UINT8_MAX || !Ook_SetProtocol(&protocol)) {
+			strcpy(pcWriteBuffer, "Invalid Protocol\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "OOK Protocol Set Successfully\r\n");
+		}
+	} else if (paramIs(param, paramLen, "mode")) {
+		const char *mode = FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLen);
+
+		if (mode == NULL) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "OOK Mode = %s\r\n", SubghzApp_GetOokMode() == SUBGHZ_OOK_PA ? "PA" : "FSK");
+		} else if (paramIs(mode, paramLen, "pa")) {
+			SubghzApp_SetOokMode(SUBGHZ_OOK_PA);
+			strcpy(pcWriteBuffer, "OOK Mode Set Successfully\r\n");
+		} else if (paramIs(mode, paramLen, "fsk")) {
+			SubghzApp_SetOokMode(SUBGHZ_OOK_FSK);
+			strcpy(pcWriteBuffer, "OOK Mode Set Successfully\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Invalid Mode\r\n");
+		}
+	} else if (paramIs(param, paramLen, "offset")) {
+		if (FreeRTOS_CLIGetParameter(pcCommandString, 2, &paramLen) == NULL) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "OOK Offset = %.3f kHz\r\n", SubghzApp_GetOokOffset() / 1.0e3);
+		} else if (!SubghzApp_SetOokOffset(paramNumber(pcCommandString, 2, 0))) {
+			strcpy(pcWriteBuffer, "Invalid Offset\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "OOK Offset Set Successfully\r\n");
+		}
+	} else if (paramIs(param, paramLen, "send")) {
+		BaseType_t hexLen;
+		const char *hex = FreeRTOS_CLIGetParameter(pcCommandString, 3, &hexLen);
+		uint32_t bits = paramNumber(pcCommandString, 2, 0);
+
+		if (hex == NULL || bits == 0 || bits > OOK_MAX_CODE_BITS) {
+			strcpy(pcWriteBuffer, "Invalid Code\r\n");
+			return pdFALSE;
+		}
+
+		/* The low <bits> bits of the value, sent MSB first */
+		uint64_t value = strtoull(hex, NULL, 16) << (OOK_MAX_CODE_BITS - bits);
+		uint8_t code[OOK_MAX_CODE_BITS / 8];
+		for (uint8_t i = 0; i < sizeof(code); i++) {
+			code[i] = value >> (56 - 8 * i);
+		}
+
+		uint32_t chips = Ook_Send(code, bits);
+		if (chips == 0) {
+			strcpy(pcWriteBuffer, "OOK Frame Too Long\r\n");
+		} else if (chips == OOK_SEND_BUSY) {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		} else {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "OOK Transmission of %" PRIu32 " chips\r\n", chips);
+		}
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandTemplateCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const TemplateProgram_t *program = Template_Get();
+
+	if (param == NULL) { /* No arguments */
+		if (program->size != 0) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Template of %u bytes, %u fields, %" PRIu32 " packets\r\n",
+					program->size, program->opCount, Template_GetPackets());
+		} else {
+			strcpy(pcWriteBuffer, "Template Off\r\n");
+		}
+	} else if (paramIs(param, paramLen, "off")) {
+		Template_Clear();
+		strcpy(pcWriteBuffer, "Template Off\r\n");
+	} else if (paramIs(param, paramLen, "send")) {
+		if (program->size == 0) {
+			strcpy(pcWriteBuffer, "Template Off\r\n");
+		} else if (SubghzApp_SendTemplate() != 0) {
+			strcpy(pcWriteBuffer, "Successful Transmission\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		}
+	} else if (paramIs(param, paramLen, "start")) {
+		uint32_t ms = paramNumber(pcCommandString, 2, 0);
+
+		if (program->size == 0) {
+			strcpy(pcWriteBuffer, "Template Off\r\n");
+		} else if (ms == 0) {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		} else if (!SubghzApp_StartTemplate(ms)) {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		} else {
+			/* Stopped like any continuous transmission, with transmitContinuous 0 */
+			strcpy(pcWriteBuffer, "Continuous Transmission Enabled\r\n");
+		}
+	} else if (Template_Set(param)) {
+		/* The fields are the rest of the line */
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Template Set Successfully, %u bytes\r\n", program->size);
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Template\r\n");
+	}
+
+	return pdFALSE;
+}
+
+/* @brief: Stream fill callback, the pattern repeated from the current offset */
+static uint32_t streamPatternFill(uint8_t *out, uint32_t size, void *context) {
+	for (uint32_t i = 0; i < size; i++, streamOffset++) {
+		out[i] = streamPatternLen != 0 ? streamPattern[streamOffset % streamPatternLen] : (uint8_t) streamOffset;
+	}
+
+	return size;
+}
+
+static BaseType_t commandStreamCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, hexLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const char *hex = FreeRTOS_CLIGetParameter(pcCommandString, 2, &hexLen);
+	SubghzStreamStatus_t status;
+
+	SubghzApp_GetStreamStatus(&status);
+
+	if (param == NULL) { /* No arguments */
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Stream %s, %" PRIu32 " of %" PRIu32 " bytes queued%s\r\n", status.active ? "On Air" : "Done",
+				status.queued, status.size, status.underrun ? ", underrun" : "");
+		return pdFALSE;
+	}
+
+	uint32_t size = paramNumber(pcCommandString, 1, 0);
+	if (size == 0 || size > 0xFFFFFF || (hex != NULL && (hexLen > 16 || hexLen % 2 != 0))) {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		return pdFALSE;
+	}
+
+	if (status.active) {
+		strcpy(pcWriteBuffer, "Stream Busy\r\n");
+		return pdFALSE;
+	}
+
+	/* Pattern bytes in the order they were typed */
+	streamPatternLen = hex != NULL ? hexLen / 2 : 0;
+	uint64_t value = hex != NULL ? strtoull(hex, NULL, 16) : 0;
+	for (uint8_t i = 0; i < streamPatternLen; i++) {
+		streamPattern[i] = value >> (8 * (streamPatternLen - 1 - i));
+	}
+	streamOffset = 0;
+
+	if (SubghzApp_StartStream(size, streamPatternFill, NULL)) {
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Streaming %" PRIu32 " bytes\r\n", size);
+	} else {
+		strcpy(pcWriteBuffer, "Stream Busy\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandUploadCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, dataLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const char *data = FreeRTOS_CLIGetParameter(pcCommandString, 2, &dataLen);
+
+	if (param == NULL) { /* No arguments */
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Upload of %u bytes\r\n", Upload_GetSize());
+	} else if (paramIs(param, paramLen, "clear")) {
+		Upload_Clear();
+		strcpy(pcWriteBuffer, "Upload Cleared\r\n");
+	} else if (paramIs(param, paramLen, "send")) {
+		if (Upload_GetSize() == 0) {
+			strcpy(pcWriteBuffer, "Upload Empty\r\n");
+		} else if (SubghzApp_Sent((char *) Upload_GetData(), Upload_GetSize())) {
+			strcpy(pcWriteBuffer, "Successful Transmission\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Radio Busy\r\n");
+		}
+	} else if (paramIs(param, paramLen, "raw")) {
+		/* The receive interrupt stores the next bytes, nothing is echoed or edited */
+		uint32_t size = paramNumber(pcCommandString, 2, 0);
+
+		if (Upload_StartRaw(size, HAL_GetTick())) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Send %" PRIu32 " Raw Bytes\r\n", size);
+		} else {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		}
+	} else if ((paramIs(param, paramLen, "hex") || paramIs(param, paramLen, "b64")) && data != NULL) {
+		/* The data is the rest of the line, decoded straight into the payload */
+		uint32_t added = paramIs(param, paramLen, "hex") ? Upload_AppendHex(data, strlen(data)) : Upload_AppendBase64(data, strlen(data));
+
+		if (added != 0) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Upload of %u bytes\r\n", Upload_GetSize());
+		} else {
+			strcpy(pcWriteBuffer, "Invalid Data\r\n");
+		}
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+/* @brief: Payload of a #<id> parameter, read in place from the payload store. NULL when it has none. */
+static const uint8_t *paramStoredPayload(const char *param, uint8_t *size) {
+	char *end;
+	uint32_t id = strtoul(&param[1], &end, 0);
+
+	if (param[0] != '#' || end == &param[1] || (*end != '\0' && *end != ' ') || id >= PAYLOAD_STORE_MAX_IDS) {
+		return NULL;
+	}
+
+	return PayloadStore_Get(id, size);
+}
+
+static BaseType_t commandPayloadCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, idLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const char *idParam = FreeRTOS_CLIGetParameter(pcCommandString, 2, &idLen);
+	uint32_t id = paramNumber(pcCommandString, 2, PAYLOAD_STORE_MAX_IDS);
+	uint8_t size;
+
+	if (param == NULL) { /* No arguments */
+		PayloadStoreUsage_t usage;
+		PayloadStore_GetUsage(&usage);
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "%" PRIu32 " Payloads, %" PRIu32 " Records, %" PRIu32 " of %" PRIu32 " bytes used\r\n",
+				usage.payloads, usage.records, usage.used, usage.size);
+	} else if (paramIs(param, paramLen, "erase")) {
+		/* Continuous transmissions may be reading the store */
+		SubghzApp_StopContinuous();
+
+		if (PayloadStore_Erase()) {
+			strcpy(pcWriteBuffer, "Payload Store Erased\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Payload Store Erase Failed\r\n");
+		}
+	} else if ((paramIs(param, paramLen, "save") || paramIs(param, paramLen, "delete"))
+			&& (idParam == NULL || id >= PAYLOAD_STORE_MAX_IDS)) {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	} else if (paramIs(param, paramLen, "save")) {
+		if (Upload_GetSize() == 0) {
+			strcpy(pcWriteBuffer, "Upload Empty\r\n");
+		} else if (PayloadStore_Add(id, Upload_GetData(), Upload_GetSize())) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Payload %" PRIu32 " Saved, %u bytes\r\n", id, Upload_GetSize());
+		} else {
+			strcpy(pcWriteBuffer, "Payload Store Full\r\n");
+		}
+	} else if (paramIs(param, paramLen, "delete")) {
+		if (PayloadStore_Delete(id)) {
+			strcpy(pcWriteBuffer, "Payload Deleted\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		}
+	} else if (*param >= '0' && *param <= '9') {
+		id = paramNumber(pcCommandString, 1, 0);
+
+		if (id < PAYLOAD_STORE_MAX_IDS && PayloadStore_Get(id, &size) != NULL) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Payload %" PRIu32 ": %u bytes\r\n", id, size);
+		} else {
+			strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		}
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandConfigCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, valueLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	const char *value = FreeRTOS_CLIGetParameter(pcCommandString, 2, &valueLen);
+
+	if (param == NULL) { /* No arguments */
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Restore at Boot is %s\r\n", SubghzApp_GetRestore() ? "On" : "Off");
+	} else if (paramIs(param, paramLen, "save")) {
+		if (SubghzApp_SaveConfig()) {
+			strcpy(pcWriteBuffer, "Configuration Saved\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Configuration Save Failed\r\n");
+		}
+	} else if (paramIs(param, paramLen, "load")) {
+		if (SubghzApp_LoadConfig()) {
+			strcpy(pcWriteBuffer, "Configuration Loaded\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "No Saved Configuration\r\n");
+		}
+	} else if (paramIs(param, paramLen, "restore") && value != NULL
+			&& (paramIs(value, valueLen, "on") || paramIs(value, valueLen, "off"))) {
+		uint8_t enable = paramIs(value, valueLen, "on");
+
+		if (SubghzApp_SetRestore(enable)) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Turned Restore at Boot %s\r\n", enable ? "On" : "Off");
+		} else {
+			strcpy(pcWriteBuffer, "Configuration Save Failed\r\n");
+		}
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandJobsCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static uint8_t slot = 0;
+
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+
+	if (param == NULL) { /* No arguments, one job per call */
+		const Job_t *job = NULL;
+
+		while (slot < JOBS_MAX && (job = Jobs_Get(slot)) == NULL) {
+			slot++;
+		}
+
+		if (job == NULL) {
+			if (Jobs_Count() == 0) {
+				strcpy(pcWriteBuffer, "No Jobs\r\n");
 			}
+			slot = 0;
+			return pdFALSE;
+		}
 
-			do {
-				moreData = FreeRTOS_CLIProcessCommand(rxdata, txdata, CLI_BUF_SIZE);
+		/* Achieved rate over the periods between the first and the last packet, in hundredths */
+		uint32_t span = job->lastSent - job->firstSent;
+		uint32_t rate = span != 0 ? (uint64_t) (job->sent - 1) * 100000 / span : 0;
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Job %u: %" PRIu32 " ms, prio %u, %" PRIu32 " sent, %" PRIu32 ".%02" PRIu32 "/s, late %" PRIu32 "/%" PRIu32 "/%" PRIu32 " ms, %" PRIu32 " slipped, %" PRIu32 " skipped\r\n",
+				slot, job->config.period, job->config.priority, job->sent, rate / 100, rate % 100,
+				job->lateLast, job->sent != 0 ? job->lateSum / job->sent : 0, job->lateMax, job->slipped, job->skipped);
+		slot++;
+
+		return pdTRUE;
+	} else if (paramIs(param, paramLen, "add")) {
+		JobConfig_t config = { .period = paramNumber(pcCommandString, 2, 0) };
+		UBaseType_t index = 3;
+		const char *value;
+
+		/* Options, then the payload as the rest of the line */
+		param = FreeRTOS_CLIGetParameter(pcCommandString, index, &paramLen);
+		while (param != NULL) {
+			if ((value = paramOption(param, "freq")) != NULL) {
+				config.freq = strtoul(value, NULL, 0);
+			} else if ((value = paramOption(param, "power")) != NULL) {
+				config.power = strtoul(value, NULL, 0);
+			} else if ((value = paramOption(param, "rate")) != NULL) {
+				config.bitRate = strtoul(value, NULL, 0);
+			} else if ((value = paramOption(param, "prio")) != NULL) {
+				config.priority = strtoul(value, NULL, 0);
+			} else {
+				break;
+			}
+			param = FreeRTOS_CLIGetParameter(pcCommandString, ++index, &paramLen);
+		}
 
-				responseSent = 0;
-				HAL_UART_Transmit_IT(&huart2, (uint8_t *) txdata, strlen(txdata));
+		if (param != NULL && *param == '#') {
+			config.data = paramStoredPayload(param, &config.size);
+			config.stored = 1;
+		} else if (param != NULL) {
+			config.data = (const uint8_t *) param;
+			config.size = strlen(param) <= JOBS_MAX_PAYLOAD ? strlen(param) : 0;
+		}
 
-				while (!responseSent);
-			} while (moreData != pdFALSE);
+		if (param == NULL || config.period == 0 || (config.freq != 0 && (config.freq < 1e6 || config.freq >= 1e9))
+				|| config.power > 22 || config.bitRate > 500e3 || (!config.stored && config.size == 0)) {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		} else if (config.data == NULL) {
+			strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		} else {
+			int32_t job = SubghzApp_AddJob(&config);
 
-			HAL_UART_Transmit(&huart2, (uint8_t *) "> ", 2, 10);
-			HAL_UART_Transmit(&huart2, (uint8_t *) CLI_SAVE_CURSOR_POS, sizeof(CLI_SAVE_CURSOR_POS), 10);
+			if (job >= 0) {
+				snprintf(pcWriteBuffer, xWriteBufferLen, "Job %" PRId32 " Added\r\n", job);
+			} else {
+				strcpy(pcWriteBuffer, "Jobs Full\r\n");
+			}
+		}
+	} else if (paramIs(param, paramLen, "del")) {
+		BaseType_t jobLen;
 
-			historyIndex = -1;
-			historyMode = 0;
+		if (FreeRTOS_CLIGetParameter(pcCommandString, 2, &jobLen) != NULL && SubghzApp_RemoveJob(paramNumber(pcCommandString, 2, JOBS_MAX))) {
+			strcpy(pcWriteBuffer, "Job Removed\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Unknown Job\r\n");
 		}
+	} else if (paramIs(param, paramLen, "clear")) {
+		SubghzApp_ClearJobs();
+		strcpy(pcWriteBuffer, "Jobs Cleared\r\n");
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
 
-		osDelay(10);
+	return pdFALSE;
+}
+
+static BaseType_t commandTimelineCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static uint32_t lateEntry = 0;
+
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, actionLen, argLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+
+	if (param == NULL) { /* No arguments */
+		TimelineStatus_t status;
+
+		Timeline_GetStatus(&status);
+		if (status.running) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Timeline Running, entry %" PRIu32 " of %" PRIu32 ", iteration %" PRIu32 ", late %" PRIu32 " ms max\r\n",
+					status.index, Timeline_Count(), status.iteration, status.lateMax);
+		} else {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Timeline Stopped, %" PRIu32 " Entries\r\n", Timeline_Count());
+		}
+	} else if (paramIs(param, paramLen, "add")) {
+		const char *action = FreeRTOS_CLIGetParameter(pcCommandString, 3, &actionLen);
+		const char *arg = FreeRTOS_CLIGetParameter(pcCommandString, 4, &argLen);
+		uint32_t value = paramNumber(pcCommandString, 4, 0);
+		TimelineAction_t type = 0;
+
+		while (action != NULL && type < TIMELINE_ACTIONS && !paramIs(action, actionLen, Timeline_ActionNames[type])) {
+			type++;
+		}
+
+		/* Only preset has no argument, a loop without one runs forever */
+		if (FreeRTOS_CLIGetParameter(pcCommandString, 2, &argLen) == NULL || action == NULL || type == TIMELINE_ACTIONS
+				|| (arg == NULL && type != TIMELINE_PRESET && type != TIMELINE_LOOP)
+				|| (type == TIMELINE_FREQ && (value < 1e6 || value >= 1e9))
+				|| (type == TIMELINE_POWER && (value < 1 || value > 22))
+				|| (type == TIMELINE_SEND && value >= PAYLOAD_STORE_MAX_IDS)) {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		} else if (Timeline_Add(paramNumber(pcCommandString, 2, 0), type, value)) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Entry %" PRIu32 " Added\r\n", Timeline_Count() - 1);
+		} else if (Timeline_Count() == TIMELINE_MAX_ENTRIES) {
+			strcpy(pcWriteBuffer, "Timeline Full\r\n");
+		} else {
+			/* Offsets going back, after a loop or a loop at 0 */
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		}
+	} else if (paramIs(param, paramLen, "run")) {
+		SubghzApp_StopTimeline();
+
+		if (SubghzApp_StartTimeline()) {
+			strcpy(pcWriteBuffer, "Timeline Started\r\n");
+		} else {
+			strcpy(pcWriteBuffer, "Timeline Empty\r\n");
+		}
+	} else if (paramIs(param, paramLen, "stop")) {
+		SubghzApp_StopTimeline();
+		strcpy(pcWriteBuffer, "Timeline Stopped\r\n");
+	} else if (paramIs(param, paramLen, "dry")) {
+		TimelineDryRun_t result;
+
+		SubghzApp_DryRunTimeline(&result);
+		snprintf(pcWriteBuffer, xWriteBufferLen, "%" PRIu32 " Entries: %" PRIu32 " ms, %" PRIu32 " ms on air, %" PRIu32 " packets, %" PRIu32 " overlaps%s\r\n",
+				Timeline_Count(), result.duration, result.airtime, result.packets, result.overlaps,
+				result.forever ? " per iteration, loops forever" : "");
+	} else if (paramIs(param, paramLen, "late")) { /* One entry per call */
+		const TimelineLate_t *late = Timeline_GetLate(lateEntry);
+
+		if (late == NULL) {
+			if (Timeline_Count() == 0) {
+				strcpy(pcWriteBuffer, "Timeline Empty\r\n");
+			}
+			lateEntry = 0;
+			return pdFALSE;
+		}
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Entry %" PRIu32 ": %s, %" PRIu32 " runs, late %" PRIu32 "/%" PRIu32 "/%" PRIu32 " ms\r\n",
+				lateEntry, Timeline_ActionNames[Timeline_Get(lateEntry)->action], late->runs,
+				late->lateLast, late->runs != 0 ? late->lateSum / late->runs : 0, late->lateMax);
+		lateEntry++;
+
+		return pdTRUE;
+	} else if (paramIs(param, paramLen, "clear")) {
+		SubghzApp_StopTimeline();
+		Timeline_Clear();
+		strcpy(pcWriteBuffer, "Timeline Cleared\r\n");
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandBurstCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	SubghzBurstStatus_t status;
+
+	if (paramIs(param, paramLen, "stop")) {
+		SubghzApp_GetBurstStatus(&status);
+		if (status.active) {
+			SubghzApp_StopBurst();
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Burst Stopped after %" PRIu32 " of %" PRIu32 " packets\r\n", status.sent, status.count);
+		} else {
+			strcpy(pcWriteBuffer, "No Burst\r\n");
+		}
+		return pdFALSE;
+	}
+
+	param = FreeRTOS_CLIGetParameter(pcCommandString, 3, &paramLen);
+	uint32_t count = paramNumber(pcCommandString, 1, 0);
+	uint32_t gap = paramNumber(pcCommandString, 2, UINT32_MAX);
+	const uint8_t *payload = (const uint8_t *) param;
+	uint8_t size = param != NULL ? strlen(param) : 0;
+
+	if (param == NULL || count == 0 || count > SUBGHZ_BURST_MAX_COUNT || gap > SUBGHZ_BURST_MAX_GAP_US) {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+		return pdFALSE;
+	}
+
+	if (*param == '#' && (payload = paramStoredPayload(param, &size)) == NULL) {
+		strcpy(pcWriteBuffer, "Unknown Payload\r\n");
+		return pdFALSE;
+	}
+
+	recvAny = 0;
+	if (!SubghzApp_StartBurst(payload, size, count, gap)) {
+		strcpy(pcWriteBuffer, "Burst Busy\r\n");
+		return pdFALSE;
+	}
+
+	/* The radio interrupt sends the packets, wait for the last one with some slack or a key */
+	uint64_t timeout = (uint64_t) count * (SubghzApp_GetAirtime(size) + gap / 1000 + 2) + 1000;
+	uint32_t start = osKernelGetTickCount();
+
+	SubghzApp_GetBurstStatus(&status);
+	while (status.active && !recvAny && osKernelGetTickCount() - start < timeout) {
+		osDelay(1);
+		SubghzApp_GetBurstStatus(&status);
+	}
+
+	if (status.active) {
+		SubghzApp_StopBurst();
+		SubghzApp_GetBurstStatus(&status);
+		if (recvAny) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Burst Stopped after %" PRIu32 " of %" PRIu32 " packets\r\n", status.sent, status.count);
+			return pdFALSE;
+		}
+	}
+
+	if (status.sent == status.count && status.duration != 0) {
+		/* Packets per second in hundredths */
+		uint32_t rate = (uint64_t) status.sent * 100000000 / status.duration;
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Burst of %" PRIu32 " packets: %" PRIu32 " us, %" PRIu32 ".%02" PRIu32 " packets/s\r\n",
+				status.sent, status.duration, rate / 100, rate % 100);
+	} else {
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Burst Failed after %" PRIu32 " of %" PRIu32 " packets\r\n", status.sent, status.count);
+	}
+
+	return pdFALSE;
+}
+
+static BaseType_t commandStandbyCallback(char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString) {
+	static const char *const modeNames[SUBGHZ_STANDBY_MODES] = {
+		[SUBGHZ_STANDBY_RC] = "STDBY_RC",
+		[SUBGHZ_STANDBY_XOSC] = "STDBY_XOSC",
+		[SUBGHZ_STANDBY_FS] = "FS",
+		[SUBGHZ_STANDBY_SLEEP] = "SLEEP",
+	};
+	static SubghzStandbyLatency_t latency;
+	static uint32_t line = 0;
+
+	memset(pcWriteBuffer, 0, xWriteBufferLen);
+
+	BaseType_t paramLen, idleLen;
+	const char *param = FreeRTOS_CLIGetParameter(pcCommandString, 1, &paramLen);
+	uint32_t idle;
+	SubghzStandby_t mode = SubghzApp_GetStandby(&idle);
+
+	if (param == NULL) { /* No arguments */
+		if (mode == SUBGHZ_STANDBY_RC || mode == SUBGHZ_STANDBY_SLEEP) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Standby %s\r\n", modeNames[mode]);
+		} else if (idle != 0) {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Standby %s, sleep after %" PRIu32 " ms idle\r\n", modeNames[mode], idle);
+		} else {
+			snprintf(pcWriteBuffer, xWriteBufferLen, "Standby %s, never sleeps\r\n", modeNames[mode]);
+		}
+	} else if (paramIs(param, paramLen, "measure")) {
+		uint32_t period = paramNumber(pcCommandString, 2, SUBGHZ_STANDBY_PERIOD_MS);
+
+		if (period == 0) {
+			strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+			return pdFALSE;
+		}
+
+		/* Measured once, then one line per mode */
+		if (line == 0) {
+			if (!SubghzApp_MeasureStandby(&latency)) {
+				strcpy(pcWriteBuffer, "Radio Busy\r\n");
+				return pdFALSE;
+			}
+
+			snprintf(pcWriteBuffer, xWriteBufferLen, "TX start and average current, a packet every %" PRIu32 " ms\r\n", period);
+			line++;
+			return pdTRUE;
+		}
+
+		SubghzStandby_t row = line - 1;
+		uint32_t current = SubghzApp_GetStandbyCurrent(&latency, row, period);
+
+		snprintf(pcWriteBuffer, xWriteBufferLen, "%s%s: %" PRIu32 " us, %" PRIu32 ".%" PRIu32 " uA\r\n", row == mode ? "*" : "", modeNames[row],
+				latency.startUs[row], current / 1000, current % 1000 / 100);
+
+		if (++line <= SUBGHZ_STANDBY_MODES) {
+			return pdTRUE;
+		}
+
+		line = 0;
+	} else if (paramIs(param, paramLen, "sleep")) {
+		SubghzApp_SetStandby(SUBGHZ_STANDBY_SLEEP, idle);
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Standby Set to %s\r\n", modeNames[SUBGHZ_STANDBY_SLEEP]);
+	} else if (paramIs(param, paramLen, "rc") || paramIs(param, paramLen, "xosc") || paramIs(param, paramLen, "fs")) {
+		mode = paramIs(param, paramLen, "rc") ? SUBGHZ_STANDBY_RC : paramIs(param, paramLen, "xosc") ? SUBGHZ_STANDBY_XOSC : SUBGHZ_STANDBY_FS;
+
+		/* The idle timeout stays unless given */
+		if (FreeRTOS_CLIGetParameter(pcCommandString, 2, &idleLen) != NULL) {
+			idle = paramNumber(pcCommandString, 2, 0);
+		}
+
+		SubghzApp_SetStandby(mode, idle);
+		snprintf(pcWriteBuffer, xWriteBufferLen, "Standby Set to %s\r\n", modeNames[mode]);
+	} else {
+		strcpy(pcWriteBuffer, "Invalid Arguments\r\n");
+	}
+
+	return pdFALSE;
+}
+
+/********************************
+ * UART Transmit
+ ********************************/
+/* Called from the UART interrupt each time the trace DMA releases FIFO space */
+static void cliTxSpaceNotify(void) {
+	if (txWaiting) {
+		txWaiting = 0;
+		osThreadFlagsSet(cliThread, CLI_FLAG_TX_SPACE);
+	}
+}
+
+/* @brief: Queues output from the CLI task on the trace FIFO, blocking only while it is full */
+static void cliWrite(const char *data, uint32_t len) {
+	while (len != 0) {
+		uint16_t chunk = len > CLI_BUF_SIZE ? CLI_BUF_SIZE : len;
+
+		/* Set before trying, so space released in between still wakes the task up */
+		txWaiting = 1;
+		if (UTIL_ADV_TRACE_Send((uint8_t *) data, chunk) == UTIL_ADV_TRACE_OK) {
+			txWaiting = 0;
+			data += chunk;
+			len -= chunk;
+		} else {
+			osThreadFlagsWait(CLI_FLAG_TX_SPACE, osFlagsWaitAny, osWaitForever);
+		}
+	}
+}
+
+static void cliPuts(const char *str) {
+	cliWrite(str, strlen(str));
+}
+
+/* @brief: Echo from the UART ISR, written in place into the trace FIFO. Dropped if it does not fit. */
+static void cliWriteFromISR(const char *data, uint16_t len) {
+	uint8_t *fifo;
+	uint16_t fifoSize, writePos;
+
+	if (UTIL_ADV_TRACE_ZCSend_Allocation(len, &fifo, &fifoSize, &writePos) != UTIL_ADV_TRACE_OK) {
+		Stats_CountTraceOverrun();
+		return;
+	}
+
+	for (uint16_t i = 0; i < len; i++) {
+		fifo[writePos] = data[i];
+		writePos = (writePos + 1) % fifoSize;
+	}
+
+	UTIL_ADV_TRACE_ZCSend_Finalize();
+}
+
+static void cliPutsFromISR(const char *str) {
+	cliWriteFromISR(str, strlen(str));
+}
+
+static void cliTask (void *argument) {
+	static CliLine_t rxLine;
+	static char txdata[CLI_BUF_SIZE];
+
+	/* The task runs before osThreadNew() returns to initTask, the TX notify needs the handle now */
+	cliThread = osThreadGetId();
+
+	/* Receiving before the prompt shows, a line typed straight away is not lost */
+	UTIL_ADV_TRACE_StartRxProcess(cliRxCallback);
+
+	/* Every module registered before initTask created this task, `budget` prints it again */
+	uint32_t line = 0;
+	uint8_t more;
+	do {
+		more = MemBudget_GetLine(line++, txdata, sizeof(txdata));
+		cliPuts(txdata);
+	} while (more);
+
+	cliPuts("> " CLI_SAVE_CURSOR_POS);
+
+	for (;;) {
+		if (osMessageQueueGet(cliQueue, &rxLine, 0, osWaitForever) != osOK) {
+			continue;
+		}
+		Latency_Mark(LATENCY_DEQUEUE);
+		BTRACE("cli line %u bytes", strlen(rxLine.line));
+
+		/* Received Command */
+		char *rxdata = rxLine.line;
+		static uint8_t moreData;
+
+		/* Add to history array */
+		if (strlen(rxdata) != 0) {
+			if (historyLen != CLI_HISTORY_QUEUE_SIZE) {
+				strncpy(cliHistory[historyLen], rxdata, CLI_BUF_SIZE);
+				historyLen++;
+			} else {
+				/* The newest entry replaces the oldest, just before the new start */
+				historyStart = (historyStart + 1) % CLI_HISTORY_QUEUE_SIZE;
+				strncpy(cliHistory[(historyStart + CLI_HISTORY_QUEUE_SIZE - 1) % CLI_HISTORY_QUEUE_SIZE], rxdata, CLI_BUF_SIZE);
+			}
+		}
+
+		do {
+			moreData = FreeRTOS_CLIProcessCommand(rxdata, txdata, CLI_BUF_SIZE);
+			cliPuts(txdata);
+		} while (moreData != pdFALSE);
+
+		cliPuts("> " CLI_SAVE_CURSOR_POS);
+
+		Stats_RecordTurnaround((uint32_t) (Stats_GetCycles() - rxLine.stamp));
+
+		historyIndex = -1;
+		historyMode = 0;
 	}
 }
 
@@ -486,24 +1701,37 @@ static void cliTask (void *argument) {
  ********************************/
 static void cliPrintHistory(uint32_t idx) {
 	uint8_t realHistoryIndex = ((historyLen - idx - 1) + historyStart) % CLI_HISTORY_QUEUE_SIZE;
+	/* A full length entry has no terminator, the buffer keeps one */
+	recvBufSize = strnlen(cliHistory[realHistoryIndex], CLI_BUF_SIZE - 1);
 	memset(recvBuf, 0, CLI_BUF_SIZE);
-	strncpy((char *) recvBuf, cliHistory[realHistoryIndex], strlen(cliHistory[realHistoryIndex]));
-
-	HAL_UART_Transmit(&huart2, (uint8_t *) CLI_RESTORE_CURSOR_POS, sizeof(CLI_RESTORE_CURSOR_POS), 10);
-	HAL_UART_Transmit(&huart2, (uint8_t *) CLI_CLEAR_TO_SCREEN_END, sizeof(CLI_CLEAR_TO_SCREEN_END), 10); /* Clear Line */
+	memcpy(recvBuf, cliHistory[realHistoryIndex], recvBufSize);
 
-	recvBufSize = strlen((char *) recvBuf);
+	cliPutsFromISR(CLI_RESTORE_CURSOR_POS CLI_CLEAR_TO_SCREEN_END); /* Clear Line */
 
-	HAL_UART_Transmit(&huart2, recvBuf, recvBufSize, 10);
+	cliWriteFromISR((char *) recvBuf, recvBufSize);
 }
 
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+static void cliRxCallback(uint8_t *pData, uint16_t size, uint8_t error) {
 	HAL_GPIO_TogglePin(LED1_GPIO_Port, LED1_Pin);
 
-	if (huart != &huart2) {
+	if (error || size == 0) {
 		return;
 	}
 
+	uint8_t cliByteRecved = *pData;
+	recvAny = 1;
+
+	/* Bytes of `upload raw` bypass the line editing */
+	switch (Upload_RawByte(cliByteRecved, HAL_GetTick())) {
+	case UPLOAD_RAW_MORE:
+		return;
+	case UPLOAD_RAW_DONE:
+		cliPutsFromISR("Upload Complete\r\n> " CLI_SAVE_CURSOR_POS);
+		return;
+	default:
+		break;
+	}
+
 	/* Add Byte to long buffer */
 	if (ansi_code == 2) { /* ANSI Code Received */
 		switch(cliByteRecved) {
@@ -527,25 +1755,36 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
 		if (recvBufSize != 0) {
 			recvBufSize--;
 			recvBuf[recvBufSize] = 0;
-			HAL_UART_Transmit(&huart2, (uint8_t *) "\b", 1, 10);
-			HAL_UART_Transmit(&huart2, (uint8_t *) CLI_CLEAR_TO_SCREEN_END, sizeof(CLI_CLEAR_TO_SCREEN_END), 10);
+			if (echo) {
+				cliPutsFromISR("\b" CLI_CLEAR_TO_SCREEN_END);
+			}
 		}
 	} else if (cliByteRecved == '\e' && ansi_code == 0) {
 		ansi_code++;
 	} else if (cliByteRecved == '[' && ansi_code == 1) {
 		ansi_code++;
 	} else {
-		HAL_UART_Transmit(&huart2, &cliByteRecved, 1, 10);
+		if (echo) {
+			cliWriteFromISR((char *) &cliByteRecved, 1);
+		}
 		recvBuf[recvBufSize] = cliByteRecved;
 		recvBufSize++;
 	}
 
 	/* Check if we got \r\n */
-	if (recvBufSize != 0 && recvBuf[recvBufSize - 2] == '\r' && recvBuf[recvBufSize - 1] == '\n') {
+	if (recvBufSize >= 2 && recvBuf[recvBufSize - 2] == '\r' && recvBuf[recvBufSize - 1] == '\n') {
 		/* Add Message to Queue */
+		static CliLine_t line;
+		line.stamp = Stats_GetCycles();
+		Latency_Mark(LATENCY_UART_LINE);
 		recvBuf[recvBufSize - 1] = 0;
 		recvBuf[recvBufSize - 2] = 0;
-		osMessageQueuePut(cliQueue, &recvBuf, 0, 0);
+		memcpy(line.line, recvBuf, CLI_BUF_SIZE);
+		if (osMessageQueuePut(cliQueue, &line, 0, 0) != osOK) {
+			/* The CLI task is behind, the line is lost */
+			Stats_CountQueueDrop(cliQueue);
+		}
+		Stats_SampleQueue(cliQueue);
 		memset(recvBuf, 0, CLI_BUF_SIZE);
 		recvBufSize = 0;
 	}
@@ -556,11 +1795,6 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
 		recvBufSize = 0;
 	}
 
-	HAL_UART_Receive_IT(&huart2, &cliByteRecved, 1);
-}
-
-void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
-	responseSent = 1;
 }
 
 
@@ -569,28 +1803,33 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
  ********************************/
 void commandLineInit(void) {
 	/* Register Commands */
-	FreeRTOS_CLIRegisterCommand(&commandClear);
-	FreeRTOS_CLIRegisterCommand(&commandFreq);
-	FreeRTOS_CLIRegisterCommand(&commandFreqDeviation);
-	FreeRTOS_CLIRegisterCommand(&commandPower);
-	FreeRTOS_CLIRegisterCommand(&commandDatarate);
-	FreeRTOS_CLIRegisterCommand(&commandPreamble);
-	FreeRTOS_CLIRegisterCommand(&commandCRC);
-	FreeRTOS_CLIRegisterCommand(&commandWhitening);
-	FreeRTOS_CLIRegisterCommand(&commandSyncword);
-	FreeRTOS_CLIRegisterCommand(&commandTransmit);
-	FreeRTOS_CLIRegisterCommand(&commandTransmitContinuous);
+	for (uint32_t i = 0; i < CLI_COMMAND_COUNT; i++) {
+		FreeRTOS_CLIRegisterCommandStatic(cliCommands[i], &cliCommandItems[i]);
+	}
 
-	/* Create Threads */
-	cliThread = osThreadNew(cliTask, NULL, &cliThreadAttr);
-	if (cliThread == NULL) {
+	MemBudget_Register("CLI", "task", sizeof(cliThreadCb) + sizeof(cliThreadStack));
+	MemBudget_Register("CLI", "queue", sizeof(cliQueueCb) + sizeof(cliQueueStorage));
+	MemBudget_Register("CLI", "commands", sizeof(cliCommandItems));
+	MemBudget_Register("CLI", "line buffers", sizeof(recvBuf) + sizeof(cliHistory) + 2 * sizeof(CliLine_t) + CLI_BUF_SIZE);
+
+	Stats_Init();
+	Latency_Init();
+	BTrace_Init();
+	Upload_Init();
+	PayloadStore_Init();
+
+	/* Create Queues, before the higher priority thread starts reading from them */
+	cliQueue = osMessageQueueNew(CLI_QUEUE_SIZE, sizeof(CliLine_t), &cliQueueAttr);
+	if (cliQueue == NULL) {
 		return;
 	}
+	Stats_RegisterQueue("cliQueue", cliQueue);
 
-	/* Create Queues */
-	cliQueue = osMessageQueueNew(CLI_QUEUE_SIZE, CLI_BUF_SIZE, &cliQueueAttr);
-	if (cliQueue == NULL) {
-		osThreadTerminate(cliThread);
+	UART_RegisterTxCpltNotify(cliTxSpaceNotify);
+
+	/* Create Threads */
+	cliThread = osThreadNew(cliTask, NULL, &cliThreadAttr);
+	if (cliThread == NULL) {
 		return;
 	}
 }
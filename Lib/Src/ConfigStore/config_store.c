@@ -0,0 +1,151 @@
+/*
+ * config_store.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "ConfigStore/config_store.h"
+#include "Flash/flash.h"
+
+#include "stm32wlxx_hal.h"
+
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define CONFIG_ALIGN FLASH_ALIGN
+#define CONFIG_NONE UINT32_MAX
+
+/********************************
+ * Static Variables
+ ********************************/
+/* CONFIG region of the linker script */
+extern uint8_t _sconfig_store[], _econfig_store[];
+
+/* Page written and the bytes of it used, the next record goes there */
+static uint32_t writePage = 0;
+static uint32_t writeUsed = 0;
+
+static uint32_t latestOffset = CONFIG_NONE;
+static uint16_t latestSequence = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t pageCount(void) {
+	return (_econfig_store - _sconfig_store) / FLASH_PAGE_SIZE;
+}
+
+static const ConfigRecord_t *recordAt(uint32_t offset) {
+	return (const ConfigRecord_t *) (_sconfig_store + offset);
+}
+
+static uint32_t recordSize(uint8_t dataSize) {
+	return sizeof(ConfigRecord_t) + (dataSize + CONFIG_ALIGN - 1) / CONFIG_ALIGN * CONFIG_ALIGN;
+}
+
+/*
+ * @brief: Walks the records of a page and keeps the latest valid one.
+ * Returns the bytes of the page used, all of it after something that is not a record.
+ */
+static uint32_t scanPage(uint32_t page) {
+	uint32_t used = 0;
+
+	while (used + sizeof(ConfigRecord_t) <= FLASH_PAGE_SIZE
+			&& !Flash_IsErased(_sconfig_store + page * FLASH_PAGE_SIZE + used, sizeof(ConfigRecord_t))) {
+		uint32_t offset = page * FLASH_PAGE_SIZE + used;
+		const ConfigRecord_t *record = recordAt(offset);
+
+		if (record->magic != CONFIG_STORE_MAGIC || record->check != (uint8_t) ~record->size
+				|| used + recordSize(record->size) > FLASH_PAGE_SIZE) {
+			return FLASH_PAGE_SIZE;
+		}
+
+		/* Sequence numbers are compared as a difference, they wrap */
+		if (Flash_Crc16((const uint8_t *) (record + 1), record->size) == record->crc
+				&& (latestOffset == CONFIG_NONE || (int16_t) (record->sequence - latestSequence) > 0)) {
+			latestOffset = offset;
+			latestSequence = record->sequence;
+		}
+
+		used += recordSize(record->size);
+	}
+
+	return used;
+}
+
+static uint8_t erasePage(uint32_t page) {
+	return Flash_ErasePages(_sconfig_store + page * FLASH_PAGE_SIZE, 1);
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void ConfigStore_Init(void) {
+	latestOffset = CONFIG_NONE;
+	for (uint32_t page = 0; page < pageCount(); page++) {
+		scanPage(page);
+	}
+
+	/* Writing goes on in the page of the latest record */
+	writePage = latestOffset != CONFIG_NONE ? latestOffset / FLASH_PAGE_SIZE : 0;
+	writeUsed = scanPage(writePage);
+}
+
+uint8_t ConfigStore_Save(const void *data, uint8_t size) {
+	uint32_t needed = recordSize(size);
+	ConfigRecord_t record = {
+		.magic = CONFIG_STORE_MAGIC,
+		.sequence = latestOffset != CONFIG_NONE ? latestSequence + 1 : 0,
+		.size = size,
+		.check = ~size,
+		.crc = Flash_Crc16(data, size),
+	};
+
+	if (size == 0 || needed > FLASH_PAGE_SIZE) {
+		return 0;
+	}
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+	/* A full page moves the journal to the next one, the oldest, erased first */
+	uint8_t ok = 1;
+	if (writeUsed + needed > FLASH_PAGE_SIZE || !Flash_IsErased(_sconfig_store + writePage * FLASH_PAGE_SIZE + writeUsed, needed)) {
+		writePage = (writePage + 1) % pageCount();
+		writeUsed = 0;
+		ok = erasePage(writePage);
+	}
+
+	uint32_t offset = writePage * FLASH_PAGE_SIZE + writeUsed;
+	ok = ok && Flash_Program(_sconfig_store + offset, (const uint8_t *) &record, sizeof(record))
+			&& Flash_Program(_sconfig_store + offset + sizeof(record), data, size);
+	HAL_FLASH_Lock();
+
+	/* A failed record still takes its space */
+	writeUsed += needed;
+
+	if (!ok) {
+		return 0;
+	}
+
+	latestOffset = offset;
+	latestSequence = record.sequence;
+
+	return 1;
+}
+
+uint8_t ConfigStore_Load(void *data, uint8_t size) {
+	if (latestOffset == CONFIG_NONE || recordAt(latestOffset)->size != size) {
+		return 0;
+	}
+
+	memcpy(data, recordAt(latestOffset) + 1, size);
+
+	return 1;
+}
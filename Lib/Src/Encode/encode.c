@@ -0,0 +1,287 @@
+/*
+ * encode.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Encode/encode.h"
+#include "MemBudget/mem_budget.h"
+
+#include <string.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+/* 5 KB of tables for the active configuration, rebuilt by the setters */
+static RAM2_BUFFER EncodeCrcTable_t crcTable;
+static RAM2_BUFFER EncodeWhiteningTable_t whiteningTable;
+
+static uint8_t crcOn = 0;
+static uint8_t whiteningOn = 0;
+
+/********************************
+ * Presets
+ ********************************/
+const EncodeCrcPreset_t Encode_CrcPresets[] = {
+	{ "crc8",			{ 8, 0x07, 0x00, 0x00, 0, 0 } },
+	{ "crc8-maxim",		{ 8, 0x31, 0x00, 0x00, 1, 1 } },
+	{ "crc16-ccitt",	{ 16, 0x1021, 0xFFFF, 0x0000, 0, 0 } },
+	{ "crc16-xmodem",	{ 16, 0x1021, 0x0000, 0x0000, 0, 0 } },
+	{ "crc16-kermit",	{ 16, 0x1021, 0x0000, 0x0000, 1, 1 } },
+	{ "crc16-ibm",		{ 16, 0x8005, 0x0000, 0x0000, 1, 1 } },
+	{ "crc16-modbus",	{ 16, 0x8005, 0xFFFF, 0x0000, 1, 1 } },
+	{ "crc24-ble",		{ 24, 0x00065B, 0x555555, 0x000000, 1, 1 } },
+	{ "crc32",			{ 32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, 1, 1 } },
+	{ NULL },
+};
+
+const EncodeWhiteningPreset_t Encode_WhiteningPresets[] = {
+	{ "pn9",		{ 9, 0x0021, 0x01FF, 0 } },	/* CC1101 style */
+	{ "pn9-msb",	{ 9, 0x0021, 0x01FF, 1 } },	/* Same sequence, bit reversed */
+	{ "pn15",		{ 15, 0x0003, 0x7FFF, 0 } },
+	{ NULL },
+};
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t reflect(uint32_t value, uint8_t bits) {
+	uint32_t result = 0;
+
+	for (uint8_t i = 0; i < bits; i++) {
+		result = (result << 1) | (value & 1);
+		value >>= 1;
+	}
+
+	return result;
+}
+
+static uint8_t reflect8(uint8_t b) {
+	b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+	b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+	b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+
+	return b;
+}
+
+static uint32_t widthMask(uint8_t width) {
+	return width == 32 ? 0xFFFFFFFF : (1UL << width) - 1;
+}
+
+/* @brief: One LFSR step, returns the bit shifted out */
+static uint8_t lfsrStep(const EncodeWhitening_t *whitening, uint16_t *state) {
+	uint16_t s = *state;
+	uint8_t out = s & 1;
+	uint8_t feedback = __builtin_parity(s & whitening->taps);
+
+	*state = (s >> 1) | ((uint16_t) feedback << (whitening->degree - 1));
+
+	return out;
+}
+
+/********************************
+ * Kernels
+ ********************************/
+/*
+ * @brief: Builds the slice tables. Reflected CRCs keep the register in the
+ * low bits and shift right; the others are left aligned in 32 bits and shift
+ * left, so one 4 byte step serves every width.
+ */
+void Encode_CrcTableInit(EncodeCrcTable_t *table, const EncodeCrc_t *crc) {
+	table->crc = *crc;
+
+	if (crc->refin) {
+		uint32_t poly = reflect(crc->poly, crc->width);
+
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t c = i;
+			for (uint8_t bit = 0; bit < 8; bit++) {
+				c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+			}
+			table->table[0][i] = c;
+		}
+		for (uint32_t i = 0; i < 256; i++) {
+			for (uint8_t k = 1; k < ENCODE_CRC_SLICES; k++) {
+				uint32_t prev = table->table[k - 1][i];
+				table->table[k][i] = (prev >> 8) ^ table->table[0][prev & 0xFF];
+			}
+		}
+	} else {
+		uint32_t poly = crc->poly << (32 - crc->width);
+
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t c = i << 24;
+			for (uint8_t bit = 0; bit < 8; bit++) {
+				c = (c & 0x80000000) ? (c << 1) ^ poly : c << 1;
+			}
+			table->table[0][i] = c;
+		}
+		for (uint32_t i = 0; i < 256; i++) {
+			for (uint8_t k = 1; k < ENCODE_CRC_SLICES; k++) {
+				uint32_t prev = table->table[k - 1][i];
+				table->table[k][i] = (prev << 8) ^ table->table[0][prev >> 24];
+			}
+		}
+	}
+}
+
+uint32_t Encode_Crc(const EncodeCrcTable_t *table, const uint8_t *data, size_t len) {
+	const EncodeCrc_t *crc = &table->crc;
+	const uint32_t (*t)[256] = table->table;
+	uint32_t c;
+
+	if (crc->refin) {
+		c = reflect(crc->init, crc->width);
+
+		for (; len >= 4; len -= 4, data += 4) {
+			c ^= (uint32_t) data[0] | (uint32_t) data[1] << 8 | (uint32_t) data[2] << 16 | (uint32_t) data[3] << 24;
+			c = t[3][c & 0xFF] ^ t[2][(c >> 8) & 0xFF] ^ t[1][(c >> 16) & 0xFF] ^ t[0][c >> 24];
+		}
+		while (len--) {
+			c = (c >> 8) ^ t[0][(c ^ *data++) & 0xFF];
+		}
+
+		if (!crc->refout) {
+			c = reflect(c, crc->width);
+		}
+	} else {
+		c = crc->init << (32 - crc->width);
+
+		for (; len >= 4; len -= 4, data += 4) {
+			c ^= (uint32_t) data[0] << 24 | (uint32_t) data[1] << 16 | (uint32_t) data[2] << 8 | (uint32_t) data[3];
+			c = t[3][c >> 24] ^ t[2][(c >> 16) & 0xFF] ^ t[1][(c >> 8) & 0xFF] ^ t[0][c & 0xFF];
+		}
+		while (len--) {
+			c = (c << 8) ^ t[0][(c >> 24) ^ *data++];
+		}
+
+		c >>= 32 - crc->width;
+		if (crc->refout) {
+			c = reflect(c, crc->width);
+		}
+	}
+
+	return (c ^ crc->xorout) & widthMask(crc->width);
+}
+
+/* @brief: The state is linear in the state before, so 8 steps split into two byte lookups */
+void Encode_WhiteningTableInit(EncodeWhiteningTable_t *table, const EncodeWhitening_t *whitening) {
+	table->whitening = *whitening;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		for (uint8_t half = 0; half < 2; half++) {
+			uint16_t state = (uint16_t) (i << (8 * half));
+			for (uint8_t bit = 0; bit < 8; bit++) {
+				lfsrStep(whitening, &state);
+			}
+			table->next[half][i] = state;
+		}
+	}
+}
+
+/* @brief: With 8 stages or more, the next 8 output bits are the low byte of the state */
+void Encode_Whiten(const EncodeWhiteningTable_t *table, uint8_t *data, size_t len) {
+	uint16_t state = table->whitening.seed;
+	uint8_t msbFirst = table->whitening.msbFirst;
+
+	for (size_t i = 0; i < len; i++) {
+		uint8_t mask = state & 0xFF;
+		data[i] ^= msbFirst ? reflect8(mask) : mask;
+		state = table->next[0][state & 0xFF] ^ table->next[1][state >> 8];
+	}
+}
+
+uint32_t Encode_CrcBitwise(const EncodeCrc_t *crc, const uint8_t *data, size_t len) {
+	uint32_t mask = widthMask(crc->width);
+	uint32_t top = 1UL << (crc->width - 1);
+	uint32_t c = crc->init & mask;
+
+	for (size_t i = 0; i < len; i++) {
+		uint8_t b = crc->refin ? reflect8(data[i]) : data[i];
+		c ^= (uint32_t) b << (crc->width - 8);
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			c = (c & top) ? (c << 1) ^ crc->poly : c << 1;
+		}
+		c &= mask;
+	}
+
+	if (crc->refout) {
+		c = reflect(c, crc->width);
+	}
+
+	return (c ^ crc->xorout) & mask;
+}
+
+void Encode_WhitenBitwise(const EncodeWhitening_t *whitening, uint8_t *data, size_t len) {
+	uint16_t state = whitening->seed;
+
+	for (size_t i = 0; i < len; i++) {
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			uint8_t out = lfsrStep(whitening, &state);
+			data[i] ^= out << (whitening->msbFirst ? 7 - bit : bit);
+		}
+	}
+}
+
+/********************************
+ * Encoding Stage
+ ********************************/
+void Encode_Init(void) {
+	MemBudget_Register("ENCODE", "tables (RAM2)", sizeof(crcTable) + sizeof(whiteningTable));
+}
+
+void Encode_SetCrc(const EncodeCrc_t *crc) {
+	crcOn = 0;
+
+	if (crc != NULL) {
+		Encode_CrcTableInit(&crcTable, crc);
+		crcOn = 1;
+	}
+}
+
+void Encode_SetWhitening(const EncodeWhitening_t *whitening) {
+	whiteningOn = 0;
+
+	if (whitening != NULL) {
+		Encode_WhiteningTableInit(&whiteningTable, whitening);
+		whiteningOn = 1;
+	}
+}
+
+const EncodeCrc_t *Encode_GetCrc(void) {
+	return crcOn ? &crcTable.crc : NULL;
+}
+
+const EncodeWhitening_t *Encode_GetWhitening(void) {
+	return whiteningOn ? &whiteningTable.whitening : NULL;
+}
+
+size_t Encode_Apply(const uint8_t *in, size_t len, uint8_t *out, size_t size) {
+	size_t crcBytes = crcOn ? (crcTable.crc.width + 7) / 8 : 0;
+
+	if (len + crcBytes > size) {
+		return 0;
+	}
+
+	memmove(out, in, len);
+
+	if (crcOn) {
+		uint32_t crc = Encode_Crc(&crcTable, out, len);
+
+		for (size_t i = 0; i < crcBytes; i++) {
+			size_t shift = crcTable.crc.refout ? 8 * i : 8 * (crcBytes - 1 - i);
+			out[len + i] = (uint8_t) (crc >> shift);
+		}
+		len += crcBytes;
+	}
+
+	if (whiteningOn) {
+		Encode_Whiten(&whiteningTable, out, len);
+	}
+
+	return len;
+}
@@ -0,0 +1,70 @@
+/*
+ * flash.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Flash helpers of the payload and config stores, which append records to
+ * their own region of the linker script
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Flash/flash.h"
+
+#include "stm32wlxx_hal.h"
+
+#include <string.h>
+
+/********************************
+ * Interface Functions
+ ********************************/
+uint16_t Flash_Crc16(const uint8_t *data, uint32_t size) {
+	uint16_t crc = 0xFFFF;
+
+	for (uint32_t i = 0; i < size; i++) {
+		crc ^= data[i] << 8;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+uint8_t Flash_IsErased(const uint8_t *addr, uint32_t size) {
+	for (uint32_t i = 0; i < size; i++) {
+		if (addr[i] != 0xFF) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* @brief: Programs size bytes at a double word aligned address, the last double word padded with 0xFF */
+uint8_t Flash_Program(const uint8_t *addr, const uint8_t *data, uint32_t size) {
+	for (uint32_t i = 0; i < size; i += FLASH_ALIGN) {
+		uint64_t word = UINT64_MAX;
+
+		memcpy(&word, &data[i], size - i < FLASH_ALIGN ? size - i : FLASH_ALIGN);
+		if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, (uint32_t) (addr + i), word) != HAL_OK) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* @brief: Erases the pages from the page aligned address on */
+uint8_t Flash_ErasePages(const uint8_t *addr, uint32_t pages) {
+	FLASH_EraseInitTypeDef erase = {
+		.TypeErase = FLASH_TYPEERASE_PAGES,
+		.Page = ((uint32_t) addr - FLASH_BASE) / FLASH_PAGE_SIZE,
+		.NbPages = pages,
+	};
+	uint32_t pageError;
+
+	return HAL_FLASHEx_Erase(&erase, &pageError) == HAL_OK;
+}
@@ -0,0 +1,181 @@
+/*
+ * jobs.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Jobs/jobs.h"
+#include "MemBudget/mem_budget.h"
+
+#include <string.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+static Job_t jobs[JOBS_MAX];
+static JobsAirtime_t jobAirtime;
+
+/* End of the airtime of the last packet, while busy */
+static uint8_t busy = 0;
+static uint32_t busyUntil = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+/* @brief: Ticks from now until t, negative once t passed. The tick counter wraps. */
+static int32_t until(uint32_t t, uint32_t now) {
+	return (int32_t) (t - now);
+}
+
+static uint32_t airtimeOf(const Job_t *job) {
+	return jobAirtime != NULL ? jobAirtime(&job->config) : 0;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Jobs_Init(JobsAirtime_t airtime) {
+	jobAirtime = airtime;
+	Jobs_Clear();
+
+	MemBudget_Register("JOBS", "jobs", sizeof(jobs));
+}
+
+int32_t Jobs_Add(const JobConfig_t *config, uint32_t now) {
+	if (config->period == 0 || config->size == 0 || (!config->stored && config->size > JOBS_MAX_PAYLOAD)) {
+		return -1;
+	}
+
+	for (uint32_t i = 0; i < JOBS_MAX; i++) {
+		Job_t *job = &jobs[i];
+
+		if (job->active) {
+			continue;
+		}
+
+		memset(job, 0, sizeof(*job));
+		job->config = *config;
+		if (!config->stored) {
+			memcpy(job->payload, config->data, config->size);
+			job->config.data = job->payload;
+		}
+
+		job->next = now;
+		job->active = 1;
+
+		return i;
+	}
+
+	return -1;
+}
+
+uint8_t Jobs_Remove(uint8_t index) {
+	if (index >= JOBS_MAX || !jobs[index].active) {
+		return 0;
+	}
+
+	jobs[index].active = 0;
+
+	return 1;
+}
+
+void Jobs_Clear(void) {
+	memset(jobs, 0, sizeof(jobs));
+	busy = 0;
+}
+
+const Job_t *Jobs_Get(uint8_t index) {
+	return index < JOBS_MAX && jobs[index].active ? &jobs[index] : NULL;
+}
+
+uint32_t Jobs_Count(void) {
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < JOBS_MAX; i++) {
+		count += jobs[i].active;
+	}
+
+	return count;
+}
+
+int32_t Jobs_Next(uint32_t now, uint32_t *wait) {
+	int32_t best = -1;
+
+	*wait = JOBS_NO_DEADLINE;
+
+	/* One packet on air at a time */
+	if (busy && until(busyUntil, now) > 0) {
+		*wait = until(busyUntil, now);
+		return -1;
+	}
+	busy = 0;
+
+	for (uint32_t i = 0; i < JOBS_MAX; i++) {
+		const Job_t *job = &jobs[i];
+		int32_t due = until(job->next, now);
+
+		if (!job->active) {
+			continue;
+		}
+
+		if (due > 0) {
+			*wait = (uint32_t) due < *wait ? (uint32_t) due : *wait;
+		} else if (best < 0 || job->config.priority > jobs[best].config.priority
+				|| (job->config.priority == jobs[best].config.priority && until(job->next, jobs[best].next) < 0)) {
+			best = i;
+		}
+	}
+
+	if (best < 0) {
+		return -1;
+	}
+
+	Job_t *job = &jobs[best];
+	uint32_t airtime = airtimeOf(job);
+
+	/* Slip behind a higher priority job due while this one would be on air */
+	uint32_t slip = JOBS_NO_DEADLINE;
+	for (uint32_t i = 0; i < JOBS_MAX; i++) {
+		const Job_t *other = &jobs[i];
+		int32_t due = until(other->next, now);
+
+		if (other->active && other->config.priority > job->config.priority && due > 0 && (uint32_t) due < airtime) {
+			slip = (uint32_t) due < slip ? (uint32_t) due : slip;
+		}
+	}
+
+	if (slip != JOBS_NO_DEADLINE) {
+		job->deferred = 1;
+		*wait = slip;
+		return -1;
+	}
+
+	uint32_t late = now - job->next;
+
+	if (job->sent == 0) {
+		job->firstSent = now;
+	}
+	job->lastSent = now;
+	job->sent++;
+	job->slipped += job->deferred;
+	job->deferred = 0;
+	job->lateLast = late;
+	job->lateMax = late > job->lateMax ? late : job->lateMax;
+	job->lateSum += late;
+	job->airtime = airtime;
+
+	/* Periods missed are dropped, the job keeps its phase */
+	uint32_t behind = late / job->config.period;
+	job->skipped += behind;
+	job->next += job->config.period * (behind + 1);
+
+	busy = 1;
+	busyUntil = now + airtime;
+	*wait = airtime;
+
+	return best;
+}
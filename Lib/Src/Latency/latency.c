@@ -0,0 +1,253 @@
+/*
+ * latency.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Latency/latency.h"
+#include "Stats/stats.h"
+#include "MemBudget/mem_budget.h"
+
+#include "main.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* One row per stage transition plus the two end to end totals */
+#define LATENCY_ROW_LINE_TO_SET_TX (LATENCY_STAGE_COUNT - 1)
+#define LATENCY_ROW_LINE_TO_TX_DONE (LATENCY_STAGE_COUNT)
+#define LATENCY_ROWS (LATENCY_STAGE_COUNT + 1)
+
+#define LATENCY_BAR_WIDTH 20
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	volatile uint32_t seq; /* Slot index + 1, written last so the reader can tell a complete entry */
+	uint32_t cycles;
+	uint8_t stage;
+} LatencyEvent_t;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min, max;
+	uint64_t sum;
+	uint32_t buckets[LATENCY_BUCKETS];
+} LatencyHist_t;
+
+/********************************
+ * Static Variables
+ ********************************/
+/* Multi producer ring, producers claim a slot with an atomic increment and never block */
+static LatencyEvent_t ring[LATENCY_RING_SIZE];
+static volatile uint32_t ringHead = 0;
+static uint32_t ringTail = 0;
+static uint32_t eventsLost = 0;
+
+static LatencyHist_t hist[LATENCY_ROWS];
+
+/* Transaction currently being followed by the reader */
+static int8_t txnStage = -1;
+static uint8_t txnFromLine;
+static uint32_t txnStart, txnLast;
+
+/* Report cursor */
+static uint32_t lineRow, lineBucket;
+
+static const char *const rowNames[LATENCY_ROWS] = {
+	"line -> dequeue",
+	"dequeue -> handler",
+	"handler -> Send",
+	"Send -> SetTx",
+	"SetTx -> TxDone",
+	"line -> SetTx",
+	"line -> TxDone",
+};
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t latencyBucket(uint32_t us) {
+	uint32_t bucket = 0;
+
+	while (us > 1 && bucket < LATENCY_BUCKETS - 1) {
+		us >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+static void latencyRecord(uint32_t row, uint32_t cycles) {
+	LatencyHist_t *h = &hist[row];
+	uint32_t us = cycles / (SystemCoreClock / 1000000);
+
+	if (h->count == 0 || us < h->min) {
+		h->min = us;
+	}
+	if (us > h->max) {
+		h->max = us;
+	}
+	h->sum += us;
+	h->count++;
+	h->buckets[latencyBucket(us)]++;
+}
+
+static void latencyProcess(uint8_t stage, uint32_t cycles) {
+	/* A CLI line always starts a new transaction, Radio.Send starts a partial one (continuous mode) */
+	if (stage == LATENCY_UART_LINE || (stage == LATENCY_RADIO_SEND && txnStage != LATENCY_HANDLER)) {
+		txnFromLine = stage == LATENCY_UART_LINE;
+		txnStage = stage;
+		txnStart = txnLast = cycles;
+		return;
+	}
+
+	/* Anything out of order belongs to someone else, stop following */
+	if (txnStage < 0 || stage != txnStage + 1) {
+		txnStage = -1;
+		return;
+	}
+
+	latencyRecord(stage - 1, cycles - txnLast);
+
+	if (txnFromLine && stage == LATENCY_SET_TX) {
+		latencyRecord(LATENCY_ROW_LINE_TO_SET_TX, cycles - txnStart);
+	}
+	if (txnFromLine && stage == LATENCY_TX_DONE) {
+		latencyRecord(LATENCY_ROW_LINE_TO_TX_DONE, cycles - txnStart);
+	}
+
+	txnStage = stage == LATENCY_TX_DONE ? -1 : stage;
+	txnLast = cycles;
+}
+
+/* @brief: Moves completed events from the ring into the histograms */
+static void latencyDrain(void) {
+	uint32_t head = __atomic_load_n(&ringHead, __ATOMIC_ACQUIRE);
+
+	/* The producers lapped the reader, the oldest events are gone */
+	if (head - ringTail > LATENCY_RING_SIZE) {
+		eventsLost += head - ringTail - LATENCY_RING_SIZE;
+		ringTail = head - LATENCY_RING_SIZE;
+		txnStage = -1;
+	}
+
+	while (ringTail != head) {
+		LatencyEvent_t *ev = &ring[ringTail % LATENCY_RING_SIZE];
+
+		uint32_t seq = __atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE);
+		if (seq != ringTail + 1) {
+			/* Claimed but not written yet (preempted producer), pick it up next time */
+			if ((int32_t) (seq - (ringTail + 1)) < 0) {
+				break;
+			}
+			eventsLost++;
+			ringTail++;
+			txnStage = -1;
+			continue;
+		}
+
+		uint8_t stage = ev->stage;
+		uint32_t cycles = ev->cycles;
+
+		/* Overwritten while being read */
+		if (__atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE) != seq) {
+			eventsLost++;
+			ringTail++;
+			txnStage = -1;
+			continue;
+		}
+
+		latencyProcess(stage, cycles);
+		ringTail++;
+	}
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Latency_Init(void) {
+	MemBudget_Register("LATENCY", "event ring", sizeof(ring));
+	MemBudget_Register("LATENCY", "histograms", sizeof(hist));
+}
+
+void Latency_Mark(LatencyStage_t stage) {
+	uint32_t cycles = (uint32_t) Stats_GetCycles();
+	uint32_t slot = __atomic_fetch_add(&ringHead, 1, __ATOMIC_RELAXED);
+	LatencyEvent_t *ev = &ring[slot % LATENCY_RING_SIZE];
+
+	ev->cycles = cycles;
+	ev->stage = stage;
+	__atomic_store_n(&ev->seq, slot + 1, __ATOMIC_RELEASE);
+}
+
+void Latency_Reset(void) {
+	latencyDrain();
+
+	memset(hist, 0, sizeof(hist));
+	eventsLost = 0;
+}
+
+uint8_t Latency_GetLine(uint32_t index, char *buf, size_t len) {
+	if (index == 0) {
+		latencyDrain();
+		lineRow = 0;
+		lineBucket = LATENCY_BUCKETS;
+		snprintf(buf, len, "Latency in us, %" PRIu32 " events lost\r\n", eventsLost);
+		return 1;
+	}
+
+	while (lineRow < LATENCY_ROWS) {
+		LatencyHist_t *h = &hist[lineRow];
+
+		/* Row summary */
+		if (lineBucket == LATENCY_BUCKETS) {
+			lineBucket = 0;
+			if (h->count == 0) {
+				snprintf(buf, len, "%-20s no samples\r\n", rowNames[lineRow]);
+				lineRow++;
+				lineBucket = LATENCY_BUCKETS;
+			} else {
+				snprintf(buf, len, "%-20s n %" PRIu32 " min %" PRIu32 " avg %" PRIu32 " max %" PRIu32 "\r\n", rowNames[lineRow], h->count, h->min,
+						(uint32_t) (h->sum / h->count), h->max);
+			}
+			return 1;
+		}
+
+		/* Non empty buckets */
+		while (lineBucket < LATENCY_BUCKETS && h->buckets[lineBucket] == 0) {
+			lineBucket++;
+		}
+		if (lineBucket == LATENCY_BUCKETS) {
+			lineRow++;
+			continue;
+		}
+
+		uint32_t lo = lineBucket == 0 ? 0 : 1UL << lineBucket;
+		uint32_t n = h->buckets[lineBucket];
+		uint32_t bar = (uint32_t) (((uint64_t) n * LATENCY_BAR_WIDTH + h->count - 1) / h->count);
+		char bars[LATENCY_BAR_WIDTH + 1];
+		memset(bars, '#', bar);
+		bars[bar] = 0;
+
+		if (lineBucket == LATENCY_BUCKETS - 1) {
+			snprintf(buf, len, "  %7" PRIu32 "+       %6" PRIu32 " %s\r\n", lo, n, bars);
+		} else {
+			snprintf(buf, len, "  %7" PRIu32 "-%-7lu %6" PRIu32 " %s\r\n", lo, (2UL << lineBucket) - 1, n, bars);
+		}
+		lineBucket++;
+		return 1;
+	}
+
+	buf[0] = 0;
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * mem_budget.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "MemBudget/mem_budget.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	const char *subsystem;
+	const char *name;
+	uint32_t bytes;
+} MemBudgetEntry_t;
+
+/********************************
+ * External Variables
+ ********************************/
+/* Linker Script Symbols */
+extern uint8_t _sdata, _ebss, _estack, _Min_Stack_Size;
+extern uint8_t _sram2, _eram2;
+
+/********************************
+ * Static Variables
+ ********************************/
+static MemBudgetEntry_t entries[MEM_BUDGET_MAX_ENTRIES];
+static uint32_t entryCount = 0;
+static uint32_t dropped = 0;		/* Registrations past the end of the table */
+
+/********************************
+ * Interface Functions
+ ********************************/
+void MemBudget_Register(const char *subsystem, const char *name, uint32_t bytes) {
+	if (entryCount == MEM_BUDGET_MAX_ENTRIES) {
+		dropped++;
+		return;
+	}
+
+	entries[entryCount].subsystem = subsystem;
+	entries[entryCount].name = name;
+	entries[entryCount].bytes = bytes;
+	entryCount++;
+}
+
+/*
+ * @brief: Writes line index of the report to buf, returns 0 on the last line.
+ * Entries are grouped by subsystem, keeping the order in which subsystems first
+ * registered, so modules initialised after boot are included.
+ */
+uint8_t MemBudget_GetLine(uint32_t index, char *buf, size_t len) {
+	uint32_t line = 1, total = 0;
+
+	if (index == 0) {
+		snprintf(buf, len, "RAM budget (bytes)\r\n");
+		return 1;
+	}
+
+	for (uint32_t i = 0; i < entryCount; i++) {
+		uint8_t seen = 0;
+		for (uint32_t j = 0; j < i; j++) {
+			if (!strcmp(entries[j].subsystem, entries[i].subsystem)) {
+				seen = 1;
+				break;
+			}
+		}
+		if (seen) {
+			continue;
+		}
+
+		uint32_t subtotal = 0;
+		for (uint32_t j = i; j < entryCount; j++) {
+			if (!strcmp(entries[j].subsystem, entries[i].subsystem)) {
+				if (line++ == index) {
+					snprintf(buf, len, "  %-8s %-16s %6" PRIu32 "\r\n", entries[j].subsystem, entries[j].name, entries[j].bytes);
+					return 1;
+				}
+				subtotal += entries[j].bytes;
+			}
+		}
+
+		if (line++ == index) {
+			snprintf(buf, len, "  %-8s %-16s %6" PRIu32 "\r\n", entries[i].subsystem, "= total", subtotal);
+			return 1;
+		}
+		total += subtotal;
+	}
+
+	switch (index - line) {
+	case 0:
+		if (dropped != 0) {
+			snprintf(buf, len, "Registered %" PRIu32 ", %" PRIu32 " more not (MEM_BUDGET_MAX_ENTRIES)\r\n", total, dropped);
+		} else {
+			snprintf(buf, len, "Registered %" PRIu32 "\r\n", total);
+		}
+		return 1;
+	case 1:
+		snprintf(buf, len, "RAM1 .data+.bss %" PRIu32 " + MSP %" PRIu32 " / %" PRIu32 "\r\n", (uint32_t) (&_ebss - &_sdata),
+				(uint32_t) &_Min_Stack_Size, (uint32_t) (&_estack - &_sdata));
+		return 1;
+	default:
+		snprintf(buf, len, "RAM2 %" PRIu32 " / %" PRIu32 "\r\n", (uint32_t) (&_eram2 - &_sram2), (uint32_t) (32 * 1024));
+		return 0;
+	}
+}
@@ -0,0 +1,231 @@
+/*
+ * ook.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Ook/ook.h"
+#include "MemBudget/mem_budget.h"
+
+#include "subghz_phy_app.h"
+
+#include <string.h>
+
+/********************************
+ * Types
+ ********************************/
+/* Packs chips MSB first, acc holds the last accBits chips not written yet */
+typedef struct {
+	uint8_t *out;
+	size_t size, len;
+	uint64_t acc;
+	uint32_t accBits;
+	uint32_t chips;
+	uint8_t full;
+} OokWriter_t;
+
+/********************************
+ * Static Variables
+ ********************************/
+/* EV1527 style: 350 us chips, 1:3 PWM, a 1:31 sync in front */
+static const OokProtocol_t defaultProtocol = {
+	.chipUs = 350,
+	.zero = { 1, 350, 1050 },
+	.one = { 1, 1050, 350 },
+	.sync = { 1, 350, 10850 },
+	.gapUs = 0,
+	.repeats = 10,
+};
+
+static OokEncoder_t encoder;
+static uint8_t chipBuf[OOK_MAX_CHIPS / 8];
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t toChips(const OokProtocol_t *protocol, uint32_t us) {
+	return (us + protocol->chipUs / 2) / protocol->chipUs;
+}
+
+/* @brief: Appends up to 56 chips, LSB aligned */
+static inline void writerPut(OokWriter_t *w, uint64_t pattern, uint32_t chips) {
+	w->acc = (w->acc << chips) | pattern;
+	w->accBits += chips;
+	w->chips += chips;
+
+	while (w->accBits >= 8) {
+		w->accBits -= 8;
+		if (w->len < w->size) {
+			w->out[w->len++] = (uint8_t) (w->acc >> w->accBits);
+		} else {
+			w->full = 1;
+		}
+	}
+}
+
+static void writerRun(OokWriter_t *w, uint8_t level, uint32_t chips) {
+	while (chips != 0) {
+		uint32_t n = chips < 32 ? chips : 32;
+		writerPut(w, level ? (1ULL << n) - 1 : 0, n);
+		chips -= n;
+	}
+}
+
+/* @brief: Pads the last byte with carrier off, returns the chip count or 0 on overflow */
+static uint32_t writerFinish(OokWriter_t *w) {
+	if (w->accBits != 0) {
+		uint32_t pad = 8 - w->accBits;
+		writerPut(w, 0, pad);
+		w->chips -= pad;
+	}
+
+	return w->full ? 0 : w->chips;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+/* @brief: Symbol patterns, then the 16 patterns of 4 symbols in a row */
+uint8_t Ook_Compile(OokEncoder_t *e, const OokProtocol_t *protocol) {
+	const OokSymbol_t *symbols[2] = { &protocol->zero, &protocol->one };
+
+	if (protocol->chipUs == 0 || protocol->repeats == 0) {
+		return 0;
+	}
+
+	e->protocol = *protocol;
+
+	for (uint8_t s = 0; s < 2; s++) {
+		uint32_t first = toChips(protocol, symbols[s]->firstUs);
+		uint32_t second = toChips(protocol, symbols[s]->secondUs);
+
+		if (first + second == 0 || first + second > OOK_MAX_SYMBOL_CHIPS) {
+			return 0;
+		}
+
+		e->symbol[s] = symbols[s]->startHigh ? ((1U << first) - 1) << second : (1U << second) - 1;
+		e->symbolChips[s] = first + second;
+	}
+
+	for (uint8_t n = 0; n < 16; n++) {
+		e->nibble[n] = 0;
+		e->nibbleChips[n] = 0;
+
+		for (int8_t bit = 3; bit >= 0; bit--) {
+			uint8_t s = (n >> bit) & 1;
+			e->nibble[n] = (e->nibble[n] << e->symbolChips[s]) | e->symbol[s];
+			e->nibbleChips[n] += e->symbolChips[s];
+		}
+	}
+
+	e->syncChips[0] = toChips(protocol, protocol->sync.firstUs);
+	e->syncChips[1] = toChips(protocol, protocol->sync.secondUs);
+	e->gapChips = toChips(protocol, protocol->gapUs);
+
+	return 1;
+}
+
+uint32_t Ook_Encode(const OokEncoder_t *e, const uint8_t *code, uint32_t bits, uint8_t *out, size_t size) {
+	OokWriter_t w = { .out = out, .size = size };
+	uint8_t syncHigh = e->protocol.sync.startHigh;
+
+	for (uint8_t r = 0; r < e->protocol.repeats && !w.full; r++) {
+		writerRun(&w, syncHigh, e->syncChips[0]);
+		writerRun(&w, !syncHigh, e->syncChips[1]);
+
+		uint32_t i = 0;
+		for (; i + 4 <= bits; i += 4) {
+			uint8_t n = (code[i >> 3] >> (4 - (i & 4))) & 0x0F;
+			writerPut(&w, e->nibble[n], e->nibbleChips[n]);
+		}
+		for (; i < bits; i++) {
+			uint8_t s = (code[i >> 3] >> (7 - (i & 7))) & 1;
+			writerPut(&w, e->symbol[s], e->symbolChips[s]);
+		}
+
+		writerRun(&w, 0, e->gapChips);
+	}
+
+	return writerFinish(&w);
+}
+
+uint32_t Ook_EncodeReference(const OokProtocol_t *protocol, const uint8_t *code, uint32_t bits, uint8_t *out, size_t size) {
+	uint32_t chips = 0;
+
+	memset(out, 0, size);
+
+	for (uint8_t r = 0; r < protocol->repeats; r++) {
+		for (uint32_t i = 0; i <= bits + 1; i++) {
+			/* Sync, the code, then the gap */
+			const OokSymbol_t *symbol;
+			OokSymbol_t gap = { 1, 0, protocol->gapUs };
+
+			if (i == 0) {
+				symbol = &protocol->sync;
+			} else if (i <= bits) {
+				uint8_t bit = (code[(i - 1) >> 3] >> (7 - ((i - 1) & 7))) & 1;
+				symbol = bit ? &protocol->one : &protocol->zero;
+			} else {
+				symbol = &gap;
+			}
+
+			uint32_t first = toChips(protocol, symbol->firstUs);
+			uint32_t total = first + toChips(protocol, symbol->secondUs);
+
+			for (uint32_t c = 0; c < total; c++, chips++) {
+				uint8_t on = (c < first) == (symbol->startHigh != 0);
+				if (chips / 8 >= size) {
+					return 0;
+				}
+				out[chips / 8] |= on << (7 - chips % 8);
+			}
+		}
+	}
+
+	return chips;
+}
+
+uint8_t Ook_SetProtocol(const OokProtocol_t *protocol) {
+	OokEncoder_t candidate;
+
+	/* 600 bps is the lowest FSK bit rate, each chip is a bit of the 2-FSK fallback */
+	if (protocol->chipUs < 2 || protocol->chipUs > 1666 || !Ook_Compile(&candidate, protocol)) {
+		return 0;
+	}
+
+	encoder = candidate;
+
+	return 1;
+}
+
+void Ook_Init(void) {
+	Ook_SetProtocol(&defaultProtocol);
+
+	MemBudget_Register("OOK", "encoder + chips", sizeof(encoder) + sizeof(chipBuf));
+}
+
+const OokProtocol_t *Ook_GetProtocol(void) {
+	return &encoder.protocol;
+}
+
+uint32_t Ook_Send(const uint8_t *code, uint32_t bits) {
+	/* A keyed frame reads chipBuf until it ended */
+	if (SubghzApp_OokActive()) {
+		return OOK_SEND_BUSY;
+	}
+
+	uint32_t chips = Ook_Encode(&encoder, code, bits, chipBuf, sizeof(chipBuf));
+	if (chips == 0) {
+		return 0;
+	}
+
+	if (!SubghzApp_SendOok(chipBuf, chips, encoder.protocol.chipUs)) {
+		return OOK_SEND_BUSY;
+	}
+
+	return chips;
+}
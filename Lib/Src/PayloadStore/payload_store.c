@@ -0,0 +1,171 @@
+/*
+ * payload_store.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "PayloadStore/payload_store.h"
+#include "MemBudget/mem_budget.h"
+#include "Flash/flash.h"
+
+#include "stm32wlxx_hal.h"
+
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* The index holds record offsets in double words, a 16 bit offset covers 512K */
+#define STORE_ALIGN FLASH_ALIGN
+#define STORE_NONE 0xFFFF
+
+/********************************
+ * Static Variables
+ ********************************/
+/* PAYLOADS region of the linker script */
+extern uint8_t _spayload_store[], _epayload_store[];
+
+static uint16_t storeIndex[PAYLOAD_STORE_MAX_IDS];
+
+/* Offset of the end of the log, the next record goes there */
+static uint32_t logEnd = 0;
+static uint32_t logRecords = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t storeSize(void) {
+	return _epayload_store - _spayload_store;
+}
+
+static const PayloadRecord_t *recordAt(uint32_t offset) {
+	return (const PayloadRecord_t *) (_spayload_store + offset);
+}
+
+static uint32_t recordSize(uint8_t payloadSize) {
+	return sizeof(PayloadRecord_t) + (payloadSize + STORE_ALIGN - 1) / STORE_ALIGN * STORE_ALIGN;
+}
+
+/*
+ * @brief: Appends a record. The header goes first, a payload cut short by a
+ * reset fails its CRC at the next boot and is skipped.
+ */
+static uint8_t append(uint8_t id, const uint8_t *data, uint8_t size) {
+	PayloadRecord_t record = {
+		.magic = PAYLOAD_STORE_MAGIC,
+		.id = id,
+		.size = size,
+		.crc = Flash_Crc16(data, size),
+		.check = ~(id | size << 8),
+	};
+
+	if (id >= PAYLOAD_STORE_MAX_IDS || logEnd + recordSize(size) > storeSize()) {
+		return 0;
+	}
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+	uint8_t ok = Flash_Program(_spayload_store + logEnd, (const uint8_t *) &record, sizeof(record))
+			&& Flash_Program(_spayload_store + logEnd + sizeof(record), data, size);
+	HAL_FLASH_Lock();
+
+	/* A failed record still takes its space */
+	uint32_t offset = logEnd;
+	logEnd += recordSize(size);
+	logRecords++;
+
+	if (!ok) {
+		return 0;
+	}
+
+	storeIndex[id] = size != 0 ? offset / STORE_ALIGN : STORE_NONE;
+
+	return 1;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void PayloadStore_Init(void) {
+	uint32_t offset = 0;
+
+	memset(storeIndex, 0xFF, sizeof(storeIndex));
+	logRecords = 0;
+
+	/* The log ends at the first erased header */
+	while (offset + sizeof(PayloadRecord_t) <= storeSize() && !Flash_IsErased(_spayload_store + offset, sizeof(PayloadRecord_t))) {
+		const PayloadRecord_t *record = recordAt(offset);
+
+		if (record->magic != PAYLOAD_STORE_MAGIC || record->check != (uint16_t) ~(record->id | record->size << 8)) {
+			/* Not a header, nothing after it can be trusted */
+			offset = storeSize();
+			break;
+		}
+
+		if (record->id < PAYLOAD_STORE_MAX_IDS && Flash_Crc16((const uint8_t *) (record + 1), record->size) == record->crc) {
+			storeIndex[record->id] = record->size != 0 ? offset / STORE_ALIGN : STORE_NONE;
+		}
+
+		offset += recordSize(record->size);
+		logRecords++;
+	}
+
+	logEnd = offset < storeSize() ? offset : storeSize();
+
+	MemBudget_Register("STORE", "index", sizeof(storeIndex));
+}
+
+uint8_t PayloadStore_Add(uint8_t id, const uint8_t *data, uint8_t size) {
+	return size != 0 && append(id, data, size);
+}
+
+uint8_t PayloadStore_Delete(uint8_t id) {
+	if (id >= PAYLOAD_STORE_MAX_IDS || storeIndex[id] == STORE_NONE) {
+		return 0;
+	}
+
+	return append(id, NULL, 0);
+}
+
+/*
+ * @brief: Erases the pages of the store, every payload is gone
+ */
+uint8_t PayloadStore_Erase(void) {
+	memset(storeIndex, 0xFF, sizeof(storeIndex));
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+	uint8_t ok = Flash_ErasePages(_spayload_store, storeSize() / FLASH_PAGE_SIZE);
+	HAL_FLASH_Lock();
+
+	logEnd = 0;
+	logRecords = 0;
+
+	return ok && Flash_IsErased(_spayload_store, storeSize());
+}
+
+const uint8_t *PayloadStore_Get(uint8_t id, uint8_t *size) {
+	if (id >= PAYLOAD_STORE_MAX_IDS || storeIndex[id] == STORE_NONE) {
+		return NULL;
+	}
+
+	const PayloadRecord_t *record = recordAt(storeIndex[id] * STORE_ALIGN);
+	*size = record->size;
+
+	return (const uint8_t *) (record + 1);
+}
+
+void PayloadStore_GetUsage(PayloadStoreUsage_t *usage) {
+	usage->payloads = 0;
+	for (uint32_t id = 0; id < PAYLOAD_STORE_MAX_IDS; id++) {
+		usage->payloads += storeIndex[id] != STORE_NONE;
+	}
+
+	usage->records = logRecords;
+	usage->used = logEnd;
+	usage->size = storeSize();
+}
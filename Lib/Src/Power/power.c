@@ -0,0 +1,218 @@
+/*
+ * power.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Power/power.h"
+#include "Stats/stats.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32_lpm.h"
+#include "utilities_def.h"
+
+#include "main.h"
+#include "stm32wlxx_hal.h"
+#include "stm32wlxx_ll_rcc.h"
+#include "stm32wlxx_ll_rtc.h"
+#include "stm32wlxx_ll_exti.h"
+
+/********************************
+ * Defines
+ ********************************/
+/* LSE (32768 Hz) / (PREDIV_A + 1) = 1024 Hz binary counter */
+#define POWER_RTC_PREDIV_A 31
+#define POWER_RTC_FREQ 1024
+
+/* The alarm has to be armed at least this many RTC ticks ahead of the counter */
+#define POWER_RTC_ALARM_MARGIN 2
+
+/* Upper bound on a single tickless period, keeps the tick arithmetic well within 32 bits */
+#define POWER_MAX_IDLE_TICKS (60 * configTICK_RATE_HZ)
+
+/********************************
+ * Static Variables
+ ********************************/
+static volatile uint8_t powerReady = 0;
+
+static uint32_t rtcBoot;
+static uint32_t tickRemainder; /* Fraction of a kernel tick (in 1/POWER_RTC_FREQ units) carried between sleeps */
+
+static uint64_t sleepRtcTicks = 0, stop2RtcTicks = 0;
+static uint32_t sleepCount = 0, stop2Count = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint32_t powerRtcGetCounter(void) {
+	uint32_t ssr;
+
+	/* The binary counter is asynchronous to the APB clock, read until two reads agree */
+	do {
+		ssr = LL_RTC_TIME_GetSubSecond(RTC);
+	} while (ssr != LL_RTC_TIME_GetSubSecond(RTC));
+
+	/* SSR counts down, invert it so elapsed time is a plain subtraction */
+	return ~ssr;
+}
+
+static void powerRtcSetAlarm(uint32_t counter) {
+	LL_RTC_DisableWriteProtection(RTC);
+
+	LL_RTC_ALMA_Disable(RTC);
+	LL_RTC_ClearFlag_ALRA(RTC);
+	LL_RTC_ALMA_SetSubSecond(RTC, ~counter);
+	LL_RTC_EnableIT_ALRA(RTC);
+	LL_RTC_ALMA_Enable(RTC);
+
+	LL_RTC_EnableWriteProtection(RTC);
+}
+
+static void powerRtcStopAlarm(void) {
+	LL_RTC_DisableWriteProtection(RTC);
+
+	LL_RTC_ALMA_Disable(RTC);
+	LL_RTC_DisableIT_ALRA(RTC);
+	LL_RTC_ClearFlag_ALRA(RTC);
+
+	LL_RTC_EnableWriteProtection(RTC);
+
+	HAL_NVIC_ClearPendingIRQ(RTC_Alarm_IRQn);
+}
+
+/********************************
+ * FreeRTOS Hooks
+ ********************************/
+/* @brief: Replaces the port's SysTick based tickless idle (configUSE_TICKLESS_IDLE == 2).
+ * SysTick stops in STOP2, so the RTC binary counter is used both to wake the core
+ * up and to measure how long it was asleep. */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+	if (!powerReady) {
+		return;
+	}
+
+	if (xExpectedIdleTime > POWER_MAX_IDLE_TICKS) {
+		xExpectedIdleTime = POWER_MAX_IDLE_TICKS;
+	}
+
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	/* A task may have been readied or a context switch requested since the scheduler was suspended */
+	if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+		__enable_irq();
+		return;
+	}
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	uint32_t start = powerRtcGetCounter();
+	uint32_t alarmTicks = ((uint64_t) xExpectedIdleTime * POWER_RTC_FREQ) / configTICK_RATE_HZ;
+	if (alarmTicks < POWER_RTC_ALARM_MARGIN) {
+		alarmTicks = POWER_RTC_ALARM_MARGIN;
+	}
+	powerRtcSetAlarm(start + alarmTicks);
+
+	/* Enter SLEEP or STOP2 depending on who currently blocks stop mode */
+	UTIL_LPM_Mode_t mode = UTIL_LPM_GetMode();
+	UTIL_LPM_EnterLowPower();
+
+	uint32_t elapsed = powerRtcGetCounter() - start;
+	powerRtcStopAlarm();
+
+	Stats_AddSleepTime(((uint64_t) elapsed * 1000000) / POWER_RTC_FREQ);
+
+	if (mode == UTIL_LPM_STOPMODE) {
+		stop2RtcTicks += elapsed;
+		stop2Count++;
+	} else {
+		sleepRtcTicks += elapsed;
+		sleepCount++;
+	}
+
+	/* Convert RTC ticks to kernel ticks, carrying the fraction over to the next sleep */
+	uint64_t scaled = (uint64_t) elapsed * configTICK_RATE_HZ + tickRemainder;
+	TickType_t completeTicks = scaled / POWER_RTC_FREQ;
+	tickRemainder = scaled % POWER_RTC_FREQ;
+
+	/* The final tick is left to the SysTick handler so the unblocked task is processed normally */
+	if (completeTicks >= xExpectedIdleTime) {
+		completeTicks = xExpectedIdleTime - 1;
+		tickRemainder = 0;
+	}
+	vTaskStepTick(completeTicks);
+
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	__enable_irq();
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Power_Init(void) {
+	/* RTC kernel clock from the LSE started in SystemClock_Config */
+	HAL_PWR_EnableBkUpAccess();
+	LL_RCC_SetRTCClockSource(LL_RCC_RTC_CLKSOURCE_LSE);
+	LL_RCC_EnableRTC();
+	__HAL_RCC_RTCAPB_CLK_ENABLE();
+
+	LL_RTC_DisableWriteProtection(RTC);
+
+	LL_RTC_EnableInitMode(RTC);
+	while (!LL_RTC_IsActiveFlag_INIT(RTC));
+	LL_RTC_SetBinaryMode(RTC, LL_RTC_BINARY_ONLY);
+	LL_RTC_SetAsynchPrescaler(RTC, POWER_RTC_PREDIV_A);
+	LL_RTC_DisableInitMode(RTC);
+
+	/* Read the counter directly, the shadow registers are stale after STOP2 */
+	LL_RTC_EnableShadowRegBypass(RTC);
+
+	/* Alarm A fires on a full 32 bit match of the binary counter */
+	LL_RTC_ALMA_Disable(RTC);
+	LL_RTC_ALMA_SetMask(RTC, LL_RTC_ALMA_MASK_ALL);
+	LL_RTC_ALMA_SetSubSecondMask(RTC, 32);
+	LL_RTC_ALMA_SetBinAutoClr(RTC, LL_RTC_ALMA_SUBSECONDBIN_AUTOCLR_NO);
+
+	LL_RTC_EnableWriteProtection(RTC);
+
+	/* STOP2 wakeup sources: RTC alarm, USART2 and the radio */
+	LL_EXTI_EnableIT_0_31(LL_EXTI_LINE_17 | LL_EXTI_LINE_27);
+	LL_EXTI_EnableIT_32_63(LL_EXTI_LINE_44);
+
+	HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+
+	UTIL_LPM_Init();
+	UTIL_LPM_SetOffMode((1 << CFG_LPM_APPLI_Id), UTIL_LPM_DISABLE);
+
+	rtcBoot = powerRtcGetCounter();
+	powerReady = 1;
+}
+
+void Power_GetStats(PowerStats_t *stats) {
+	taskENTER_CRITICAL();
+	uint64_t total = powerRtcGetCounter() - rtcBoot;
+	uint64_t sleep = sleepRtcTicks;
+	uint64_t stop2 = stop2RtcTicks;
+	stats->sleepCount = sleepCount;
+	stats->stop2Count = stop2Count;
+	taskEXIT_CRITICAL();
+
+	stats->sleepMs = sleep * 1000 / POWER_RTC_FREQ;
+	stats->stop2Ms = stop2 * 1000 / POWER_RTC_FREQ;
+	stats->runMs = (total - sleep - stop2) * 1000 / POWER_RTC_FREQ;
+}
+
+void Power_AlarmIRQHandler(void) {
+	/* Only used to wake the core, the elapsed time is measured by vPortSuppressTicksAndSleep */
+	LL_RTC_ClearFlag_ALRA(RTC);
+}
@@ -0,0 +1,253 @@
+/*
+ * stats.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Stats/stats.h"
+#include "MemBudget/mem_budget.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+
+#include "main.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/********************************
+ * Defines
+ ********************************/
+/* Run time counter = CPU cycles >> STATS_CYCLE_SHIFT, 750 kHz at 48 MHz.
+ * The 32 bit FreeRTOS counter then wraps every ~95 min instead of every 89 s. */
+#define STATS_CYCLE_SHIFT 6
+
+/********************************
+ * Types
+ ********************************/
+typedef struct {
+	const char *name;
+	osMessageQueueId_t queue;
+	uint32_t peak;
+	uint32_t drops;				/* Messages lost because the queue was full */
+} StatsQueue_t;
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint32_t cycLast = 0;
+static uint64_t cycHigh = 0;
+static uint64_t cycSleep = 0; /* The cycle counter is halted in SLEEP/STOP2, credited by the power module */
+
+static volatile uint32_t irqCount[STATS_IRQ_COUNT];
+static volatile uint32_t traceOverruns = 0;
+static const char *const irqNames[STATS_IRQ_COUNT] = {
+	[STATS_IRQ_USART2] = "USART2",
+	[STATS_IRQ_TIM1] = "TIM1",
+	[STATS_IRQ_SUBGHZ] = "SUBGHZ",
+};
+
+/* CLI command turnaround, line received to response and prompt queued */
+static uint32_t turnaroundMin = UINT32_MAX, turnaroundMax = 0, turnaroundCount = 0;
+static uint64_t turnaroundSum = 0;
+
+static StatsQueue_t queues[STATS_MAX_QUEUES];
+static uint32_t queueCount = 0;
+
+/* Task snapshot, CPU usage is reported over the interval between two reports */
+static TaskStatus_t tasks[STATS_MAX_TASKS];
+static UBaseType_t taskCount;
+static uint32_t taskDelta[STATS_MAX_TASKS];
+static uint32_t totalDelta;
+
+static UBaseType_t prevNumber[STATS_MAX_TASKS];
+static uint32_t prevRunTime[STATS_MAX_TASKS];
+static UBaseType_t prevCount = 0;
+static uint32_t prevTotal = 0;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint64_t statsCycles(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* Extend to 64 bits, the counter is sampled on every context switch, well within one wrap */
+	uint32_t now = DWT->CYCCNT;
+	if (now < cycLast) {
+		cycHigh += 1ULL << 32;
+	}
+	cycLast = now;
+	uint64_t cycles = cycHigh + now + cycSleep;
+
+	__set_PRIMASK(primask);
+
+	return cycles;
+}
+
+static void statsSnapshot(void) {
+	uint32_t total;
+
+	taskCount = uxTaskGetSystemState(tasks, STATS_MAX_TASKS, &total);
+	totalDelta = total - prevTotal;
+
+	for (UBaseType_t i = 0; i < taskCount; i++) {
+		uint32_t prev = 0;
+		for (UBaseType_t j = 0; j < prevCount; j++) {
+			if (prevNumber[j] == tasks[i].xTaskNumber) {
+				prev = prevRunTime[j];
+				break;
+			}
+		}
+		taskDelta[i] = tasks[i].ulRunTimeCounter - prev;
+	}
+
+	for (UBaseType_t i = 0; i < taskCount; i++) {
+		prevNumber[i] = tasks[i].xTaskNumber;
+		prevRunTime[i] = tasks[i].ulRunTimeCounter;
+	}
+	prevCount = taskCount;
+	prevTotal = total;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Stats_Init(void) {
+	MemBudget_Register("STATS", "task snapshots", sizeof(tasks) + sizeof(taskDelta) + sizeof(prevNumber) + sizeof(prevRunTime));
+	MemBudget_Register("STATS", "queues", sizeof(queues));
+	MemBudget_Register("STATS", "counters", sizeof(irqCount) + sizeof(cycHigh) + sizeof(cycSleep) + sizeof(turnaroundSum));
+}
+
+void Stats_InitRunTimeCounter(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t Stats_GetRunTimeCounter(void) {
+	return (uint32_t) (statsCycles() >> STATS_CYCLE_SHIFT);
+}
+
+uint64_t Stats_GetCycles(void) {
+	return statsCycles();
+}
+
+void Stats_AddSleepTime(uint32_t us) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	cycSleep += (uint64_t) us * (SystemCoreClock / 1000000);
+
+	__set_PRIMASK(primask);
+
+	/* Resample straight away so a wrap during a long sleep is not missed */
+	Stats_GetRunTimeCounter();
+}
+
+void Stats_CountIrq(StatsIrq_t irq) {
+	irqCount[irq]++;
+}
+
+void Stats_RecordTurnaround(uint32_t cycles) {
+	uint32_t us = cycles / (SystemCoreClock / 1000000);
+
+	if (us < turnaroundMin) {
+		turnaroundMin = us;
+	}
+	if (us > turnaroundMax) {
+		turnaroundMax = us;
+	}
+	turnaroundSum += us;
+	turnaroundCount++;
+}
+
+void Stats_CountTraceOverrun(void) {
+	traceOverruns++;
+}
+
+void Stats_RegisterQueue(const char *name, void *queue) {
+	if (queueCount == STATS_MAX_QUEUES) {
+		return;
+	}
+
+	queues[queueCount].name = name;
+	queues[queueCount].queue = queue;
+	queues[queueCount].peak = 0;
+	queues[queueCount].drops = 0;
+	queueCount++;
+}
+
+void Stats_SampleQueue(void *queue) {
+	for (uint32_t i = 0; i < queueCount; i++) {
+		if (queues[i].queue == queue) {
+			uint32_t count = osMessageQueueGetCount(queue);
+			if (count > queues[i].peak) {
+				queues[i].peak = count;
+			}
+			return;
+		}
+	}
+}
+
+void Stats_CountQueueDrop(void *queue) {
+	for (uint32_t i = 0; i < queueCount; i++) {
+		if (queues[i].queue == queue) {
+			queues[i].drops++;
+			return;
+		}
+	}
+}
+
+uint8_t Stats_GetLine(uint32_t index, char *buf, size_t len) {
+	if (index == 0) {
+		statsSnapshot();
+		snprintf(buf, len, "%-16s %6s %10s\r\n", "Task", "CPU%", "Min free");
+		return 1;
+	}
+	index--;
+
+	if (index < taskCount) {
+		uint32_t permille = totalDelta ? (uint32_t) (((uint64_t) taskDelta[index] * 1000) / totalDelta) : 0;
+		snprintf(buf, len, "%-16s %3" PRIu32 ".%" PRIu32 "%% %10u\r\n", tasks[index].pcTaskName, permille / 10, permille % 10,
+				(unsigned int) (tasks[index].usStackHighWaterMark * sizeof(StackType_t)));
+		return 1;
+	}
+	index -= taskCount;
+
+	if (index == 0) {
+		snprintf(buf, len, "Heap free %u, min ever %u of %u\r\n", (unsigned int) xPortGetFreeHeapSize(),
+				(unsigned int) xPortGetMinimumEverFreeHeapSize(), (unsigned int) configTOTAL_HEAP_SIZE);
+		return 1;
+	}
+	index--;
+
+	if (index < queueCount) {
+		snprintf(buf, len, "%s %" PRIu32 "/%" PRIu32 ", peak %" PRIu32 ", drops %" PRIu32 "\r\n", queues[index].name, osMessageQueueGetCount(queues[index].queue),
+				osMessageQueueGetCapacity(queues[index].queue), queues[index].peak, queues[index].drops);
+		return 1;
+	}
+	index -= queueCount;
+
+	if (index == 0) {
+		if (turnaroundCount == 0) {
+			snprintf(buf, len, "CLI turnaround: no commands yet\r\n");
+		} else {
+			snprintf(buf, len, "CLI turnaround us min %" PRIu32 " avg %" PRIu32 " max %" PRIu32 " (%" PRIu32 " cmds)\r\n", turnaroundMin,
+					(uint32_t) (turnaroundSum / turnaroundCount), turnaroundMax, turnaroundCount);
+		}
+		return 1;
+	}
+
+	snprintf(buf, len, "IRQ %s %" PRIu32 " | %s %" PRIu32 " | %s %" PRIu32 " | trace drops %" PRIu32 "\r\n",
+			irqNames[STATS_IRQ_USART2], irqCount[STATS_IRQ_USART2],
+			irqNames[STATS_IRQ_TIM1], irqCount[STATS_IRQ_TIM1],
+			irqNames[STATS_IRQ_SUBGHZ], irqCount[STATS_IRQ_SUBGHZ], traceOverruns);
+	return 0;
+}
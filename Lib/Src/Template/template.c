@@ -0,0 +1,315 @@
+/*
+ * template.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Template/template.h"
+#include "MemBudget/mem_budget.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/********************************
+ * Defines
+ ********************************/
+#define TEMPLATE_DEFAULT_SEED 0x2545F491
+
+/********************************
+ * Static Variables
+ ********************************/
+static TemplateProgram_t program;
+static TemplateState_t state;
+
+/* Compiled outside the critical section, the CLI stack has no room for it */
+static TemplateProgram_t candidate;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint8_t hexDigit(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	c |= 0x20;
+	return c >= 'a' && c <= 'f' ? c - 'a' + 10 : 0xFF;
+}
+
+/* @brief: Matches <name><bits>[le] with bits a multiple of 8 up to 32, returns the rest of the field or NULL */
+static const char *parseSized(const char *p, const char *end, const char *name, uint8_t *width) {
+	size_t len = strlen(name);
+	uint32_t bits = 0;
+
+	if ((size_t) (end - p) <= len || strncmp(p, name, len)) {
+		return NULL;
+	}
+
+	for (p += len; p < end && *p >= '0' && *p <= '9'; p++) {
+		bits = bits * 10 + (*p - '0');
+	}
+
+	if (bits == 0 || bits % 8 || bits > 32) {
+		return NULL;
+	}
+
+	*width = bits / 8;
+	if (end - p >= 2 && !strncmp(p, "le", 2)) {
+		*width |= TEMPLATE_LITTLE_ENDIAN;
+		p += 2;
+	}
+
+	return p;
+}
+
+/* @brief: Optional :<number>, returns the rest of the field or NULL on junk */
+static const char *parseArg(const char *p, const char *end, uint32_t *value) {
+	char *next;
+
+	if (p == end || *p != ':') {
+		return p;
+	}
+
+	*value = strtoul(p + 1, &next, 0);
+
+	return next > p + 1 && next <= end ? next : NULL;
+}
+
+static uint8_t addOp(TemplateProgram_t *p, uint8_t opcode, uint8_t width, uint8_t arg) {
+	uint8_t bytes = width & TEMPLATE_WIDTH_MASK;
+
+	if (p->opCount >= TEMPLATE_MAX_OPS || p->size + bytes > TEMPLATE_MAX_PAYLOAD) {
+		return 0;
+	}
+
+	p->ops[p->opCount++] = (TemplateOp_t) { opcode, p->size, width, arg };
+	p->size += bytes;
+
+	return 1;
+}
+
+static uint8_t compileField(TemplateProgram_t *p, const char *field, const char *end) {
+	uint8_t width;
+	uint32_t a = 0, b = 1;
+	const char *rest;
+
+	if (end - field > 2 && field[0] == '0' && (field[1] | 0x20) == 'x') {
+		if ((end - field) % 2 || p->size + (end - field - 2) / 2 > TEMPLATE_MAX_PAYLOAD) {
+			return 0;
+		}
+
+		for (const char *c = field + 2; c < end; c += 2) {
+			uint8_t high = hexDigit(c[0]), low = hexDigit(c[1]);
+			if (high > 0x0F || low > 0x0F) {
+				return 0;
+			}
+			p->image[p->size++] = high << 4 | low;
+		}
+
+		return 1;
+	} else if (field[0] == '\'') {
+		if (end - field < 2 || p->size + (end - field - 1) > TEMPLATE_MAX_PAYLOAD) {
+			return 0;
+		}
+
+		memcpy(&p->image[p->size], field + 1, end - field - 1);
+		p->size += end - field - 1;
+
+		return 1;
+	} else if (end - field == 3 && !strncmp(field, "len", 3)) {
+		return addOp(p, TEMPLATE_OP_LENGTH, 1, 0);
+	} else if ((rest = parseSized(field, end, "seq", &width)) != NULL) {
+		a = 0;
+		rest = parseArg(rest, end, &a);
+		rest = rest != NULL ? parseArg(rest, end, &b) : NULL;
+
+		if (rest != end || p->counterCount >= TEMPLATE_MAX_COUNTERS) {
+			return 0;
+		}
+
+		p->counters[p->counterCount] = (TemplateCounter_t) { a, b };
+		return addOp(p, TEMPLATE_OP_SEQ, width, p->counterCount++);
+	} else if ((rest = parseSized(field, end, "time", &width)) != NULL) {
+		return rest == end && (width & TEMPLATE_WIDTH_MASK) >= 2 && addOp(p, TEMPLATE_OP_TIME, width, 0);
+	} else if (end - field > 4 && !strncmp(field, "rand", 4)) {
+		char *next;
+		uint32_t bytes = strtoul(field + 4, &next, 10);
+
+		return next == end && bytes > 0 && bytes <= TEMPLATE_MAX_PAYLOAD && addOp(p, TEMPLATE_OP_RANDOM, bytes, 0);
+	} else if ((rest = parseSized(field, end, "sum", &width)) != NULL
+			|| (rest = parseSized(field, end, "xor", &width)) != NULL) {
+		uint8_t opcode = field[0] == 's' ? TEMPLATE_OP_SUM : TEMPLATE_OP_XOR;
+
+		rest = parseArg(rest, end, &a);
+
+		if (rest != end || a >= p->size || (width & TEMPLATE_WIDTH_MASK) > 2 || (opcode == TEMPLATE_OP_XOR && width != 1)) {
+			return 0;
+		}
+
+		return addOp(p, opcode, width, a);
+	}
+
+	return 0;
+}
+
+/* @brief: xorshift32, Radio.Random is far too slow to call per packet */
+static inline uint32_t nextRandom(TemplateState_t *s) {
+	uint32_t x = s->random;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return s->random = x;
+}
+
+static inline void putValue(uint8_t *out, uint32_t value, uint8_t width) {
+	uint8_t bytes = width & TEMPLATE_WIDTH_MASK;
+
+	for (uint8_t i = 0; i < bytes; i++) {
+		out[width & TEMPLATE_LITTLE_ENDIAN ? i : bytes - 1 - i] = value;
+		value >>= 8;
+	}
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+uint8_t Template_Compile(TemplateProgram_t *p, const char *spec) {
+	memset(p, 0, sizeof(*p));
+
+	for (const char *field = spec; *field != '\0';) {
+		const char *end = field;
+
+		while (*end != '\0' && *end != ' ') {
+			end++;
+		}
+
+		if (end != field && !compileField(p, field, end)) {
+			return 0;
+		}
+
+		field = *end == ' ' ? end + 1 : end;
+	}
+
+	/* The length is only known now, it is a literal from here on */
+	uint8_t ops = 0;
+	for (uint8_t i = 0; i < p->opCount; i++) {
+		if (p->ops[i].opcode == TEMPLATE_OP_LENGTH) {
+			p->image[p->ops[i].offset] = p->size;
+		} else {
+			p->ops[ops++] = p->ops[i];
+		}
+	}
+	p->opCount = ops;
+
+	return p->size != 0;
+}
+
+void Template_Reset(const TemplateProgram_t *p, TemplateState_t *s, uint32_t seed) {
+	for (uint8_t i = 0; i < p->counterCount; i++) {
+		s->counter[i] = p->counters[i].start;
+	}
+
+	s->random = seed != 0 ? seed : TEMPLATE_DEFAULT_SEED;
+	s->packets = 0;
+}
+
+uint8_t Template_Evaluate(const TemplateProgram_t *p, TemplateState_t *s, uint32_t nowMs, uint8_t *out) {
+	memcpy(out, p->image, p->size);
+
+	for (const TemplateOp_t *op = p->ops; op < &p->ops[p->opCount]; op++) {
+		uint32_t value = 0;
+
+		switch (op->opcode) {
+		case TEMPLATE_OP_SEQ:
+			value = s->counter[op->arg];
+			s->counter[op->arg] += p->counters[op->arg].step;
+			break;
+		case TEMPLATE_OP_TIME:
+			value = nowMs;
+			break;
+		case TEMPLATE_OP_RANDOM:
+			for (uint8_t i = 0; i < op->width; i++) {
+				if ((i & 3) == 0) {
+					value = nextRandom(s);
+				}
+				out[op->offset + i] = value;
+				value >>= 8;
+			}
+			continue;
+		case TEMPLATE_OP_SUM:
+			for (uint8_t i = op->arg; i < op->offset; i++) {
+				value += out[i];
+			}
+			break;
+		case TEMPLATE_OP_XOR:
+			for (uint8_t i = op->arg; i < op->offset; i++) {
+				value ^= out[i];
+			}
+			break;
+		}
+
+		putValue(&out[op->offset], value, op->width);
+	}
+
+	s->packets++;
+
+	return p->size;
+}
+
+void Template_Init(void) {
+	MemBudget_Register("TEMPLATE", "program + state", sizeof(program) + sizeof(candidate) + sizeof(state));
+}
+
+uint8_t Template_Set(const char *spec) {
+	if (!Template_Compile(&candidate, spec)) {
+		return 0;
+	}
+
+	/* Continuous mode evaluates from the timer task */
+	taskENTER_CRITICAL();
+	program = candidate;
+	Template_Reset(&program, &state, state.random);
+	taskEXIT_CRITICAL();
+
+	return 1;
+}
+
+void Template_Clear(void) {
+	taskENTER_CRITICAL();
+	program.size = 0;
+	taskEXIT_CRITICAL();
+}
+
+void Template_Restart(uint32_t seed) {
+	taskENTER_CRITICAL();
+	Template_Reset(&program, &state, seed);
+	taskEXIT_CRITICAL();
+}
+
+const TemplateProgram_t *Template_Get(void) {
+	return &program;
+}
+
+uint32_t Template_GetPackets(void) {
+	return state.packets;
+}
+
+uint8_t Template_Next(uint8_t *out, uint32_t nowMs) {
+	uint8_t size = 0;
+
+	taskENTER_CRITICAL();
+	if (program.size != 0) {
+		size = Template_Evaluate(&program, &state, nowMs, out);
+	}
+	taskEXIT_CRITICAL();
+
+	return size;
+}
@@ -0,0 +1,250 @@
+/*
+ * timeline.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Timeline/timeline.h"
+#include "MemBudget/mem_budget.h"
+
+#include <string.h>
+
+/********************************
+ * Global Variables
+ ********************************/
+const char *const Timeline_ActionNames[TIMELINE_ACTIONS] = {
+	[TIMELINE_FREQ] = "freq",
+	[TIMELINE_POWER] = "power",
+	[TIMELINE_PRESET] = "preset",
+	[TIMELINE_SEND] = "send",
+	[TIMELINE_RX] = "rx",
+	[TIMELINE_LOOP] = "loop",
+};
+
+/********************************
+ * Static Variables
+ ********************************/
+static TimelineEntry_t entries[TIMELINE_MAX_ENTRIES];
+static TimelineLate_t late[TIMELINE_MAX_ENTRIES];
+static uint32_t entryCount = 0;
+
+/* Entries are due at base + offset, base moves with loops and RX waits */
+static volatile uint8_t running = 0;
+static volatile uint8_t waitingRx = 0;
+static uint32_t base;
+static uint32_t next;
+static uint32_t iteration;
+static uint32_t lateMax;
+static uint32_t rxStart, rxTimeout;
+
+/********************************
+ * Static Functions
+ ********************************/
+/* @brief: Ticks from now until t, negative once t passed. The tick counter wraps. */
+static int32_t until(uint32_t t, uint32_t now) {
+	return (int32_t) (t - now);
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Timeline_Init(void) {
+	Timeline_Clear();
+
+	MemBudget_Register("TIMELINE", "entries", sizeof(entries));
+	MemBudget_Register("TIMELINE", "lateness", sizeof(late));
+}
+
+uint8_t Timeline_Add(uint32_t offset, TimelineAction_t action, uint32_t arg) {
+	const TimelineEntry_t *last = entryCount != 0 ? &entries[entryCount - 1] : NULL;
+
+	if (entryCount == TIMELINE_MAX_ENTRIES || action >= TIMELINE_ACTIONS || offset > TIMELINE_MAX_OFFSET
+			|| (last != NULL && (offset < last->offset || last->action == TIMELINE_LOOP))) {
+		return 0;
+	}
+
+	/* An iteration takes time, or a loop forever never leaves the timer */
+	if (action == TIMELINE_LOOP && offset == 0) {
+		return 0;
+	}
+
+	entries[entryCount].offset = offset;
+	entries[entryCount].action = action;
+	entries[entryCount].arg = arg;
+	entryCount++;
+
+	return 1;
+}
+
+void Timeline_Clear(void) {
+	Timeline_Stop();
+	entryCount = 0;
+}
+
+uint32_t Timeline_Count(void) {
+	return entryCount;
+}
+
+const TimelineEntry_t *Timeline_Get(uint32_t index) {
+	return index < entryCount ? &entries[index] : NULL;
+}
+
+/*
+ * @brief: Duration and airtime of the timeline without running it, with the
+ * RX entries waiting for their whole timeout
+ */
+void Timeline_DryRun(TimelineAirtime_t airtime, TimelineDryRun_t *result) {
+	uint32_t shift = 0, end = 0, onAirUntil = 0, iterations = 1;
+
+	memset(result, 0, sizeof(*result));
+
+	for (uint32_t i = 0; i < entryCount; i++) {
+		const TimelineEntry_t *entry = &entries[i];
+		uint32_t at = entry->offset + shift;
+		uint32_t length = 0;
+
+		switch (entry->action) {
+		case TIMELINE_SEND:
+			length = airtime(entry->arg);
+			result->airtime += length;
+			result->packets++;
+			result->overlaps += at < onAirUntil;
+			onAirUntil = at + length;
+			break;
+		case TIMELINE_RX:
+			length = entry->arg;
+			shift += entry->arg;
+			break;
+		case TIMELINE_LOOP:
+			/* The iteration ends at the loop, whatever is still on air */
+			end = at;
+			iterations = entry->arg;
+			result->forever = entry->arg == 0;
+			break;
+		default:
+			break;
+		}
+
+		end = at + length > end && entry->action != TIMELINE_LOOP ? at + length : end;
+	}
+
+	if (iterations > 1) {
+		result->duration = end * iterations;
+		result->airtime *= iterations;
+		result->packets *= iterations;
+		result->overlaps *= iterations;
+	} else {
+		result->duration = end;
+	}
+}
+
+uint8_t Timeline_Start(uint32_t now) {
+	if (entryCount == 0) {
+		return 0;
+	}
+
+	base = now;
+	next = 0;
+	iteration = 0;
+	lateMax = 0;
+	memset(late, 0, sizeof(late));
+	waitingRx = 0;
+	running = 1;
+
+	return 1;
+}
+
+void Timeline_Stop(void) {
+	running = 0;
+	waitingRx = 0;
+}
+
+const TimelineEntry_t *Timeline_Next(uint32_t now, uint32_t *wait) {
+	*wait = TIMELINE_NO_DEADLINE;
+
+	if (!running) {
+		return NULL;
+	}
+
+	if (waitingRx) {
+		int32_t left = until(rxStart + rxTimeout, now);
+
+		*wait = left > 0 ? left : 0;
+		return NULL;
+	}
+
+	while (next < entryCount) {
+		const TimelineEntry_t *entry = &entries[next];
+		int32_t due = until(base + entry->offset, now);
+
+		if (due > 0) {
+			*wait = due;
+			return NULL;
+		}
+
+		TimelineLate_t *entryLate = &late[next];
+
+		entryLate->runs++;
+		entryLate->lateLast = (uint32_t) -due;
+		entryLate->lateMax = entryLate->lateLast > entryLate->lateMax ? entryLate->lateLast : entryLate->lateMax;
+		entryLate->lateSum += entryLate->lateLast;
+		lateMax = entryLate->lateLast > lateMax ? entryLate->lateLast : lateMax;
+		next++;
+
+		if (entry->action == TIMELINE_LOOP) {
+			iteration++;
+			if (entry->arg != 0 && iteration >= entry->arg) {
+				break;
+			}
+
+			base += entry->offset;
+			next = 0;
+			continue;
+		}
+
+		if (entry->action == TIMELINE_RX) {
+			rxStart = now;
+			rxTimeout = entry->arg;
+			waitingRx = 1;
+			*wait = entry->arg;
+		}
+
+		return entry;
+	}
+
+	running = 0;
+
+	return NULL;
+}
+
+uint8_t Timeline_RxDone(uint32_t now) {
+	if (!running || !waitingRx) {
+		return 0;
+	}
+
+	/* Later entries keep their distance to the RX entry */
+	base += now - rxStart;
+	waitingRx = 0;
+
+	return 1;
+}
+
+uint8_t Timeline_RxExpired(uint32_t now) {
+	return running && waitingRx && until(rxStart + rxTimeout, now) <= 0;
+}
+
+void Timeline_GetStatus(TimelineStatus_t *status) {
+	status->running = running;
+	status->waitingRx = waitingRx;
+	status->index = next;
+	status->iteration = iteration;
+	status->lateMax = lateMax;
+}
+
+const TimelineLate_t *Timeline_GetLate(uint32_t index) {
+	return index < entryCount ? &late[index] : NULL;
+}
@@ -0,0 +1,195 @@
+/*
+ * upload.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "Upload/upload.h"
+#include "MemBudget/mem_budget.h"
+
+#include <stddef.h>
+
+/********************************
+ * Static Variables
+ ********************************/
+static uint8_t payload[UPLOAD_MAX_PAYLOAD];
+static volatile uint8_t payloadSize = 0;
+
+/* Raw upload, fed from the UART interrupt */
+static volatile uint8_t rawPending = 0;
+static uint32_t rawExpected;
+static uint32_t rawLastMs;
+
+/********************************
+ * Static Functions
+ ********************************/
+static uint8_t hexDigit(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	c |= 0x20;
+	return c >= 'a' && c <= 'f' ? c - 'a' + 10 : 0xFF;
+}
+
+static uint8_t base64Digit(char c) {
+	if (c >= 'A' && c <= 'Z') {
+		return c - 'A';
+	} else if (c >= 'a' && c <= 'z') {
+		return c - 'a' + 26;
+	} else if (c >= '0' && c <= '9') {
+		return c - '0' + 52;
+	} else if (c == '+') {
+		return 62;
+	} else if (c == '/') {
+		return 63;
+	}
+	return 0xFF;
+}
+
+static uint8_t isSpace(char c) {
+	return c == ' ' || c == '\t';
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void Upload_Init(void) {
+	MemBudget_Register("UPLOAD", "payload", sizeof(payload));
+}
+
+void Upload_Clear(void) {
+	rawPending = 0;
+	payloadSize = 0;
+}
+
+/*
+ * @brief: Pairs of hex digits, spaces between the pairs are skipped
+ */
+uint32_t Upload_AppendHex(const char *text, uint32_t len) {
+	uint32_t size = payloadSize;
+
+	for (uint32_t i = 0; i < len; i++) {
+		if (isSpace(text[i])) {
+			continue;
+		}
+
+		uint8_t high = hexDigit(text[i]);
+		uint8_t low = i + 1 < len ? hexDigit(text[i + 1]) : 0xFF;
+		if (high == 0xFF || low == 0xFF || size == UPLOAD_MAX_PAYLOAD) {
+			return 0;
+		}
+
+		payload[size++] = high << 4 | low;
+		i++;
+	}
+
+	uint32_t added = size - payloadSize;
+	payloadSize = size;
+
+	return added;
+}
+
+/*
+ * @brief: Standard base64 in groups of 4, the last group of a line may be padded
+ */
+uint32_t Upload_AppendBase64(const char *text, uint32_t len) {
+	uint32_t size = payloadSize;
+	uint32_t group = 0;
+	uint8_t digits = 0, padding = 0;
+
+	for (uint32_t i = 0; i < len; i++) {
+		if (isSpace(text[i])) {
+			continue;
+		}
+
+		uint8_t digit = base64Digit(text[i]);
+		if (text[i] == '=' && digits >= 2) {
+			padding++;
+			digit = 0;
+		} else if (digit == 0xFF || padding != 0) {
+			/* Nothing follows the padding */
+			return 0;
+		}
+
+		group = group << 6 | digit;
+		if (++digits < 4) {
+			continue;
+		}
+
+		uint8_t bytes = 3 - padding;
+		if (size + bytes > UPLOAD_MAX_PAYLOAD) {
+			return 0;
+		}
+		for (uint8_t b = 0; b < bytes; b++) {
+			payload[size++] = group >> (16 - 8 * b);
+		}
+
+		group = 0;
+		digits = 0;
+		padding = padding != 0 ? 0xFF : 0;
+	}
+
+	if (digits != 0 || size == payloadSize) {
+		return 0;
+	}
+
+	uint32_t added = size - payloadSize;
+	payloadSize = size;
+
+	return added;
+}
+
+uint8_t Upload_StartRaw(uint32_t size, uint32_t nowMs) {
+	if (size == 0 || size > UPLOAD_MAX_PAYLOAD) {
+		return 0;
+	}
+
+	payloadSize = 0;
+	rawExpected = size;
+	rawLastMs = nowMs;
+	rawPending = 1;
+
+	return 1;
+}
+
+uint8_t Upload_RawPending(void) {
+	return rawPending;
+}
+
+/*
+ * @brief: Stores a byte of a raw upload, from the UART interrupt. The upload is
+ * dropped when the sender went quiet, the byte then belongs to the command line.
+ */
+UploadRawResult_t Upload_RawByte(uint8_t byte, uint32_t nowMs) {
+	if (!rawPending) {
+		return UPLOAD_RAW_IDLE;
+	}
+
+	if (nowMs - rawLastMs > UPLOAD_RAW_TIMEOUT_MS) {
+		rawPending = 0;
+		payloadSize = 0;
+		return UPLOAD_RAW_IDLE;
+	}
+	rawLastMs = nowMs;
+
+	payload[payloadSize++] = byte;
+	if (payloadSize < rawExpected) {
+		return UPLOAD_RAW_MORE;
+	}
+
+	rawPending = 0;
+	return UPLOAD_RAW_DONE;
+}
+
+const uint8_t *Upload_GetData(void) {
+	return payload;
+}
+
+/* @brief: Size of the payload, 0 while a raw upload is still arriving */
+uint8_t Upload_GetSize(void) {
+	return rawPending ? 0 : payloadSize;
+}
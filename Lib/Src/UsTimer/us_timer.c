@@ -0,0 +1,118 @@
+/*
+ * us_timer.c
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "UsTimer/us_timer.h"
+
+#include "stm32_lpm.h"
+#include "utilities_def.h"
+
+#include "main.h"
+#include "stm32wlxx_hal.h"
+
+/********************************
+ * Defines
+ ********************************/
+#define US_TIMER_FREQ 1000000
+
+/********************************
+ * Static Variables
+ ********************************/
+static TIM_HandleTypeDef htim2;
+
+static UsTimerCallback_t callbacks[US_TIMER_COUNT];
+static volatile uint32_t armed = 0;			/* Bit per channel */
+
+static const uint32_t ccIt[4] = { TIM_IT_CC1, TIM_IT_CC2, TIM_IT_CC3, TIM_IT_CC4 };
+static const uint32_t ccFlag[4] = { TIM_FLAG_CC1, TIM_FLAG_CC2, TIM_FLAG_CC3, TIM_FLAG_CC4 };
+static const uint32_t ccEvent[4] = { TIM_EGR_CC1G, TIM_EGR_CC2G, TIM_EGR_CC3G, TIM_EGR_CC4G };
+
+/********************************
+ * Static Functions
+ ********************************/
+/* @brief: CCR1 to CCR4 follow each other */
+static volatile uint32_t *usTimerCompare(UsTimerChannel_t channel) {
+	return &htim2.Instance->CCR1 + channel;
+}
+
+/********************************
+ * Interface Functions
+ ********************************/
+void UsTimer_Init(void) {
+	__HAL_RCC_TIM2_CLK_ENABLE();
+
+	/* APB1 is not divided (SystemClock_Config), TIM2 runs at PCLK1 */
+	htim2.Instance = TIM2;
+	htim2.Init.Prescaler = HAL_RCC_GetPCLK1Freq() / US_TIMER_FREQ - 1;
+	htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+	htim2.Init.Period = UINT32_MAX;
+	htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	if (HAL_TIM_Base_Init(&htim2) != HAL_OK) {
+		Error_Handler();
+	}
+
+	/* The channels stay frozen outputs, only their compare flags are used */
+	HAL_NVIC_SetPriority(TIM2_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+	HAL_TIM_Base_Start(&htim2);
+}
+
+uint32_t UsTimer_Now(void) {
+	return __HAL_TIM_GET_COUNTER(&htim2);
+}
+
+void UsTimer_Start(UsTimerChannel_t channel, uint32_t at, UsTimerCallback_t callback) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	callbacks[channel] = callback;
+	*usTimerCompare(channel) = at;
+	__HAL_TIM_CLEAR_FLAG(&htim2, ccFlag[channel]);
+	__HAL_TIM_ENABLE_IT(&htim2, ccIt[channel]);
+
+	if (armed == 0) {
+		UTIL_LPM_SetStopMode((1 << CFG_LPM_US_TIMER_Id), UTIL_LPM_DISABLE);
+	}
+	armed |= 1UL << channel;
+
+	/* Passed before the compare was written, the match would only come after the wrap */
+	if ((int32_t) (at - __HAL_TIM_GET_COUNTER(&htim2)) <= 0) {
+		htim2.Instance->EGR = ccEvent[channel];
+	}
+
+	__set_PRIMASK(primask);
+}
+
+void UsTimer_Stop(UsTimerChannel_t channel) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	__HAL_TIM_DISABLE_IT(&htim2, ccIt[channel]);
+	__HAL_TIM_CLEAR_FLAG(&htim2, ccFlag[channel]);
+
+	if (armed & (1UL << channel)) {
+		armed &= ~(1UL << channel);
+		if (armed == 0) {
+			UTIL_LPM_SetStopMode((1 << CFG_LPM_US_TIMER_Id), UTIL_LPM_ENABLE);
+		}
+	}
+
+	__set_PRIMASK(primask);
+}
+
+void UsTimer_IRQHandler(void) {
+	for (uint32_t channel = 0; channel < US_TIMER_COUNT; channel++) {
+		if ((armed & (1UL << channel)) && __HAL_TIM_GET_FLAG(&htim2, ccFlag[channel])) {
+			UsTimer_Stop(channel);
+			callbacks[channel]();
+		}
+	}
+}
@@ -48,6 +48,15 @@ typedef struct xCOMMAND_LINE_INPUT
 /* For backward compatibility. */
 #define xCommandLineInput CLI_Command_Definition_t
 
+/* The list item that links a registered command into the list of commands.
+Exposed so the application can provide the storage when registering a command
+with FreeRTOS_CLIRegisterCommandStatic(). */
+typedef struct xCOMMAND_INPUT_LIST
+{
+	const CLI_Command_Definition_t *pxCommandLineDefinition;
+	struct xCOMMAND_INPUT_LIST *pxNext;
+} CLI_Definition_List_Item_t;
+
 /*
  * Register the command passed in using the pxCommandToRegister parameter.
  * Registering a command adds the command to the list of commands that are
@@ -56,6 +65,14 @@ typedef struct xCOMMAND_LINE_INPUT
  */
 BaseType_t FreeRTOS_CLIRegisterCommand( const CLI_Command_Definition_t * const pxCommandToRegister );
 
+/*
+ * Static version of FreeRTOS_CLIRegisterCommand().  The list item that links
+ * the command into the list of registered commands is provided by the caller
+ * in pxCliDefinitionListItemBuffer, so no heap memory is used.  The buffer
+ * must remain valid for as long as the command is registered.
+ */
+BaseType_t FreeRTOS_CLIRegisterCommandStatic( const CLI_Command_Definition_t * const pxCommandToRegister, CLI_Definition_List_Item_t * pxCliDefinitionListItemBuffer );
+
 /*
  * Runs the command interpreter for the command string "pcCommandInput".  Any
  * output generated by running the command will be placed into pcWriteBuffer.
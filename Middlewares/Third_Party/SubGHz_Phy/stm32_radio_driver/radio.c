@@ -477,7 +477,7 @@ static void RadioOnRxTimeoutIrq( void * context );
  * @param [in]  inBuffer      buffer with frame to encode
  * @param [in]  size          size of the payload to encode
  */
-static void payload_integration( uint8_t *outBuffer, uint8_t *inBuffer, uint8_t size);
+static void payload_integration( uint8_t *outBuffer, const uint8_t *inBuffer, uint8_t size);
 
 /*!
  * \brief Set Tx PRBS modulated wave
@@ -1788,7 +1788,11 @@ static void RadioIrqProcess( void )
     /* ST_WORKAROUND_END */
 
     TimerStop( &TxTimeoutTimer );
+#ifdef RADIO_TX_DONE_STANDBY
+    RADIO_TX_DONE_STANDBY( );
+#else
     SUBGRF_SetStandby( STDBY_RC );
+#endif /* RADIO_TX_DONE_STANDBY */
     if( ( RadioEvents != NULL ) && ( RadioEvents->TxDone != NULL ) )
     {
       RadioEvents->TxDone( );
@@ -1940,41 +1944,46 @@ static void RadioTxCw( int8_t power )
     SUBGRF_SetTxContinuousWave();
 }
 
-static void payload_integration( uint8_t *outBuffer, uint8_t *inBuffer, uint8_t size)
+/*
+ * Running parity of the inverted input, MSB first: bit n of dbpsk_integral[b]
+ * is the XOR of bits 7..n of ~b. A byte integrates to this value, flipped
+ * when the parity carried in from the previous bytes is 1.
+ */
+static const uint8_t dbpsk_integral[256] =
 {
-  uint8_t prevInt=0;
-  uint8_t currBit;
-  uint8_t index_bit;
-  uint8_t index_byte;
-  uint8_t index_bit_out;
-  uint8_t index_byte_out;
-  int i=0;
-
-  for (i=0; i<size; i++)
-  {
-    /*reverse all inputs*/
-    inBuffer[i]=~inBuffer[i];
-    /*init outBuffer*/
-    outBuffer[i]=0;
-  }
+  0xAA, 0xAB, 0xA9, 0xA8, 0xAD, 0xAC, 0xAE, 0xAF, 0xA5, 0xA4, 0xA6, 0xA7, 0xA2, 0xA3, 0xA1, 0xA0,
+  0xB5, 0xB4, 0xB6, 0xB7, 0xB2, 0xB3, 0xB1, 0xB0, 0xBA, 0xBB, 0xB9, 0xB8, 0xBD, 0xBC, 0xBE, 0xBF,
+  0x95, 0x94, 0x96, 0x97, 0x92, 0x93, 0x91, 0x90, 0x9A, 0x9B, 0x99, 0x98, 0x9D, 0x9C, 0x9E, 0x9F,
+  0x8A, 0x8B, 0x89, 0x88, 0x8D, 0x8C, 0x8E, 0x8F, 0x85, 0x84, 0x86, 0x87, 0x82, 0x83, 0x81, 0x80,
+  0xD5, 0xD4, 0xD6, 0xD7, 0xD2, 0xD3, 0xD1, 0xD0, 0xDA, 0xDB, 0xD9, 0xD8, 0xDD, 0xDC, 0xDE, 0xDF,
+  0xCA, 0xCB, 0xC9, 0xC8, 0xCD, 0xCC, 0xCE, 0xCF, 0xC5, 0xC4, 0xC6, 0xC7, 0xC2, 0xC3, 0xC1, 0xC0,
+  0xEA, 0xEB, 0xE9, 0xE8, 0xED, 0xEC, 0xEE, 0xEF, 0xE5, 0xE4, 0xE6, 0xE7, 0xE2, 0xE3, 0xE1, 0xE0,
+  0xF5, 0xF4, 0xF6, 0xF7, 0xF2, 0xF3, 0xF1, 0xF0, 0xFA, 0xFB, 0xF9, 0xF8, 0xFD, 0xFC, 0xFE, 0xFF,
+  0x55, 0x54, 0x56, 0x57, 0x52, 0x53, 0x51, 0x50, 0x5A, 0x5B, 0x59, 0x58, 0x5D, 0x5C, 0x5E, 0x5F,
+  0x4A, 0x4B, 0x49, 0x48, 0x4D, 0x4C, 0x4E, 0x4F, 0x45, 0x44, 0x46, 0x47, 0x42, 0x43, 0x41, 0x40,
+  0x6A, 0x6B, 0x69, 0x68, 0x6D, 0x6C, 0x6E, 0x6F, 0x65, 0x64, 0x66, 0x67, 0x62, 0x63, 0x61, 0x60,
+  0x75, 0x74, 0x76, 0x77, 0x72, 0x73, 0x71, 0x70, 0x7A, 0x7B, 0x79, 0x78, 0x7D, 0x7C, 0x7E, 0x7F,
+  0x2A, 0x2B, 0x29, 0x28, 0x2D, 0x2C, 0x2E, 0x2F, 0x25, 0x24, 0x26, 0x27, 0x22, 0x23, 0x21, 0x20,
+  0x35, 0x34, 0x36, 0x37, 0x32, 0x33, 0x31, 0x30, 0x3A, 0x3B, 0x39, 0x38, 0x3D, 0x3C, 0x3E, 0x3F,
+  0x15, 0x14, 0x16, 0x17, 0x12, 0x13, 0x11, 0x10, 0x1A, 0x1B, 0x19, 0x18, 0x1D, 0x1C, 0x1E, 0x1F,
+  0x0A, 0x0B, 0x09, 0x08, 0x0D, 0x0C, 0x0E, 0x0F, 0x05, 0x04, 0x06, 0x07, 0x02, 0x03, 0x01, 0x00,
+};
+
+static void payload_integration( uint8_t *outBuffer, const uint8_t *inBuffer, uint8_t size)
+{
+  uint8_t prevInt = 0;
+  int i;
 
-  for (i=0; i<size*8; i++)
+  for (i = 0; i < size; i++)
   {
-    /*index to take bit in inBuffer*/
-    index_bit = 7 - (i%8);
-    index_byte = i / 8;
-    /*index to place bit in outBuffer is shifted 1 bit rigth*/
-    index_bit_out = 7 - ((i+1)%8);
-    index_byte_out = (i+1) / 8;
-    /*extract current bit from input*/
-    currBit = (inBuffer[index_byte] >> index_bit) & 0x01; 
-    /*integration*/
-    prevInt ^= currBit;
-    /* write result integration in output*/
-    outBuffer[index_byte_out]|= (prevInt << index_bit_out);
+    uint8_t integral = dbpsk_integral[inBuffer[i]] ^ (uint8_t)(-prevInt);
+
+    /* The output is one bit behind: the carried parity, then 7 bits of this byte */
+    outBuffer[i] = (prevInt << 7) | (integral >> 1);
+    prevInt = integral & 0x01;
   }
 
-  outBuffer[size] =(prevInt<<7) | (prevInt<<6) | (( (!prevInt) & 0x01)<<5) ;
+  outBuffer[size] = (prevInt << 7) | (prevInt << 6) | (((!prevInt) & 0x01) << 5);
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -310,6 +310,9 @@ void SUBGRF_SetTx( uint32_t timeout )
     buf[1] = ( uint8_t )( ( timeout >> 8 ) & 0xFF );
     buf[2] = ( uint8_t )( timeout & 0xFF );
     SUBGRF_WriteCommand( RADIO_SET_TX, buf, 3 );
+#ifdef RADIO_LATENCY_MARK_SET_TX
+    RADIO_LATENCY_MARK_SET_TX( );
+#endif /* RADIO_LATENCY_MARK_SET_TX */
 }
 
 void SUBGRF_SetRx( uint32_t timeout )
@@ -42,7 +42,23 @@
 #include "app_version.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "MemBudget/mem_budget.h"
+#include "Latency/latency.h"
+#include "BTrace/btrace.h"
+#include "Encode/encode.h"
+#include "Ook/ook.h"
+#include "Template/template.h"
+#include "ConfigStore/config_store.h"
+#include "Jobs/jobs.h"
+#include "Timeline/timeline.h"
+#include "PayloadStore/payload_store.h"
+#include "Stats/stats.h"
+#include "UsTimer/us_timer.h"
+
+#include "radio_driver.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -58,7 +74,36 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 #define MAX_TX_BUF 64
+/* Largest payload of a packet, the encoding stage included */
+#define MAX_PAYLOAD 255
 #define SYNCWORD_MAX_LEN 8
+
+/*
+ * Streaming TX, RM0453 GFSK packet engine registers. The engine sends from the
+ * TX base address until its pointer reaches the payload length, both wrap at
+ * the end of the 256 byte buffer.
+ */
+#define SUBGHZ_REG_TX_POINTER 0x0802
+#define SUBGHZ_REG_PAYLOAD_LENGTH 0x06BB
+#define STREAM_BUF_SIZE 255
+/* Refilled each time about this many bytes left the buffer */
+#define STREAM_REFILL_BYTES 64
+
+/* Configuration the radio holds */
+#define TX_CONFIG_BASE 0			/* txConfig at TXfreq and TXpower */
+#define TX_CONFIG_ONE_OFF 1			/* OOK, stream, or a base setting changed under a job configuration */
+#define TX_CONFIG_JOB 2				/* jobFreq, jobPower and jobBitRate */
+
+/*
+ * The timeline compare is armed again at least this often, TIM2 wraps after
+ * 71 minutes and the clock of the timeline is counted on it
+ */
+#define TIMELINE_MAX_WAIT_MS 60000
+
+/* RM0453 Set_TxRxFallbackMode, mode the radio falls back to after TX */
+#define SUBGHZ_FALLBACK_STDBY_RC 0x20
+#define SUBGHZ_FALLBACK_STDBY_XOSC 0x30
+#define SUBGHZ_FALLBACK_FS 0x40
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -78,19 +123,112 @@ static RadioModems_t radioModem = MODEM_FSK;
 static TxConfigGeneric_t txConfig;
 
 static uint8_t TXsyncWord[SYNCWORD_MAX_LEN];
-static uint32_t TXfreq = 433e6;
-static uint8_t TXpower = 15;
+static uint32_t TXfreq;
+static uint8_t TXpower;
 static uint32_t TXtimeout;
-
-
+static uint32_t ookOffset = SUBGHZ_OOK_OFFSET;
+
+/* Radio configuration saved in the config store, a new layout changes its size and older records are not loaded */
+typedef struct {
+	uint32_t freq;
+	uint32_t bitRate;
+	uint32_t freqDeviation;
+	uint16_t preambleLen;
+	uint16_t whiteSeed;
+	uint8_t power;
+	uint8_t crcLength;
+	uint8_t whitening;
+	uint8_t syncWordLength;
+	uint8_t syncWord[SYNCWORD_MAX_LEN];
+	uint8_t restore;			/* Applied at boot */
+} SubghzSavedConfig_t;
+
+/* The saved configuration is applied at boot */
+static uint8_t restoreAtBoot = 1;
+
+
+/* Created with xTimerCreateStatic, osTimerNew would still malloc its callback wrapper */
 static osTimerId_t subghzTimer;
-static osTimerAttr_t subghzTimerAttr = {
-		.name = "SUBGHZ Timer"
-};
+static StaticTimer_t subghzTimerCb;
 
 static char continuousMsg[MAX_TX_BUF];
+static const uint8_t *continuousData = (const uint8_t *) continuousMsg;
 static uint32_t continuousSize;
 
+/* Continuous mode sends the next packet of the template instead of continuousData */
+static volatile uint8_t continuousTemplate = 0;
+
+/* The radio holds another configuration than txConfig (TX_CONFIG_*), restored by the next SubghzApp_Sent */
+static uint8_t txConfigOverridden = TX_CONFIG_BASE;
+
+/* Periodic TX jobs, one timer runs the scheduler */
+static osTimerId_t jobsTimer;
+static StaticTimer_t jobsTimerCb;
+
+static uint32_t jobFreq;
+static uint32_t jobBitRate;
+static uint8_t jobPower;
+
+/*
+ * Timeline sequencer, a TIM2 compare at each deadline hands the entries due to
+ * the timer daemon. Its ms clock counts on TIM2 from the anchor, the deadlines
+ * fall on the us the timeline started at rather than on tick edges.
+ */
+static uint32_t timelineAnchorMs;
+static uint32_t timelineAnchorUs;
+
+/* Burst, every TX done sends the next packet at once or arms the gap timer */
+static RAM2_BUFFER uint8_t burstBuf[MAX_PAYLOAD];
+static uint8_t burstSize;
+static uint32_t burstCount;
+static volatile uint32_t burstSent;
+static uint32_t burstGapUs;
+/* Sleep-credited cycles, the 32 bit counter wraps after 89 s and misses sleep */
+static uint64_t burstStart;
+static uint64_t burstEnd;
+static volatile uint8_t burstActive = 0;
+static volatile uint8_t burstFailed = 0;
+
+/* Mode between packets, a warm radio sleeps after the idle timeout */
+static SubghzStandby_t standbyMode = SUBGHZ_STANDBY_RC;
+static uint32_t standbyIdleMs = SUBGHZ_STANDBY_IDLE_MS;
+
+/* Typical current of the radio in each mode with the SMPS, nA (datasheet) */
+static const uint64_t standbyCurrentNa[SUBGHZ_STANDBY_MODES] = {
+	[SUBGHZ_STANDBY_RC] = 600000,
+	[SUBGHZ_STANDBY_XOSC] = 800000,
+	[SUBGHZ_STANDBY_FS] = 2100000,
+	[SUBGHZ_STANDBY_SLEEP] = 600,
+};
+static osTimerId_t idleTimer;
+static StaticTimer_t idleTimerCb;
+
+/* Encoded copy of payloads longer than MAX_TX_BUF, too large for the task stacks */
+static RAM2_BUFFER uint8_t encodedLong[MAX_PAYLOAD];
+
+/* Streaming TX */
+static osTimerId_t streamTimer;
+static StaticTimer_t streamTimerCb;
+static RAM2_BUFFER uint8_t streamBuf[STREAM_BUF_SIZE];
+
+static SubghzStreamFill_t streamFill;
+static void *streamContext;
+static uint32_t streamSize;
+static uint32_t streamRemaining;
+static uint8_t streamWrite;					/* Buffer address of the next byte to queue */
+static volatile uint8_t streamActive = 0;
+static volatile uint8_t streamUnderrun = 0;
+
+/* OOK frame keyed with the PA */
+static SubghzOokMode_t ookMode = SUBGHZ_OOK_PA;
+static const uint8_t *ookChips;
+static uint32_t ookChipCount;
+static uint32_t ookChipUs;
+static uint32_t ookIndex;					/* First chip after the next edge */
+static uint32_t ookStart;					/* UsTimer time chip 0 starts */
+static uint8_t ookPaSelect;
+static volatile uint8_t ookActive = 0;
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -133,8 +271,30 @@ static void OnRxTimeout(void);
 static void OnRxError(void);
 
 /* USER CODE BEGIN PFP */
-static void SubghzTimerCallback(void *argument);
+static void SubghzTimerCallback(TimerHandle_t xTimer);
+static void SubghzStreamTimerCallback(TimerHandle_t xTimer);
 static void SubghzRegisterTxConfig();
+static void SubghzUseConfig(const JobConfig_t *job);
+static uint8_t SubghzRadioOwned(void);
+static uint8_t SubghzSend(const JobConfig_t *job, const uint8_t *msg, uint8_t size);
+static uint8_t SubghzSendOokFsk(const uint8_t *chips, uint8_t size, uint32_t chipRate);
+static uint8_t SubghzOokChip(uint32_t chip);
+static uint32_t SubghzOokEdgeAt(uint32_t chip, uint8_t on);
+static void SubghzOokEdge(void);
+static void SubghzOokEnded(void);
+static uint32_t SubghzJobAirtime(const JobConfig_t *config);
+static void SubghzJobsTimerCallback(TimerHandle_t xTimer);
+static uint8_t SubghzApplyConfig(const SubghzSavedConfig_t *saved);
+static void SubghzStartRx(void);
+static uint32_t SubghzTimelineAirtime(uint32_t id);
+static uint32_t SubghzTimelineNow(void);
+static void SubghzTimelineCompare(void);
+static void SubghzTimelineRun(void *param, uint32_t param2);
+static void SubghzTimelineRxEnded(void);
+static void SubghzBurstTxDone(void);
+static void SubghzBurstGapElapsed(void);
+static void SubghzEnterStandby(SubghzStandby_t mode);
+static void SubghzIdleTimerCallback(TimerHandle_t xTimer);
 /* USER CODE END PFP */
 
 /* Exported functions ---------------------------------------------------------*/
@@ -155,7 +315,8 @@ void SubghzApp_Init(void)
 
   /* USER CODE BEGIN SubghzApp_Init_2 */
 
-  Radio.SetChannel(TXfreq);
+  TXfreq = 433e6;
+  TXpower = 15;
 
   txConfig.fsk.Bandwidth = 0;
   txConfig.fsk.BitRate = 600;
@@ -170,14 +331,43 @@ void SubghzApp_Init(void)
   txConfig.fsk.SyncWordLength = 0;
   txConfig.fsk.SyncWord = TXsyncWord;
 
-  TXtimeout = 2 * MAX_TX_BUF * 1000 / txConfig.fsk.BitRate;
+  /* The saved configuration replaces the defaults before the radio is configured */
+  SubghzSavedConfig_t saved;
+
+  ConfigStore_Init();
+  restoreAtBoot = 1;
+  if (ConfigStore_Load(&saved, sizeof(saved))) {
+	  restoreAtBoot = saved.restore;
+	  if (restoreAtBoot) {
+		  SubghzApplyConfig(&saved);
+	  }
+  }
+
+  Radio.SetChannel(TXfreq);
+
+  TXtimeout = 2 * MAX_PAYLOAD * 8 * 1000 / txConfig.fsk.BitRate;
 
   SubghzRegisterTxConfig();
 
-  Radio.SetMaxPayloadLength(radioModem, MAX_TX_BUF);
+  Radio.SetMaxPayloadLength(radioModem, MAX_PAYLOAD);
+
+  Encode_Init();
+  Ook_Init();
+  Template_Init();
+  Jobs_Init(SubghzJobAirtime);
+  Timeline_Init();
 
   /* Create Continuous Timer */
-  subghzTimer = osTimerNew(SubghzTimerCallback, osTimerPeriodic, NULL, &subghzTimerAttr);
+  subghzTimer = (osTimerId_t) xTimerCreateStatic("SUBGHZ Timer", 1, pdTRUE, NULL, SubghzTimerCallback, &subghzTimerCb);
+  streamTimer = (osTimerId_t) xTimerCreateStatic("SUBGHZ Stream", 1, pdTRUE, NULL, SubghzStreamTimerCallback, &streamTimerCb);
+  jobsTimer = (osTimerId_t) xTimerCreateStatic("SUBGHZ Jobs", 1, pdFALSE, NULL, SubghzJobsTimerCallback, &jobsTimerCb);
+  idleTimer = (osTimerId_t) xTimerCreateStatic("SUBGHZ Idle", 1, pdFALSE, NULL, SubghzIdleTimerCallback, &idleTimerCb);
+
+  MemBudget_Register("SUBGHZ", "timer", sizeof(subghzTimerCb) + sizeof(streamTimerCb) + sizeof(jobsTimerCb) + sizeof(idleTimerCb));
+  MemBudget_Register("SUBGHZ", "tx buffers", sizeof(continuousMsg) + sizeof(TXsyncWord));
+  MemBudget_Register("SUBGHZ", "stream buffer", sizeof(streamBuf));
+  MemBudget_Register("SUBGHZ", "long payload encoding", sizeof(encodedLong));
+  MemBudget_Register("SUBGHZ", "burst buffer", sizeof(burstBuf));
   /* USER CODE END SubghzApp_Init_2 */
 }
 
@@ -185,8 +375,221 @@ void SubghzApp_Init(void)
 /*
  * @brief: Sents an RF packet based on the current settings
  */
-void SubghzApp_Sent(char *msg, uint8_t size) {
-	Radio.Send((uint8_t *) msg, size);
+uint8_t SubghzApp_Sent(char *msg, uint8_t size) {
+	return SubghzSend(NULL, (const uint8_t *) msg, size);
+}
+
+/*
+ * @brief: A burst, stream or keyed OOK frame owns the radio until it ended
+ */
+static uint8_t SubghzRadioOwned(void) {
+	return burstActive || streamActive || ookActive;
+}
+
+/*
+ * @brief: Sends a payload with the configuration of a job, the current one for NULL.
+ * Returns 0 when nothing was sent, the radio is owned by a burst, stream or OOK frame.
+ */
+static uint8_t SubghzSend(const JobConfig_t *job, const uint8_t *msg, uint8_t size) {
+	/* On the stack, the CLI task and the timer daemon both transmit */
+	uint8_t encoded[MAX_TX_BUF + ENCODE_MAX_OVERHEAD];
+
+	/* Held until the radio has the payload, a burst cannot start in between */
+	vTaskSuspendAll();
+	if (SubghzRadioOwned()) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	if (Encode_GetCrc() != NULL || Encode_GetWhitening() != NULL) {
+		/* encodedLong is shared by both tasks */
+		uint8_t *out = size > MAX_TX_BUF ? encodedLong : encoded;
+		size_t outSize = size > MAX_TX_BUF ? sizeof(encodedLong) : sizeof(encoded);
+
+		size = Encode_Apply(msg, size, out, outSize);
+		msg = out;
+	}
+
+	/* No room for the CRC */
+	if (size != 0) {
+		SubghzUseConfig(job);
+
+		Latency_Mark(LATENCY_RADIO_SEND);
+		BTRACE("radio tx %u bytes at %u Hz", size, TXfreq);
+		Radio.Send((uint8_t *) msg, size);
+	}
+
+	xTaskResumeAll();
+
+	return size != 0;
+}
+
+/*
+ * @brief: Sends count OOK chips of chipUs, MSB first. The PA is keyed at every
+ * edge from a TIM2 compare: '1' chips are a continuous wave on the set frequency,
+ * during '0' chips the synthesizer stays locked with the PA off. In the FSK mode,
+ * and for chips too short to key, they go out as a 2-FSK packet instead. The
+ * chips are read until the frame ended. Returns 0 when the radio is busy.
+ */
+uint8_t SubghzApp_SendOok(const uint8_t *chips, uint32_t count, uint32_t chipUs) {
+	if (ookMode == SUBGHZ_OOK_FSK || chipUs < SUBGHZ_OOK_MIN_KEYED_US) {
+		return SubghzSendOokFsk(chips, (count + 7) / 8, 1000000 / chipUs);
+	}
+
+	/* The continuous wave would cut a packet on air */
+	vTaskSuspendAll();
+	if (Radio.GetStatus() != RF_IDLE || SubghzRadioOwned()) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	SubghzUseConfig(NULL);
+	ookPaSelect = SUBGRF_SetRfTxPower(TXpower);
+	SUBGRF_SetSwitch(ookPaSelect, RFSWITCH_TX);
+
+	/* The status is read once the radio is no longer busy, the synthesizer locked */
+	SUBGRF_SetFs();
+	SUBGRF_GetStatus();
+
+	ookChips = chips;
+	ookChipCount = count;
+	ookChipUs = chipUs;
+	ookIndex = 0;
+	ookStart = UsTimer_Now() + SUBGHZ_OOK_PA_RAMP_US;
+	ookActive = 1;
+
+	Latency_Mark(LATENCY_RADIO_SEND);
+	BTRACE("radio ook %u chips of %u us", count, chipUs);
+	UsTimer_Start(US_TIMER_OOK, SubghzOokEdgeAt(0, SubghzOokChip(0)), SubghzOokEdge);
+	xTaskResumeAll();
+
+	return 1;
+}
+
+/*
+ * @brief: Sends OOK chips as an FSK packet with one bit per chip. There is no
+ * preamble, sync word, CRC or whitening a receiver would see as pulses, apart
+ * from the 8 bit preamble the packet engine needs. A narrow-band receiver on the
+ * set frequency sees on-off keying, a wide one a constant carrier.
+ */
+static uint8_t SubghzSendOokFsk(const uint8_t *chips, uint8_t size, uint32_t chipRate) {
+	TxConfigGeneric_t ook = txConfig;
+
+	ook.fsk.BitRate = chipRate;
+	ook.fsk.FrequencyDeviation = ookOffset;
+	ook.fsk.ModulationShaping = RADIO_FSK_MOD_SHAPING_OFF;
+	ook.fsk.PreambleLen = 1;
+	ook.fsk.SyncWordLength = 0;
+	ook.fsk.CrcLength = RADIO_FSK_CRC_OFF;
+	ook.fsk.Whitening = RADIO_FSK_DC_FREE_OFF;
+	ook.fsk.HeaderType = RADIO_FSK_PACKET_FIXED_LENGTH;
+
+	vTaskSuspendAll();
+	if (SubghzRadioOwned()) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	Radio.SetChannel(TXfreq - ookOffset);
+	Radio.RadioSetTxGenericConfig(radioModem, &ook, TXpower, 2 * (size * 8 * 1000 / chipRate) + 100);
+	txConfigOverridden = TX_CONFIG_ONE_OFF;
+
+	Latency_Mark(LATENCY_RADIO_SEND);
+	BTRACE("radio ook %u bytes at %u chips/s", size, chipRate);
+	Radio.Send((uint8_t *) chips, size);
+	xTaskResumeAll();
+
+	return 1;
+}
+
+/*
+ * @brief: Chip of the keyed OOK frame, MSB first
+ */
+static uint8_t SubghzOokChip(uint32_t chip) {
+	return (ookChips[chip / 8] >> (7 - chip % 8)) & 1;
+}
+
+/*
+ * @brief: Time of the edge before chip, turning the carrier on leads by the PA ramp
+ */
+static uint32_t SubghzOokEdgeAt(uint32_t chip, uint8_t on) {
+	return ookStart + chip * ookChipUs - (on ? SUBGHZ_OOK_PA_RAMP_US : 0);
+}
+
+/*
+ * @brief: TIM2 compare at an OOK edge, keys the PA for the run of equal chips
+ * from ookIndex. The deadlines are from the frame start, the interrupt latency
+ * does not add up over the edges.
+ */
+static void SubghzOokEdge(void) {
+	uint8_t on = SubghzOokChip(ookIndex);
+
+	if (on) {
+		SUBGRF_SetTxContinuousWave();
+	} else {
+		SUBGRF_SetFs();
+	}
+
+	do {
+		ookIndex++;
+	} while (ookIndex < ookChipCount && SubghzOokChip(ookIndex) == on);
+
+	if (ookIndex < ookChipCount) {
+		UsTimer_Start(US_TIMER_OOK, SubghzOokEdgeAt(ookIndex, !on), SubghzOokEdge);
+	} else {
+		UsTimer_Start(US_TIMER_OOK, SubghzOokEdgeAt(ookChipCount, 0), SubghzOokEnded);
+	}
+}
+
+/*
+ * @brief: TIM2 compare at the end of the keyed OOK frame, the standby after a
+ * packet turns the carrier off
+ */
+static void SubghzOokEnded(void) {
+	SubghzApp_TxDoneStandby();
+	SUBGRF_SetSwitch(ookPaSelect, RFSWITCH_RX);
+	ookActive = 0;
+}
+
+/*
+ * @brief: A keyed OOK frame is on air
+ */
+uint8_t SubghzApp_OokActive() {
+	return ookActive;
+}
+
+/*
+ * @brief: Get how OOK chips reach the air
+ */
+SubghzOokMode_t SubghzApp_GetOokMode() {
+	return ookMode;
+}
+
+/*
+ * @brief: Set how OOK chips reach the air, PA keying after boot
+ */
+void SubghzApp_SetOokMode(SubghzOokMode_t mode) {
+	ookMode = mode;
+}
+
+/*
+ * @brief: Get the OOK offset, '0' chips are sent twice this below the frequency
+ */
+uint32_t SubghzApp_GetOokOffset() {
+	return ookOffset;
+}
+
+/*
+ * @brief: Set the OOK offset, returns 0 when the radio cannot deviate that far
+ */
+uint8_t SubghzApp_SetOokOffset(uint32_t offset) {
+	if (offset == 0 || offset > SUBGHZ_OOK_MAX_OFFSET) {
+		return 0;
+	}
+
+	ookOffset = offset;
+
+	return 1;
 }
 
 /*
@@ -194,11 +597,151 @@ void SubghzApp_Sent(char *msg, uint8_t size) {
  */
 void SubghzApp_StartContinuous(char *msg, uint8_t size, uint32_t ms) {
 	memcpy(continuousMsg, msg, size);
+	continuousData = (const uint8_t *) continuousMsg;
+	continuousSize = size;
+	continuousTemplate = 0;
+
+	osTimerStart(subghzTimer, ms);
+}
+
+/*
+ * @brief: Continuously sents a payload every <ms> milliseconds without copying it,
+ * msg has to stay valid until the transmission stops (a payload in flash)
+ */
+void SubghzApp_StartContinuousRef(const uint8_t *msg, uint8_t size, uint32_t ms) {
+	osTimerStop(subghzTimer);
+
+	continuousData = msg;
 	continuousSize = size;
+	continuousTemplate = 0;
 
 	osTimerStart(subghzTimer, ms);
 }
 
+/*
+ * @brief: Sends the next packet of the template, returns its size or 0 when none was sent
+ */
+uint8_t SubghzApp_SendTemplate() {
+	uint8_t msg[TEMPLATE_MAX_PAYLOAD];
+	uint8_t size = Template_Next(msg, osKernelGetTickCount());
+
+	if (size == 0 || !SubghzApp_Sent((char *) msg, size)) {
+		return 0;
+	}
+
+	return size;
+}
+
+/*
+ * @brief: Continuously sends the packets of the template every <ms> milliseconds
+ */
+uint8_t SubghzApp_StartTemplate(uint32_t ms) {
+	/* Radio.Random receives, it would abort a packet on air */
+	vTaskSuspendAll();
+	if (Radio.GetStatus() != RF_IDLE || SubghzRadioOwned()) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	/* Seeds the template's generator, Radio.Random leaves the radio in LoRa mode */
+	Template_Restart(Radio.Random());
+	SubghzRegisterTxConfig();
+	xTaskResumeAll();
+
+	continuousTemplate = 1;
+
+	osTimerStart(subghzTimer, ms);
+
+	return 1;
+}
+
+/*
+ * @brief: Sends <size> bytes from fill as a single packet, longer than the radio
+ * buffer. The buffer is refilled behind the packet engine while it transmits
+ * and the payload length moved to the end of the new bytes, so the packet goes
+ * on at a constant bit rate until every byte was sent. The encoding stage is
+ * not applied, the bytes go out as fill wrote them.
+ */
+uint8_t SubghzApp_StartStream(uint32_t size, SubghzStreamFill_t fill, void *context) {
+	if (SubghzRadioOwned() || size == 0) {
+		return 0;
+	}
+
+	uint8_t first = fill(streamBuf, size < STREAM_BUF_SIZE ? size : STREAM_BUF_SIZE, context);
+	if (first == 0) {
+		return 0;
+	}
+
+	streamFill = fill;
+	streamContext = context;
+	streamSize = size;
+	streamRemaining = size - first;
+	streamWrite = first;
+	streamUnderrun = 0;
+	streamActive = 1;
+
+	/* The TX timeout covers the whole stream instead of one buffer */
+	uint32_t airMs = (uint64_t) size * 8 * 1000 / txConfig.fsk.BitRate;
+	Radio.SetChannel(TXfreq);
+	Radio.RadioSetTxGenericConfig(radioModem, &txConfig, TXpower, 2 * airMs + 100);
+	txConfigOverridden = TX_CONFIG_ONE_OFF;
+
+	Latency_Mark(LATENCY_RADIO_SEND);
+	BTRACE("radio stream %lu bytes at %u Hz", size, TXfreq);
+	Radio.Send(streamBuf, first);
+
+	if (streamRemaining != 0) {
+		uint32_t period = STREAM_REFILL_BYTES * 8 * 1000 / txConfig.fsk.BitRate;
+		osTimerStart(streamTimer, period != 0 ? period : 1);
+	}
+
+	return 1;
+}
+
+/*
+ * @brief: Queues as many stream bytes as the radio buffer has room for behind
+ * the packet engine's pointer
+ */
+void SubghzApp_StreamRefill(void) {
+	if (!streamActive || streamRemaining == 0) {
+		return;
+	}
+
+	uint8_t pointer = SUBGRF_ReadRegister(SUBGHZ_REG_TX_POINTER);
+	if (pointer == streamWrite) {
+		/* The engine reached the end of the queued bytes, the packet is over */
+		streamUnderrun = 1;
+		return;
+	}
+
+	/* One address stays free, the end never catches up with the pointer */
+	uint32_t space = (uint8_t) (pointer - streamWrite - 1);
+	uint32_t size = streamFill(streamBuf, space < streamRemaining ? space : streamRemaining, streamContext);
+	if (size == 0) {
+		return;
+	}
+
+	/* Up to the end of the buffer, the rest wraps to its start */
+	uint32_t head = size < 256 - streamWrite ? size : 256 - streamWrite;
+	SUBGRF_WriteBuffer(streamWrite, streamBuf, head);
+	if (head < size) {
+		SUBGRF_WriteBuffer(0, &streamBuf[head], size - head);
+	}
+
+	streamWrite += size;
+	streamRemaining -= size;
+
+	/* The TX base address is 0, the length is the end address */
+	SUBGRF_WriteRegister(SUBGHZ_REG_PAYLOAD_LENGTH, streamWrite);
+}
+
+void SubghzApp_GetStreamStatus(SubghzStreamStatus_t *status) {
+	status->active = streamActive;
+	status->underrun = streamUnderrun;
+	status->size = streamSize;
+	status->queued = streamSize - streamRemaining;
+}
+
 /*
  * @brief: Stop sending continuous packets
  */
@@ -206,6 +749,366 @@ void SubghzApp_StopContinuous() {
 	osTimerStop(subghzTimer);
 }
 
+/*
+ * @brief: Adds a periodic TX job, sent from now on. Returns its index, -1 when it was not added.
+ */
+int32_t SubghzApp_AddJob(const JobConfig_t *config) {
+	int32_t job = Jobs_Add(config, osKernelGetTickCount());
+
+	/* Due now, the scheduler runs in the timer daemon */
+	if (job >= 0) {
+		osTimerStart(jobsTimer, 1);
+	}
+
+	return job;
+}
+
+/*
+ * @brief: Removes a periodic TX job
+ */
+uint8_t SubghzApp_RemoveJob(uint8_t job) {
+	uint8_t removed = Jobs_Remove(job);
+
+	if (Jobs_Count() == 0) {
+		osTimerStop(jobsTimer);
+	}
+
+	return removed;
+}
+
+/*
+ * @brief: Removes every periodic TX job
+ */
+void SubghzApp_ClearJobs() {
+	osTimerStop(jobsTimer);
+	Jobs_Clear();
+}
+
+/*
+ * @brief: Sends the job due at now, if any, and returns the ms until the
+ * scheduler has to run again (JOBS_NO_DEADLINE without jobs)
+ */
+uint32_t SubghzApp_RunJobs(uint32_t now) {
+	uint32_t wait;
+
+	/* Deferred while the radio is owned, the jobs run late */
+	if (SubghzRadioOwned()) {
+		return 1;
+	}
+
+	int32_t job = Jobs_Next(now, &wait);
+
+	if (job >= 0) {
+		const JobConfig_t *config = &Jobs_Get(job)->config;
+		SubghzSend(config, config->data, config->size);
+	}
+
+	return wait;
+}
+
+/*
+ * @brief: Starts the timeline from its first entry
+ */
+uint8_t SubghzApp_StartTimeline() {
+	timelineAnchorMs = 0;
+	timelineAnchorUs = UsTimer_Now();
+
+	if (!Timeline_Start(timelineAnchorMs)) {
+		return 0;
+	}
+
+	/*
+	 * The first entries are due now. The compare stays armed while the
+	 * timeline runs, STOP2 would stop its clock.
+	 */
+	UsTimer_Start(US_TIMER_TIMELINE, timelineAnchorUs, SubghzTimelineCompare);
+
+	return 1;
+}
+
+/*
+ * @brief: Stops the timeline, a reception it waits for is cut short
+ */
+void SubghzApp_StopTimeline() {
+	TimelineStatus_t status;
+
+	UsTimer_Stop(US_TIMER_TIMELINE);
+	Timeline_GetStatus(&status);
+	Timeline_Stop();
+
+	if (status.waitingRx) {
+		Radio.Standby();
+	}
+}
+
+/*
+ * @brief: Duration and airtime of the timeline with the current settings
+ */
+void SubghzApp_DryRunTimeline(TimelineDryRun_t *result) {
+	Timeline_DryRun(SubghzTimelineAirtime, result);
+}
+
+/*
+ * @brief: Runs the timeline entries due at now, ms of the timeline clock, and
+ * returns the ms until it has to run again (TIMELINE_NO_DEADLINE once it ended)
+ */
+uint32_t SubghzApp_RunTimeline(uint32_t now) {
+	const TimelineEntry_t *entry;
+	uint32_t wait;
+	uint8_t size;
+
+	/* Deferred while the radio is owned, the entries run late */
+	if (SubghzRadioOwned()) {
+		return 1;
+	}
+
+	/* Nothing received, the radio is still listening */
+	if (Timeline_RxExpired(now)) {
+		Radio.Standby();
+		Timeline_RxDone(now);
+	}
+
+	while ((entry = Timeline_Next(now, &wait)) != NULL) {
+		switch (entry->action) {
+		case TIMELINE_FREQ:
+			SubghzApp_SetFreq(entry->arg);
+			break;
+		case TIMELINE_POWER:
+			SubghzApp_SetPower(entry->arg);
+			break;
+		case TIMELINE_PRESET:
+			SubghzApp_LoadConfig();
+			break;
+		case TIMELINE_SEND: {
+			/* A payload deleted since it was added is skipped */
+			const uint8_t *payload = PayloadStore_Get(entry->arg, &size);
+
+			if (payload != NULL) {
+				SubghzSend(NULL, payload, size);
+			}
+			break;
+		}
+		case TIMELINE_RX:
+			SubghzStartRx();
+			return wait;
+		default:
+			break;
+		}
+	}
+
+	return wait;
+}
+
+/*
+ * @brief: Sends count packets of a payload, each gapUs after the TX done of the
+ * one before. The payload is encoded once. Without a gap the next packets are
+ * sent from the radio interrupt, after a gap from a TIM2 compare armed on TX done.
+ */
+uint8_t SubghzApp_StartBurst(const uint8_t *msg, uint8_t size, uint32_t count, uint32_t gapUs) {
+	if (count == 0 || count > SUBGHZ_BURST_MAX_COUNT || gapUs > SUBGHZ_BURST_MAX_GAP_US) {
+		return 0;
+	}
+
+	/* A packet on air would be cut and its TX done counted as one of the burst */
+	vTaskSuspendAll();
+	if (Radio.GetStatus() != RF_IDLE || SubghzRadioOwned()) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	if (Encode_GetCrc() != NULL || Encode_GetWhitening() != NULL) {
+		size = Encode_Apply(msg, size, burstBuf, sizeof(burstBuf));
+	} else {
+		memcpy(burstBuf, msg, size);
+	}
+
+	if (size == 0) {
+		xTaskResumeAll();
+		return 0;
+	}
+
+	burstSize = size;
+	burstCount = count;
+	burstSent = 0;
+	burstGapUs = gapUs;
+	burstFailed = 0;
+	burstActive = 1;
+
+	SubghzUseConfig(NULL);
+
+	BTRACE("radio burst %u packets of %u bytes", count, size);
+	burstStart = Stats_GetCycles();
+	Radio.Send(burstBuf, burstSize);
+	xTaskResumeAll();
+
+	return 1;
+}
+
+/*
+ * @brief: Ends the burst after the packet on air
+ */
+void SubghzApp_StopBurst() {
+	if (burstActive) {
+		burstEnd = Stats_GetCycles();
+		burstActive = 0;
+		UsTimer_Stop(US_TIMER_BURST);
+	}
+}
+
+void SubghzApp_GetBurstStatus(SubghzBurstStatus_t *status) {
+	status->active = burstActive;
+	status->failed = burstFailed;
+	status->count = burstCount;
+	status->sent = burstSent;
+	status->duration = !burstActive && burstSent != 0 ? (uint32_t) ((burstEnd - burstStart) / (SystemCoreClock / 1000000)) : 0;
+}
+
+/*
+ * @brief: Time on air of a payload with the current settings, ms
+ */
+uint32_t SubghzApp_GetAirtime(uint8_t size) {
+	if (Encode_GetCrc() != NULL) {
+		size = size + ENCODE_MAX_OVERHEAD > MAX_PAYLOAD ? MAX_PAYLOAD : size + ENCODE_MAX_OVERHEAD;
+	}
+
+	return Radio.TimeOnAir(radioModem, 0, txConfig.fsk.BitRate, 0, txConfig.fsk.PreambleLen, true, size,
+			txConfig.fsk.CrcLength != RADIO_FSK_CRC_OFF);
+}
+
+/*
+ * @brief: Get the mode of the radio between packets and its idle timeout
+ */
+SubghzStandby_t SubghzApp_GetStandby(uint32_t *idleMs) {
+	*idleMs = standbyIdleMs;
+
+	return standbyMode;
+}
+
+/*
+ * @brief: Set the mode of the radio between packets. In STDBY_XOSC and FS the
+ * radio falls back to it after TX and sleeps after idleMs without a packet,
+ * 0 keeps it warm. In SLEEP it sleeps after every packet, idleMs is unused.
+ */
+void SubghzApp_SetStandby(SubghzStandby_t mode, uint32_t idleMs) {
+	static const uint8_t fallback[SUBGHZ_STANDBY_MODES] = {
+		[SUBGHZ_STANDBY_RC] = SUBGHZ_FALLBACK_STDBY_RC,
+		[SUBGHZ_STANDBY_XOSC] = SUBGHZ_FALLBACK_STDBY_XOSC,
+		[SUBGHZ_STANDBY_FS] = SUBGHZ_FALLBACK_FS,
+		[SUBGHZ_STANDBY_SLEEP] = SUBGHZ_FALLBACK_STDBY_RC,
+	};
+
+	osTimerStop(idleTimer);
+
+	standbyMode = mode;
+	standbyIdleMs = idleMs;
+	SUBGRF_SetRxTxFallbackMode(fallback[mode]);
+
+	/* Warm from now on, the next packet already starts fast */
+	if (Radio.GetStatus() == RF_IDLE) {
+		SubghzEnterStandby(mode);
+
+		if (mode != SUBGHZ_STANDBY_RC && mode != SUBGHZ_STANDBY_SLEEP && idleMs != 0) {
+			osTimerStart(idleTimer, idleMs);
+		}
+	}
+}
+
+/*
+ * @brief: Measures the time the radio takes from each standby mode to a locked
+ * synthesizer (FS), the part of the TX start a warm mode saves. The PA ramp up
+ * after it is the same from every mode. Nothing is sent.
+ */
+uint8_t SubghzApp_MeasureStandby(SubghzStandbyLatency_t *latency) {
+	if (Radio.GetStatus() != RF_IDLE || SubghzRadioOwned()) {
+		return 0;
+	}
+
+	/* Nothing else may use the radio meanwhile */
+	vTaskSuspendAll();
+
+	for (SubghzStandby_t mode = 0; mode < SUBGHZ_STANDBY_MODES; mode++) {
+		SubghzEnterStandby(mode);
+
+		/* Settled in the mode, a command would wake a sleeping radio */
+		if (mode != SUBGHZ_STANDBY_SLEEP) {
+			SUBGRF_GetStatus();
+		}
+
+		/* Commands wait for BUSY, which is low once the PLL locked */
+		uint32_t start = DWT->CYCCNT;
+		SUBGRF_SetFs();
+		SUBGRF_GetStatus();
+		latency->startUs[mode] = (DWT->CYCCNT - start) / (SystemCoreClock / 1000000);
+	}
+
+	SubghzEnterStandby(standbyMode);
+
+	xTaskResumeAll();
+
+	return 1;
+}
+
+/*
+ * @brief: Average current of the radio held in a standby mode between packets
+ * periodMs apart, nA. The TX start counts at the FS current, the packet itself
+ * is the same in every mode and left out.
+ */
+uint32_t SubghzApp_GetStandbyCurrent(const SubghzStandbyLatency_t *latency, SubghzStandby_t mode, uint32_t periodMs) {
+	uint64_t periodUs = (uint64_t) periodMs * 1000;
+	uint64_t startUs = latency->startUs[mode] < periodUs ? latency->startUs[mode] : periodUs;
+
+	if (periodUs == 0) {
+		return 0;
+	}
+
+	return (standbyCurrentNa[mode] * (periodUs - startUs) + standbyCurrentNa[SUBGHZ_STANDBY_FS] * startUs) / periodUs;
+}
+
+/*
+ * @brief: Puts the radio in its standby mode once a packet is sent, from the
+ * radio interrupt (RADIO_TX_DONE_STANDBY of radio_conf.h)
+ */
+void SubghzApp_TxDoneStandby(void) {
+	BaseType_t woken = pdFALSE;
+	/* Runs before OnTxDone, the burst still counts the packet that just ended */
+	uint8_t idle = !burstActive || burstSent + 1 >= burstCount;
+
+	if (standbyMode == SUBGHZ_STANDBY_SLEEP) {
+		/* The HAL clears the interrupt after this with a command, which would wake a sleeping radio */
+		SubghzEnterStandby(SUBGHZ_STANDBY_RC);
+
+		if (idle) {
+			xTimerChangePeriodFromISR(idleTimer, 1, &woken);
+		}
+	} else {
+		SubghzEnterStandby(standbyMode);
+
+		if (idle && standbyMode != SUBGHZ_STANDBY_RC && standbyIdleMs != 0) {
+			xTimerChangePeriodFromISR(idleTimer, standbyIdleMs, &woken);
+		}
+	}
+
+	portYIELD_FROM_ISR(woken);
+}
+
+/*
+ * @brief: Puts the radio to sleep, the configuration is retained (warm start).
+ * A warm mode sleeps after the idle timeout, SLEEP a tick after every packet.
+ */
+void SubghzApp_IdleSleep(void) {
+	/* A task or the radio interrupt may send between the check and the sleep */
+	vTaskSuspendAll();
+	taskENTER_CRITICAL();
+
+	if (standbyMode != SUBGHZ_STANDBY_RC && (standbyMode == SUBGHZ_STANDBY_SLEEP || standbyIdleMs != 0)
+			&& Radio.GetStatus() == RF_IDLE && !SubghzRadioOwned()) {
+		SubghzEnterStandby(SUBGHZ_STANDBY_SLEEP);
+	}
+
+	taskEXIT_CRITICAL();
+	xTaskResumeAll();
+}
+
 /*
  * @brief: Get RF frequency
  */
@@ -220,6 +1123,11 @@ void SubghzApp_SetFreq(uint32_t freq) {
 	TXfreq = freq;
 
 	Radio.SetChannel(TXfreq);
+
+	/* A job configuration at another frequency no longer is one */
+	if (txConfigOverridden == TX_CONFIG_JOB) {
+		txConfigOverridden = TX_CONFIG_ONE_OFF;
+	}
 }
 
 /*
@@ -267,7 +1175,7 @@ uint32_t SubghzApp_GetDatarate() {
  */
 void SubghzApp_SetDatarate(uint32_t datarate) {
 	txConfig.fsk.BitRate = datarate;
-	TXtimeout = 2 * MAX_TX_BUF * 1000 / datarate;
+	TXtimeout = 2 * MAX_PAYLOAD * 8 * 1000 / datarate;
 
 	SubghzRegisterTxConfig();
 }
@@ -341,19 +1249,357 @@ void SubghzApp_SetWhitening(uint8_t active, uint16_t seed) {
 	SubghzRegisterTxConfig();
 }
 
+/*
+ * @brief: Saves the radio configuration to flash
+ */
+uint8_t SubghzApp_SaveConfig() {
+	SubghzSavedConfig_t saved;
+
+	/* Padding included, the record is the same for the same configuration */
+	memset(&saved, 0, sizeof(saved));
+	saved.freq = TXfreq;
+	saved.bitRate = txConfig.fsk.BitRate;
+	saved.freqDeviation = txConfig.fsk.FrequencyDeviation;
+	saved.preambleLen = txConfig.fsk.PreambleLen;
+	saved.whiteSeed = txConfig.fsk.whiteSeed;
+	saved.power = TXpower;
+	saved.crcLength = txConfig.fsk.CrcLength;
+	saved.whitening = txConfig.fsk.Whitening;
+	saved.syncWordLength = txConfig.fsk.SyncWordLength;
+	memcpy(saved.syncWord, TXsyncWord, sizeof(saved.syncWord));
+	saved.restore = restoreAtBoot;
+
+	return ConfigStore_Save(&saved, sizeof(saved));
+}
+
+/*
+ * @brief: Applies the radio configuration saved in flash
+ */
+uint8_t SubghzApp_LoadConfig() {
+	SubghzSavedConfig_t saved;
+
+	if (!ConfigStore_Load(&saved, sizeof(saved)) || !SubghzApplyConfig(&saved)) {
+		return 0;
+	}
+
+	Radio.SetChannel(TXfreq);
+	TXtimeout = 2 * MAX_PAYLOAD * 8 * 1000 / txConfig.fsk.BitRate;
+
+	SubghzRegisterTxConfig();
+	txConfigOverridden = TX_CONFIG_BASE;
+
+	return 1;
+}
+
+/*
+ * @brief: Check if the saved configuration is applied at boot
+ */
+uint8_t SubghzApp_GetRestore() {
+	return restoreAtBoot;
+}
+
+/*
+ * @brief: Set if the saved configuration is applied at boot, kept with the saved configuration
+ */
+uint8_t SubghzApp_SetRestore(uint8_t enable) {
+	SubghzSavedConfig_t saved;
+
+	restoreAtBoot = enable;
+
+	/* Without a saved configuration the flag goes with the next save */
+	if (!ConfigStore_Load(&saved, sizeof(saved)) || saved.restore == enable) {
+		return 1;
+	}
+
+	saved.restore = enable;
+
+	return ConfigStore_Save(&saved, sizeof(saved));
+}
+
+/*
+ * @brief: Copies a saved configuration to the TX configuration, the radio is not touched
+ */
+static uint8_t SubghzApplyConfig(const SubghzSavedConfig_t *saved) {
+	if (saved->bitRate == 0 || saved->syncWordLength > SYNCWORD_MAX_LEN) {
+		return 0;
+	}
+
+	TXfreq = saved->freq;
+	TXpower = saved->power;
+	txConfig.fsk.BitRate = saved->bitRate;
+	txConfig.fsk.FrequencyDeviation = saved->freqDeviation;
+	txConfig.fsk.PreambleLen = saved->preambleLen;
+	txConfig.fsk.whiteSeed = saved->whiteSeed;
+	txConfig.fsk.CrcLength = saved->crcLength;
+	txConfig.fsk.Whitening = saved->whitening;
+	txConfig.fsk.SyncWordLength = saved->syncWordLength;
+	memcpy(TXsyncWord, saved->syncWord, sizeof(TXsyncWord));
+
+	return 1;
+}
+
 /*
  * @brief: Register an updated TX Configuration to the peripheral
  */
 static void SubghzRegisterTxConfig() {
 	/* ( GenericModems_t modem, TxConfigGeneric_t* config, int8_t power, uint32_t timeout ); */
 	Radio.RadioSetTxGenericConfig(radioModem, &txConfig, TXpower, TXtimeout);
+
+	/* The channel may still be the one of a job */
+	if (txConfigOverridden == TX_CONFIG_JOB) {
+		txConfigOverridden = TX_CONFIG_ONE_OFF;
+	}
+}
+
+/*
+ * @brief: Sets the radio to the configuration of a job, or the current one for NULL.
+ * Nothing is sent to the radio when it already holds it.
+ */
+static void SubghzUseConfig(const JobConfig_t *job) {
+	uint32_t freq = job != NULL && job->freq != 0 ? job->freq : TXfreq;
+	uint32_t bitRate = job != NULL && job->bitRate != 0 ? job->bitRate : txConfig.fsk.BitRate;
+	uint8_t power = job != NULL && job->power != 0 ? job->power : TXpower;
+
+	if (freq == TXfreq && bitRate == txConfig.fsk.BitRate && power == TXpower) {
+		if (txConfigOverridden != TX_CONFIG_BASE) {
+			txConfigOverridden = TX_CONFIG_BASE;
+			Radio.SetChannel(TXfreq);
+			SubghzRegisterTxConfig();
+		}
+		return;
+	}
+
+	if (txConfigOverridden == TX_CONFIG_JOB && freq == jobFreq && bitRate == jobBitRate && power == jobPower) {
+		return;
+	}
+
+	TxConfigGeneric_t config = txConfig;
+	config.fsk.BitRate = bitRate;
+
+	Radio.SetChannel(freq);
+	Radio.RadioSetTxGenericConfig(radioModem, &config, power, 2 * MAX_PAYLOAD * 8 * 1000 / bitRate);
+
+	txConfigOverridden = TX_CONFIG_JOB;
+	jobFreq = freq;
+	jobBitRate = bitRate;
+	jobPower = power;
+}
+
+/*
+ * @brief: Time on air of a packet of a job, ms
+ */
+static uint32_t SubghzJobAirtime(const JobConfig_t *config) {
+	uint32_t bitRate = config->bitRate != 0 ? config->bitRate : txConfig.fsk.BitRate;
+	uint32_t size = config->size;
+
+	if (Encode_GetCrc() != NULL) {
+		size += ENCODE_MAX_OVERHEAD;
+	}
+
+	return Radio.TimeOnAir(radioModem, 0, bitRate, 0, txConfig.fsk.PreambleLen, true, size > MAX_PAYLOAD ? MAX_PAYLOAD : size,
+			txConfig.fsk.CrcLength != RADIO_FSK_CRC_OFF);
+}
+
+/*
+ * @brief: Runs the scheduler of the periodic TX jobs, rearmed for its next deadline
+ */
+static void SubghzJobsTimerCallback(TimerHandle_t xTimer) {
+	uint32_t wait = SubghzApp_RunJobs(osKernelGetTickCount());
+
+	if (wait != JOBS_NO_DEADLINE) {
+		osTimerStart(jobsTimer, wait != 0 ? wait : 1);
+	}
+}
+
+/*
+ * @brief: Receives with the TX settings until a packet or the timeline ends the wait
+ */
+static void SubghzStartRx(void) {
+	RxConfigGeneric_t rxConfig = {0};
+
+	rxConfig.fsk.ModulationShaping = txConfig.fsk.ModulationShaping;
+	rxConfig.fsk.Bandwidth = 2 * txConfig.fsk.FrequencyDeviation + txConfig.fsk.BitRate;
+	rxConfig.fsk.BitRate = txConfig.fsk.BitRate;
+	rxConfig.fsk.PreambleLen = txConfig.fsk.PreambleLen;
+	rxConfig.fsk.PreambleMinDetect = RADIO_FSK_PREAMBLE_DETECTOR_08_BITS;
+	rxConfig.fsk.SyncWordLength = txConfig.fsk.SyncWordLength;
+	rxConfig.fsk.SyncWord = TXsyncWord;
+	rxConfig.fsk.MaxPayloadLength = MAX_PAYLOAD;
+	rxConfig.fsk.whiteSeed = txConfig.fsk.whiteSeed;
+	rxConfig.fsk.AddrComp = RADIO_FSK_ADDRESSCOMP_FILT_OFF;
+	/* The size of what arrives is not known, packets with a length byte are received */
+	rxConfig.fsk.LengthMode = RADIO_FSK_PACKET_VARIABLE_LENGTH;
+	rxConfig.fsk.CrcLength = txConfig.fsk.CrcLength;
+	rxConfig.fsk.CrcPolynomial = txConfig.fsk.CrcPolynomial;
+	rxConfig.fsk.Whitening = txConfig.fsk.Whitening;
+
+	/* No radio timeout, the timeline compare ends the wait */
+	Radio.RadioSetRxGenericConfig(GENERIC_FSK, &rxConfig, 0, 0);
+	Radio.Rx(0);
+
+	/* The packet parameters are the ones of the receiver now */
+	txConfigOverridden = TX_CONFIG_ONE_OFF;
+}
+
+/*
+ * @brief: Time on air of a payload of the payload store, ms
+ */
+static uint32_t SubghzTimelineAirtime(uint32_t id) {
+	uint8_t size = 0;
+
+	if (PayloadStore_Get(id, &size) == NULL) {
+		return 0;
+	}
+
+	return SubghzApp_GetAirtime(size);
+}
+
+/*
+ * @brief: ms of the timeline clock, it counts on TIM2 from the anchor
+ */
+static uint32_t SubghzTimelineNow(void) {
+	return timelineAnchorMs + (UsTimer_Now() - timelineAnchorUs) / 1000;
+}
+
+/*
+ * @brief: TIM2 compare at the deadline of the next timeline entry, runs in its
+ * interrupt. The entries send and configure the radio, they run in the timer
+ * daemon right after.
+ */
+static void SubghzTimelineCompare(void) {
+	BaseType_t woken = pdFALSE;
+
+	if (xTimerPendFunctionCallFromISR(SubghzTimelineRun, NULL, 0, &woken) != pdPASS) {
+		/* The daemon queue is full, tried again a ms later */
+		UsTimer_Start(US_TIMER_TIMELINE, UsTimer_Now() + 1000, SubghzTimelineCompare);
+	}
+
+	portYIELD_FROM_ISR(woken);
+}
+
+/*
+ * @brief: Runs the timeline in the timer daemon, the compare rearmed for its
+ * next entry. The anchor moves to the current ms, the deadline is whole ms from it.
+ */
+static void SubghzTimelineRun(void *param, uint32_t param2) {
+	taskENTER_CRITICAL();
+	uint32_t now = SubghzTimelineNow();
+	timelineAnchorUs += (now - timelineAnchorMs) * 1000;
+	timelineAnchorMs = now;
+	taskEXIT_CRITICAL();
+
+	uint32_t wait = SubghzApp_RunTimeline(now);
+
+	if (wait != TIMELINE_NO_DEADLINE) {
+		wait = wait < TIMELINE_MAX_WAIT_MS ? wait : TIMELINE_MAX_WAIT_MS;
+		UsTimer_Start(US_TIMER_TIMELINE, timelineAnchorUs + wait * 1000, SubghzTimelineCompare);
+	}
+}
+
+/*
+ * @brief: A reception of the timeline ended, its next entries are due from now on.
+ * Runs in the radio interrupt, the daemon runs them after an entry it may be running.
+ */
+static void SubghzTimelineRxEnded(void) {
+	BaseType_t woken = pdFALSE;
+
+	if (Timeline_RxDone(SubghzTimelineNow())) {
+		if (xTimerPendFunctionCallFromISR(SubghzTimelineRun, NULL, 0, &woken) != pdPASS) {
+			UsTimer_Start(US_TIMER_TIMELINE, UsTimer_Now(), SubghzTimelineCompare);
+		}
+		portYIELD_FROM_ISR(woken);
+	}
+}
+
+/*
+ * @brief: Sends the next packet of the burst, arms the gap compare or ends it.
+ * Runs in the radio interrupt, the radio is in standby.
+ */
+static void SubghzBurstTxDone(void) {
+	burstSent++;
+	if (burstSent >= burstCount) {
+		burstEnd = Stats_GetCycles();
+		burstActive = 0;
+		return;
+	}
+
+	if (burstGapUs == 0) {
+		SubghzUseConfig(NULL);
+		Radio.Send(burstBuf, burstSize);
+		return;
+	}
+
+	/* Part of the current us has passed, one more keeps the gap from being shorter */
+	UsTimer_Start(US_TIMER_BURST, UsTimer_Now() + burstGapUs + 1, SubghzBurstGapElapsed);
+}
+
+/*
+ * @brief: The gap of the burst passed, a stopped burst sends nothing. Runs in the TIM2 interrupt.
+ */
+static void SubghzBurstGapElapsed(void) {
+	if (burstActive) {
+		SubghzUseConfig(NULL);
+		Radio.Send(burstBuf, burstSize);
+	}
+}
+
+/*
+ * @brief: Sets the radio to a standby mode. The driver keeps track of the mode
+ * the radio is in, so the fallback after TX is set again rather than skipped.
+ */
+static void SubghzEnterStandby(SubghzStandby_t mode) {
+	SleepParams_t sleep = { .Fields.WarmStart = 1 };
+
+	switch (mode) {
+	case SUBGHZ_STANDBY_XOSC:
+		SUBGRF_SetStandby(STDBY_XOSC);
+		break;
+	case SUBGHZ_STANDBY_FS:
+		SUBGRF_SetFs();
+		break;
+	case SUBGHZ_STANDBY_SLEEP:
+		/*
+		 * Radio.Sleep without its 2 ms delay, the HAL waits for the radio as it
+		 * wakes. The configuration is retained, txConfigOverridden still holds
+		 * and the next send only wakes the radio.
+		 */
+		SUBGRF_SetSleep(sleep);
+		break;
+	default:
+		SUBGRF_SetStandby(STDBY_RC);
+		break;
+	}
+}
+
+/*
+ * @brief: No packet for the idle timeout
+ */
+static void SubghzIdleTimerCallback(TimerHandle_t xTimer) {
+	SubghzApp_IdleSleep();
 }
 
 /*
  * @brief: Triggers when the continuous trigger timer triggers
  */
-static void SubghzTimerCallback(void *argument) {
-	SubghzApp_Sent(continuousMsg, continuousSize);
+static void SubghzTimerCallback(TimerHandle_t xTimer) {
+	if (continuousTemplate) {
+		SubghzApp_SendTemplate();
+	} else {
+		SubghzApp_Sent((char *) continuousData, continuousSize);
+	}
+}
+
+/*
+ * @brief: Refills the stream, stops once the stream packet ended. OnTxDone runs
+ * in the radio interrupt where the timer cannot be stopped.
+ */
+static void SubghzStreamTimerCallback(TimerHandle_t xTimer) {
+	if (!streamActive || streamRemaining == 0) {
+		osTimerStop(streamTimer);
+		return;
+	}
+
+	SubghzApp_StreamRefill();
 }
 /* USER CODE END EF */
 
@@ -361,35 +1607,58 @@ static void SubghzTimerCallback(void *argument) {
 static void OnTxDone(void)
 {
   /* USER CODE BEGIN OnTxDone_1 */
+  Latency_Mark(LATENCY_TX_DONE);
+  BTRACE("radio tx done");
 
+  if (streamActive) {
+	  streamActive = 0;
+	  streamUnderrun |= streamRemaining != 0;
+  }
+
+  if (burstActive) {
+	  SubghzBurstTxDone();
+  }
   /* USER CODE END OnTxDone_1 */
 }
 
 static void OnRxDone(uint8_t *payload, uint16_t size, int16_t rssi, int8_t snr)
 {
   /* USER CODE BEGIN OnRxDone_1 */
+  BTRACE("radio rx %u bytes, rssi %d", size, rssi);
 
+  SubghzTimelineRxEnded();
   /* USER CODE END OnRxDone_1 */
 }
 
 static void OnTxTimeout(void)
 {
   /* USER CODE BEGIN OnTxTimeout_1 */
-
+  BTRACE("radio tx timeout");
+
+  if (streamActive) {
+	  streamActive = 0;
+	  streamUnderrun = 1;
+  }
+
+  if (burstActive) {
+	  burstEnd = Stats_GetCycles();
+	  burstFailed = 1;
+	  burstActive = 0;
+  }
   /* USER CODE END OnTxTimeout_1 */
 }
 
 static void OnRxTimeout(void)
 {
   /* USER CODE BEGIN OnRxTimeout_1 */
-
+  SubghzTimelineRxEnded();
   /* USER CODE END OnRxTimeout_1 */
 }
 
 static void OnRxError(void)
 {
   /* USER CODE BEGIN OnRxError_1 */
-
+  SubghzTimelineRxEnded();
   /* USER CODE END OnRxError_1 */
 }
 
@@ -27,17 +27,69 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include <stdint.h>
+
+#include "Jobs/jobs.h"
+#include "Timeline/timeline.h"
 /* USER CODE END Includes */
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
-
+/* @brief: Writes up to size bytes of a stream to out, returns how many it wrote */
+typedef uint32_t (*SubghzStreamFill_t)(uint8_t *out, uint32_t size, void *context);
+
+typedef struct {
+	uint8_t active;				/* The stream packet is on air */
+	uint8_t underrun;			/* The radio sent every queued byte before the stream ended */
+	uint32_t size;
+	uint32_t queued;			/* Bytes written to the radio buffer so far */
+} SubghzStreamStatus_t;
+
+typedef struct {
+	uint8_t active;				/* Packets of the burst are still to go */
+	uint8_t failed;				/* Ended by a TX timeout */
+	uint32_t count;
+	uint32_t sent;
+	uint32_t duration;			/* us from the first send to the last TX done */
+} SubghzBurstStatus_t;
+
+/* Mode of the radio between packets */
+typedef enum {
+	SUBGHZ_STANDBY_RC,			/* RC oscillator, every packet starts the XOSC and locks the PLL */
+	SUBGHZ_STANDBY_XOSC,		/* XOSC running */
+	SUBGHZ_STANDBY_FS,			/* PLL locked at the frequency */
+	SUBGHZ_STANDBY_SLEEP,		/* Warm start sleep after every packet, the configuration is retained */
+	SUBGHZ_STANDBY_MODES,
+} SubghzStandby_t;
+
+/* How OOK chips reach the air */
+typedef enum {
+	SUBGHZ_OOK_PA,				/* PA keyed at every edge, '0' chips send nothing */
+	SUBGHZ_OOK_FSK,				/* 2-FSK packet, '0' chips twice the offset below the frequency */
+} SubghzOokMode_t;
+
+typedef struct {
+	uint32_t startUs[SUBGHZ_STANDBY_MODES];		/* From the mode to a locked synthesizer, a sleeping radio wakes first */
+} SubghzStandbyLatency_t;
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
 /* MODEM type: one shall be 1 the other shall be 0 */
 /* USER CODE BEGIN EC */
-
+/* '0' chips of the 2-FSK fallback of OOK are twice the offset below the frequency */
+#define SUBGHZ_OOK_OFFSET 100000
+#define SUBGHZ_OOK_MAX_OFFSET 200000
+/* FS to TX, the PA ramps up. Edges turning the carrier on are commanded this early */
+#define SUBGHZ_OOK_PA_RAMP_US 60
+/* Shorter OOK chips are sent with 2-FSK, the ramp would take most of a keyed one */
+#define SUBGHZ_OOK_MIN_KEYED_US 100
+/* A burst gap is a TIM2 compare that holds off STOP2, longer periods are for the jobs */
+#define SUBGHZ_BURST_MAX_GAP_US 100000
+/* Bounds the wait of the burst command, hours at the lowest datarates */
+#define SUBGHZ_BURST_MAX_COUNT 10000
+/* A warm radio goes to sleep after this long without a packet */
+#define SUBGHZ_STANDBY_IDLE_MS 1000
+/* Packet period the average current of the standby modes is compared at */
+#define SUBGHZ_STANDBY_PERIOD_MS 5000
 /* USER CODE END EC */
 
 /* External variables --------------------------------------------------------*/
@@ -64,11 +116,47 @@ extern "C" {
 void SubghzApp_Init(void);
 
 /* USER CODE BEGIN EFP */
-void SubghzApp_Sent(char *msg, uint8_t size);
+uint8_t SubghzApp_Sent(char *msg, uint8_t size);
+uint8_t SubghzApp_SendOok(const uint8_t *chips, uint32_t count, uint32_t chipUs);
+uint8_t SubghzApp_OokActive();
+SubghzOokMode_t SubghzApp_GetOokMode();
+void SubghzApp_SetOokMode(SubghzOokMode_t mode);
+uint32_t SubghzApp_GetOokOffset();
+uint8_t SubghzApp_SetOokOffset(uint32_t offset);
 
 void SubghzApp_StartContinuous(char *msg, uint8_t size, uint32_t ms);
+void SubghzApp_StartContinuousRef(const uint8_t *msg, uint8_t size, uint32_t ms);
 void SubghzApp_StopContinuous();
 
+uint8_t SubghzApp_SendTemplate();
+uint8_t SubghzApp_StartTemplate(uint32_t ms);
+
+uint8_t SubghzApp_StartStream(uint32_t size, SubghzStreamFill_t fill, void *context);
+void SubghzApp_StreamRefill(void);
+void SubghzApp_GetStreamStatus(SubghzStreamStatus_t *status);
+
+int32_t SubghzApp_AddJob(const JobConfig_t *config);
+uint8_t SubghzApp_RemoveJob(uint8_t job);
+void SubghzApp_ClearJobs();
+uint32_t SubghzApp_RunJobs(uint32_t now);
+
+uint8_t SubghzApp_StartTimeline();
+void SubghzApp_StopTimeline();
+void SubghzApp_DryRunTimeline(TimelineDryRun_t *result);
+uint32_t SubghzApp_RunTimeline(uint32_t now);
+
+uint8_t SubghzApp_StartBurst(const uint8_t *msg, uint8_t size, uint32_t count, uint32_t gapUs);
+void SubghzApp_StopBurst();
+void SubghzApp_GetBurstStatus(SubghzBurstStatus_t *status);
+uint32_t SubghzApp_GetAirtime(uint8_t size);
+
+SubghzStandby_t SubghzApp_GetStandby(uint32_t *idleMs);
+void SubghzApp_SetStandby(SubghzStandby_t mode, uint32_t idleMs);
+uint8_t SubghzApp_MeasureStandby(SubghzStandbyLatency_t *latency);
+uint32_t SubghzApp_GetStandbyCurrent(const SubghzStandbyLatency_t *latency, SubghzStandby_t mode, uint32_t periodMs);
+void SubghzApp_TxDoneStandby(void);
+void SubghzApp_IdleSleep(void);
+
 uint32_t SubghzApp_GetFreq();
 void SubghzApp_SetFreq(uint32_t freq);
 
@@ -92,6 +180,12 @@ void SubghzApp_SetSyncword(uint32_t len, const char *word);
 
 void SubghzApp_SetWhitening(uint8_t active, uint16_t seed);
 uint8_t SubghzApp_GetWhiteningStatus();
+
+uint8_t SubghzApp_SaveConfig();
+uint8_t SubghzApp_LoadConfig();
+
+uint8_t SubghzApp_GetRestore();
+uint8_t SubghzApp_SetRestore(uint8_t enable);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
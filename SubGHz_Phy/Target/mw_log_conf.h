@@ -38,7 +38,7 @@ extern "C" {
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
-//#define MW_LOG_ENABLED
+#define MW_LOG_ENABLED
 
 /* USER CODE BEGIN EC */
 
@@ -52,7 +52,7 @@ extern "C" {
 /* Exported macro ------------------------------------------------------------*/
 #ifdef MW_LOG_ENABLED
 /* USER CODE BEGIN Mw_Logs_En*/
-#define MW_LOG(TS,VL, ...)
+#define MW_LOG(TS,VL, ...)   APP_LOG(TS, VL, __VA_ARGS__)
 /* USER CODE END Mw_Logs_En */
 #else  /* MW_LOG_ENABLED */
 /* USER CODE BEGIN Mw_Logs_Dis*/
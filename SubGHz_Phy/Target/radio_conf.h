@@ -33,7 +33,8 @@ extern "C" {
 #include "radio_board_if.h"  /* low layer api (bsp) */
 #include "utilities_def.h"  /* low layer api (bsp) */
 /* USER CODE BEGIN include */
-
+#include "Latency/latency.h"
+#include "subghz_phy_app.h"
 /* USER CODE END include */
 
 /* Exported types ------------------------------------------------------------*/
@@ -43,8 +44,20 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN DBG_GPIO_RADIO */
+#ifdef RADIO_DEBUG_PROBES
+#define DGB_LINE1_PORT DBG_PROBE_RX_GPIO_Port
+#define DGB_LINE1_PIN DBG_PROBE_RX_Pin
+#define DGB_LINE2_PORT DBG_PROBE_TX_GPIO_Port
+#define DGB_LINE2_PIN DBG_PROBE_TX_Pin
+#define DBG_GPIO_SET_LINE(port, pin) LL_GPIO_SetOutputPin(port, pin)
+#define DBG_GPIO_RST_LINE(port, pin) LL_GPIO_ResetOutputPin(port, pin)
+
+#define DBG_GPIO_RADIO_RX(set_rst) DBG_GPIO_##set_rst##_LINE(DGB_LINE1_PORT, DGB_LINE1_PIN);
+#define DBG_GPIO_RADIO_TX(set_rst) DBG_GPIO_##set_rst##_LINE(DGB_LINE2_PORT, DGB_LINE2_PIN);
+#else
 #define DBG_GPIO_RADIO_RX(set_rst) /*DBG_GPIO_##set_rst##_LINE(DGB_LINE1_PORT, DGB_LINE1_PIN);*/
 #define DBG_GPIO_RADIO_TX(set_rst) /*DBG_GPIO_##set_rst##_LINE(DGB_LINE2_PORT, DGB_LINE2_PIN);*/
+#endif /* RADIO_DEBUG_PROBES */
 /* USER CODE END DBG_GPIO_RADIO */
 
 /**
@@ -120,7 +133,15 @@ extern "C" {
 #define RADIO_MEMSET8( dest, value, size )      UTIL_MEM_set_8( dest, value, size )
 
 /* USER CODE BEGIN EM */
+/**
+  * @brief Timestamp taken once the SetTx command has been written to the radio
+  */
+#define RADIO_LATENCY_MARK_SET_TX()             Latency_Mark(LATENCY_SET_TX)
 
+/**
+  * @brief Puts the radio in the standby mode of the application once a packet is sent, STDBY_RC without it
+  */
+#define RADIO_TX_DONE_STANDBY()                 SubghzApp_TxDoneStandby()
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
@@ -0,0 +1,197 @@
+/*
+ * decoder.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "decoder.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace btrace {
+
+/********************************
+ * Interface Functions
+ ********************************/
+uint8_t crc8(const uint8_t *data, size_t len) {
+	uint8_t crc = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (unsigned bit = 0; bit < 8; bit++) {
+			crc = crc & 0x80 ? static_cast<uint8_t>(crc << 1 ^ kCrcPoly) : static_cast<uint8_t>(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+Decoder::Decoder(std::vector<char> formats) : formats(std::move(formats)) {
+}
+
+void Decoder::feed(uint8_t byte, std::ostream &out) {
+	if (!inFrame) {
+		if ((byte & 0xF0) == kSync && (byte & 0x0F) <= kMaxArgs) {
+			inFrame = true;
+			raw.assign(1, byte);
+			nargs = byte & 0x0F;
+			idBytes = 0;
+			id = 0;
+			values.clear();
+			varint = 0;
+			varintShift = 0;
+			return;
+		}
+
+		text(byte, out);
+		return;
+	}
+
+	/* CRC of everything before it */
+	if (values.size() == nargs + 1) {
+		if (byte != crc8(raw.data(), raw.size())) {
+			raw.push_back(byte);
+			reject(out);
+			return;
+		}
+		emit(out);
+		inFrame = false;
+		return;
+	}
+	raw.push_back(byte);
+
+	/* 16 bit little endian event id */
+	if (idBytes < 2) {
+		id |= static_cast<uint16_t>(byte) << (8 * idBytes);
+		idBytes++;
+		return;
+	}
+
+	/* LEB128 delta and arguments */
+	varint |= static_cast<uint32_t>(byte & 0x7F) << varintShift;
+	varintShift += 7;
+	if (byte & 0x80) {
+		if (varintShift >= 35) {
+			reject(out);
+		}
+		return;
+	}
+
+	values.push_back(varint);
+	varint = 0;
+	varintShift = 0;
+}
+
+void Decoder::finish(std::ostream &out) {
+	/* The bytes of a frame that never completed may hold whole frames */
+	while (inFrame) {
+		reject(out);
+	}
+}
+
+std::string Decoder::format(uint16_t id, const std::vector<uint32_t> &args) const {
+	if (id >= formats.size()) {
+		return "<unknown event " + std::to_string(id) + ">";
+	}
+
+	const char *fmt = &formats[id];
+	size_t fmtLen = strnlen(fmt, formats.size() - id);
+	std::string result;
+	size_t arg = 0;
+
+	for (size_t i = 0; i < fmtLen; i++) {
+		if (fmt[i] != '%') {
+			result += fmt[i];
+			continue;
+		}
+		if (i + 1 < fmtLen && fmt[i + 1] == '%') {
+			result += '%';
+			i++;
+			continue;
+		}
+
+		/* Flags, width and precision are kept, length modifiers are dropped */
+		std::string spec = "%";
+		size_t j = i + 1;
+		while (j < fmtLen && strchr("-+ #0123456789.", fmt[j])) {
+			spec += fmt[j++];
+		}
+		while (j < fmtLen && strchr("hlzjt", fmt[j])) {
+			j++;
+		}
+		if (j == fmtLen) {
+			result += fmt + i;
+			break;
+		}
+
+		char conv = fmt[j];
+		i = j;
+
+		if (arg >= args.size()) {
+			result += "<missing>";
+			continue;
+		}
+
+		char buf[32];
+		switch (conv) {
+		case 'd':
+		case 'i':
+			snprintf(buf, sizeof(buf), (spec + "d").c_str(), static_cast<int32_t>(args[arg]));
+			break;
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'c':
+			snprintf(buf, sizeof(buf), (spec + conv).c_str(), args[arg]);
+			break;
+		default:
+			snprintf(buf, sizeof(buf), "<%%%c?>", conv);
+			break;
+		}
+		result += buf;
+		arg++;
+	}
+
+	return result;
+}
+
+/********************************
+ * Private Functions
+ ********************************/
+void Decoder::text(uint8_t byte, std::ostream &out) {
+	out.put(static_cast<char>(byte));
+	lineStart = byte == '\n';
+}
+
+/* @brief: Not a frame: the sync byte was text, the bytes after it are decoded again */
+void Decoder::reject(std::ostream &out) {
+	std::vector<uint8_t> rest(raw.begin() + 1, raw.end());
+
+	inFrame = false;
+	text(raw[0], out);
+	for (uint8_t byte : rest) {
+		feed(byte, out);
+	}
+}
+
+void Decoder::emit(std::ostream &out) {
+	timeUs += values[0];
+
+	char stamp[32];
+	snprintf(stamp, sizeof(stamp), "[%6llu.%06llu] ", static_cast<unsigned long long>(timeUs / 1000000),
+			static_cast<unsigned long long>(timeUs % 1000000));
+
+	/* Events always start on their own line, even in the middle of CLI echo */
+	if (!lineStart) {
+		out << '\n';
+	}
+	out << stamp << format(id, std::vector<uint32_t>(values.begin() + 1, values.end())) << '\n';
+	lineStart = true;
+}
+
+} // namespace btrace
@@ -0,0 +1,65 @@
+/*
+ * decoder.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef TOOLS_BTRACE_DECODER_H_
+#define TOOLS_BTRACE_DECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace btrace {
+
+/* Must match Lib/Inc/BTrace/btrace.h */
+constexpr uint8_t kSync = 0xF0;
+constexpr uint8_t kCrcPoly = 0x07;
+constexpr unsigned kMaxArgs = 4;
+
+/* @brief: CRC-8 that ends every frame */
+uint8_t crc8(const uint8_t *data, size_t len);
+
+/* @brief: Splits a UART capture into plain text (passed through) and BTRACE frames,
+ * which are rebuilt into log lines from the format strings of the firmware ELF.
+ * A sync byte that does not start a frame with a valid CRC is text. */
+class Decoder {
+public:
+	explicit Decoder(std::vector<char> formats);
+
+	void feed(uint8_t byte, std::ostream &out);
+
+	/* End of the capture, an incomplete frame is given back as text */
+	void finish(std::ostream &out);
+
+	/* Formats one event, exposed for the tests */
+	std::string format(uint16_t id, const std::vector<uint32_t> &args) const;
+
+private:
+	void text(uint8_t byte, std::ostream &out);
+	void reject(std::ostream &out);
+	void emit(std::ostream &out);
+
+	std::vector<char> formats;
+
+	/* Frame being assembled, inFrame == false while passing text through */
+	bool inFrame = false;
+	std::vector<uint8_t> raw; /* Its bytes, given back as text if it is not a frame */
+	unsigned nargs = 0;
+	unsigned idBytes = 0;
+	uint16_t id = 0;
+	std::vector<uint32_t> values; /* Delta followed by the arguments */
+	uint32_t varint = 0;
+	unsigned varintShift = 0;
+
+	uint64_t timeUs = 0;
+	bool lineStart = true;
+};
+
+} // namespace btrace
+
+#endif /* TOOLS_BTRACE_DECODER_H_ */
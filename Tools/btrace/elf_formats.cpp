@@ -0,0 +1,109 @@
+/*
+ * elf_formats.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "elf_formats.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace btrace {
+
+/********************************
+ * Static Functions
+ ********************************/
+namespace {
+
+template <typename T>
+T readLE(const std::vector<char> &data, size_t offset) {
+	if (offset + sizeof(T) > data.size()) {
+		throw std::runtime_error("truncated ELF file");
+	}
+
+	T value = 0;
+	for (size_t i = 0; i < sizeof(T); i++) {
+		value |= static_cast<T>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+	}
+	return value;
+}
+
+struct SectionHeader {
+	uint32_t name;
+	uint64_t offset;
+	uint64_t size;
+};
+
+SectionHeader readSectionHeader(const std::vector<char> &elf, bool is64, size_t at) {
+	SectionHeader sh;
+
+	sh.name = readLE<uint32_t>(elf, at);
+	if (is64) {
+		sh.offset = readLE<uint64_t>(elf, at + 0x18);
+		sh.size = readLE<uint64_t>(elf, at + 0x20);
+	} else {
+		sh.offset = readLE<uint32_t>(elf, at + 0x10);
+		sh.size = readLE<uint32_t>(elf, at + 0x14);
+	}
+	return sh;
+}
+
+} // namespace
+
+/********************************
+ * Interface Functions
+ ********************************/
+std::vector<char> readElfSection(const std::string &path, const std::string &section) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		throw std::runtime_error("cannot open " + path);
+	}
+	std::vector<char> elf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	if (elf.size() < 0x34 || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0) {
+		throw std::runtime_error(path + " is not an ELF file");
+	}
+	if (elf[5] != 1) {
+		throw std::runtime_error(path + " is not little endian");
+	}
+	bool is64 = elf[4] == 2;
+
+	uint64_t shoff = is64 ? readLE<uint64_t>(elf, 0x28) : readLE<uint32_t>(elf, 0x20);
+	uint16_t shentsize = readLE<uint16_t>(elf, is64 ? 0x3A : 0x2E);
+	uint16_t shnum = readLE<uint16_t>(elf, is64 ? 0x3C : 0x30);
+	uint16_t shstrndx = readLE<uint16_t>(elf, is64 ? 0x3E : 0x32);
+
+	if (shstrndx >= shnum) {
+		throw std::runtime_error(path + " has no section name table");
+	}
+	SectionHeader names = readSectionHeader(elf, is64, shoff + shstrndx * shentsize);
+
+	for (uint16_t i = 0; i < shnum; i++) {
+		SectionHeader sh = readSectionHeader(elf, is64, shoff + i * shentsize);
+
+		size_t nameAt = names.offset + sh.name;
+		if (nameAt >= elf.size()) {
+			continue;
+		}
+		if (section != &elf[nameAt]) {
+			continue;
+		}
+
+		if (sh.offset + sh.size > elf.size()) {
+			throw std::runtime_error("truncated ELF file");
+		}
+		return std::vector<char>(elf.begin() + sh.offset, elf.begin() + sh.offset + sh.size);
+	}
+
+	throw std::runtime_error(path + " has no " + section + " section");
+}
+
+} // namespace btrace
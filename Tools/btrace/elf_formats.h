@@ -0,0 +1,22 @@
+/*
+ * elf_formats.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef TOOLS_BTRACE_ELF_FORMATS_H_
+#define TOOLS_BTRACE_ELF_FORMATS_H_
+
+#include <string>
+#include <vector>
+
+namespace btrace {
+
+/* @brief: Reads the contents of a section from a little endian ELF32/ELF64 file.
+ * Throws std::runtime_error if the file is not an ELF or the section is missing. */
+std::vector<char> readElfSection(const std::string &path, const std::string &section);
+
+} // namespace btrace
+
+#endif /* TOOLS_BTRACE_ELF_FORMATS_H_ */
@@ -0,0 +1,64 @@
+/*
+ * main.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ *
+ * Decodes a pwnRF UART capture with binary trace events:
+ *   btrace Debug/pwnRF_WL55.elf [capture|/dev/ttyACM0]
+ * Reads stdin when no capture is given. Set the serial port up beforehand,
+ * e.g. stty -F /dev/ttyACM0 115200 raw
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "decoder.h"
+#include "elf_formats.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+/********************************
+ * Main
+ ********************************/
+int main(int argc, char **argv) {
+	if (argc < 2 || argc > 3) {
+		std::cerr << "usage: " << argv[0] << " <firmware.elf> [capture]\n";
+		return 2;
+	}
+
+	std::vector<char> formats;
+	try {
+		formats = btrace::readElfSection(argv[1], ".btrace_fmt");
+	} catch (const std::exception &e) {
+		std::cerr << "btrace: " << e.what() << "\n";
+		return 1;
+	}
+
+	std::ifstream capture;
+	std::istream *in = &std::cin;
+	if (argc == 3) {
+		capture.open(argv[2], std::ios::binary);
+		if (!capture) {
+			std::cerr << "btrace: cannot open " << argv[2] << "\n";
+			return 1;
+		}
+		in = &capture;
+	}
+
+	btrace::Decoder decoder(std::move(formats));
+
+	/* Unbuffered, so a live serial port is decoded as it arrives */
+	std::streambuf *buf = in->rdbuf();
+	for (int c = buf->sbumpc(); c != std::char_traits<char>::eof(); c = buf->sbumpc()) {
+		decoder.feed(static_cast<uint8_t>(c), std::cout);
+		if (c == '\n' || buf->in_avail() == 0) {
+			std::cout.flush();
+		}
+	}
+	decoder.finish(std::cout);
+
+	return 0;
+}
@@ -0,0 +1,539 @@
+/*
+ * pwnrf.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+/********************************
+ * Includes
+ ********************************/
+#include "pwnrf.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace pwnrf {
+
+/********************************
+ * Static Functions
+ ********************************/
+static std::runtime_error systemError(const std::string &what) {
+	return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/* Response to echo off, everything before it is from an earlier session */
+static const char *const kSyncResponse = "Echo Off\r\n";
+
+/* Handshake timing: echo off is repeated until answered, then the line must go quiet */
+static const int kSyncRetryMs = 250;
+static const int kSyncQuietMs = 100;
+static const int kSyncTimeoutMs = 5000;
+
+static bool contains(const std::string &response, const char *text) {
+	return response.find(text) != std::string::npos;
+}
+
+/* @brief: Number after "<label> = " in a get response */
+static double parseValue(const std::string &line, const std::string &response, const char *label) {
+	std::string key = std::string(label) + " = ";
+	size_t pos = response.find(key);
+
+	if (pos == std::string::npos) {
+		throw CommandError(line + ": " + response);
+	}
+
+	return std::strtod(response.c_str() + pos + key.size(), nullptr);
+}
+
+static bool parseOnOff(const std::string &line, const std::string &response, const char *label) {
+	std::string key = std::string(label) + " is ";
+	size_t pos = response.find(key);
+
+	if (pos == std::string::npos) {
+		throw CommandError(line + ": " + response);
+	}
+
+	return response.compare(pos + key.size(), 2, "On") == 0;
+}
+
+static void checkPayload(const std::string &payload) {
+	if (payload.empty() || payload.size() > kMaxPayload || payload.find_first_of("\r\n") != std::string::npos) {
+		throw std::invalid_argument("pwnrf: payload must be 1 to 63 characters on one line");
+	}
+}
+
+/********************************
+ * Connection
+ ********************************/
+Client::Client(const std::string &path, unsigned window) : windowSize(window ? window : 1) {
+	fd = ::open(path.c_str(), O_RDWR | O_NOCTTY);
+	if (fd < 0) {
+		throw systemError(path);
+	}
+
+	/* A board on a serial port, the pseudo-terminal of the simulator is already raw */
+	struct termios tio;
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		cfsetspeed(&tio, B115200);
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	tcflush(fd, TCIFLUSH);
+
+	if (pipe(wakeFd) != 0) {
+		::close(fd);
+		throw systemError("pipe");
+	}
+
+	if (!handshake()) {
+		shutdown(false);
+		throw std::runtime_error("pwnrf: no response from " + path);
+	}
+
+	reader = std::thread(&Client::readLoop, this);
+}
+
+Client::~Client() {
+	shutdown(true);
+}
+
+void Client::shutdown(bool restoreEcho) {
+	if (restoreEcho) {
+		/* Leaves the terminal usable by hand */
+		std::promise<void> restored;
+		std::future<void> done = restored.get_future();
+		auto promise = std::make_shared<std::promise<void>>(std::move(restored));
+		enqueue({"echo on", [promise](const std::string &) { promise->set_value(); },
+				[promise](std::exception_ptr) { promise->set_value(); }});
+		done.wait_for(std::chrono::seconds(1));
+	}
+
+	if (reader.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+		}
+		(void) ::write(wakeFd[1], "", 1);
+		reader.join();
+	}
+
+	failAll(std::make_exception_ptr(std::runtime_error("pwnrf: connection closed")));
+
+	for (int *f : {&fd, &wakeFd[0], &wakeFd[1]}) {
+		if (*f >= 0) {
+			::close(*f);
+			*f = -1;
+		}
+	}
+}
+
+/*
+ * @brief: Turns echo off and skips whatever the terminal held before, the boot
+ * report or a half typed line. Lines typed while the firmware boots are lost,
+ * so echo off is repeated until answered; the answers to the repeats arrive
+ * before the line goes quiet. Runs before the reader thread starts.
+ */
+bool Client::handshake() {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kSyncTimeoutMs);
+	std::string received;
+	bool answered = false;
+
+	while (std::chrono::steady_clock::now() < deadline) {
+		if (!answered) {
+			writeLine("echo off");
+		}
+
+		struct pollfd pfd = { fd, POLLIN, 0 };
+		int ready = poll(&pfd, 1, answered ? kSyncQuietMs : kSyncRetryMs);
+		if (ready < 0 && errno != EINTR) {
+			return false;
+		}
+		if (ready == 0 && answered) {
+			return true;
+		}
+		if (ready <= 0) {
+			continue;
+		}
+
+		/* Keep reading until this burst is over before the next repeat */
+		char data[512];
+		do {
+			ssize_t len = ::read(fd, data, sizeof(data));
+			if (len <= 0) {
+				return false;
+			}
+			if (!answered) {
+				received.append(data, len);
+				answered = contains(received, kSyncResponse);
+			}
+		} while (poll(&pfd, 1, kSyncQuietMs) > 0);
+
+		if (answered) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/********************************
+ * Pipeline
+ ********************************/
+void Client::writeLine(const std::string &line) {
+	std::string data = line + "\r\n";
+	const char *p = data.data();
+	size_t left = data.size();
+
+	while (left != 0) {
+		ssize_t n = ::write(fd, p, left);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		p += n;
+		left -= n;
+	}
+}
+
+/* @brief: Sends waiting requests while the window has room, called with the mutex held */
+void Client::sendQueued() {
+	while (!waiting.empty() && inFlight.size() < windowSize) {
+		inFlight.push_back(std::move(waiting.front()));
+		waiting.pop_front();
+		writeLine(inFlight.back().line);
+	}
+}
+
+void Client::enqueue(Request request) {
+	if (request.line.size() + 2 > kLineSize) {
+		request.fail(std::make_exception_ptr(std::invalid_argument("pwnrf: line too long: " + request.line)));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (closed) {
+		request.fail(std::make_exception_ptr(std::runtime_error("pwnrf: connection closed")));
+		return;
+	}
+
+	waiting.push_back(std::move(request));
+	sendQueued();
+}
+
+void Client::readLoop() {
+	const std::string prompt = kPrompt;
+	char data[512];
+
+	for (;;) {
+		struct pollfd fds[2] = {
+			{ fd, POLLIN, 0 },
+			{ wakeFd[0], POLLIN, 0 },
+		};
+		if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+			break;
+		}
+		if (fds[1].revents & POLLIN) {
+			break;
+		}
+		if (!(fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+			continue;
+		}
+
+		ssize_t len = ::read(fd, data, sizeof(data));
+		if (len <= 0) {
+			if (len < 0 && (errno == EINTR || errno == EAGAIN)) {
+				continue;
+			}
+			break;
+		}
+		response.append(data, len);
+
+		/* Every prompt ends the output of the oldest command in flight */
+		size_t end;
+		while ((end = response.find(prompt)) != std::string::npos) {
+			std::string output = response.substr(0, end);
+			response.erase(0, end + prompt.size());
+
+			Request done;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (inFlight.empty()) {
+					/* Not ours, e.g. a prompt printed before the client connected */
+					continue;
+				}
+				done = std::move(inFlight.front());
+				inFlight.pop_front();
+				sendQueued();
+				if (inFlight.empty() && waiting.empty()) {
+					idle.notify_all();
+				}
+			}
+
+			/* Parse errors end up in the future rather than in this thread */
+			try {
+				done.complete(output);
+			} catch (...) {
+				done.fail(std::current_exception());
+			}
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+	}
+	failAll(std::make_exception_ptr(std::runtime_error("pwnrf: connection closed")));
+}
+
+void Client::failAll(std::exception_ptr error) {
+	std::deque<Request> failed;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		failed.swap(inFlight);
+		for (Request &request : waiting) {
+			failed.push_back(std::move(request));
+		}
+		waiting.clear();
+		idle.notify_all();
+	}
+
+	for (Request &request : failed) {
+		request.fail(error);
+	}
+}
+
+void Client::flush() {
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this] { return closed || (inFlight.empty() && waiting.empty()); });
+}
+
+template<typename T>
+std::future<T> Client::submit(const std::string &line, std::function<T(const std::string &)> parse) {
+	auto promise = std::make_shared<std::promise<T>>();
+	std::future<T> future = promise->get_future();
+
+	enqueue({line, [promise, parse](const std::string &response) {
+		if constexpr (std::is_void_v<T>) {
+			parse(response);
+			promise->set_value();
+		} else {
+			promise->set_value(parse(response));
+		}
+	}, [promise](std::exception_ptr error) {
+		promise->set_exception(error);
+	}});
+
+	return future;
+}
+
+std::future<void> Client::set(const std::string &line, const char *success) {
+	return submit<void>(line, [line, success](const std::string &response) {
+		if (!contains(response, success)) {
+			throw CommandError(line + ": " + response);
+		}
+	});
+}
+
+/********************************
+ * Commands
+ ********************************/
+std::future<std::string> Client::command(const std::string &line) {
+	return submit<std::string>(line, [](const std::string &response) { return response; });
+}
+
+std::future<uint32_t> Client::getFreq() {
+	return submit<uint32_t>("freq", [](const std::string &response) {
+		return static_cast<uint32_t>(std::lround(parseValue("freq", response, "Frequency") * 1e6));
+	});
+}
+
+std::future<void> Client::setFreq(uint32_t hz) {
+	return set("freq " + std::to_string(hz), "Frequency Set Successfully");
+}
+
+std::future<uint32_t> Client::getFreqDeviation() {
+	return submit<uint32_t>("freqDeviation", [](const std::string &response) {
+		return static_cast<uint32_t>(std::lround(parseValue("freqDeviation", response, "Frequency Deviation") * 1e3));
+	});
+}
+
+std::future<void> Client::setFreqDeviation(uint32_t hz) {
+	return set("freqDeviation " + std::to_string(hz), "Frequency Deviation Set Successfully");
+}
+
+std::future<uint32_t> Client::getPower() {
+	return submit<uint32_t>("power", [](const std::string &response) {
+		return static_cast<uint32_t>(parseValue("power", response, "Power"));
+	});
+}
+
+std::future<void> Client::setPower(uint32_t dBm) {
+	return set("power " + std::to_string(dBm), "Power Set Successfully");
+}
+
+std::future<uint32_t> Client::getDatarate() {
+	return submit<uint32_t>("datarate", [](const std::string &response) {
+		return static_cast<uint32_t>(parseValue("datarate", response, "Datarate"));
+	});
+}
+
+std::future<void> Client::setDatarate(uint32_t bps) {
+	return set("datarate " + std::to_string(bps), "Datarate Set Successfully");
+}
+
+std::future<uint32_t> Client::getPreambleLength() {
+	return submit<uint32_t>("preamble", [](const std::string &response) {
+		return static_cast<uint32_t>(parseValue("preamble", response, "Preamble Length"));
+	});
+}
+
+std::future<void> Client::setPreambleLength(uint32_t bytes) {
+	return set("preamble " + std::to_string(bytes), "Preamble Length Set Successfully");
+}
+
+std::future<bool> Client::getCrc() {
+	return submit<bool>("crc", [](const std::string &response) { return parseOnOff("crc", response, "CRC"); });
+}
+
+std::future<void> Client::setCrc(bool on) {
+	return set(on ? "crc on" : "crc off", on ? "Turned CRC On" : "Turned CRC Off");
+}
+
+std::future<bool> Client::getWhitening() {
+	return submit<bool>("whitening", [](const std::string &response) {
+		return parseOnOff("whitening", response, "Whitening");
+	});
+}
+
+std::future<void> Client::setWhitening(bool on, uint16_t seed) {
+	if (!on) {
+		return set("whitening off", "Turned Whitening Off");
+	}
+
+	return set("whitening on " + std::to_string(seed), "Turned Whitening On");
+}
+
+std::future<std::string> Client::getSyncword() {
+	return submit<std::string>("syncword", [](const std::string &response) {
+		size_t pos = response.find(": ");
+		if (response.find("Syncword of size") == std::string::npos || pos == std::string::npos) {
+			throw CommandError("syncword: " + response);
+		}
+
+		std::string word = response.substr(pos + 2);
+		return word.substr(0, word.find("\r\n"));
+	});
+}
+
+std::future<void> Client::setSyncword(const std::string &word) {
+	if (word.size() > 8 || word.find_first_of(" \r\n") != std::string::npos) {
+		throw std::invalid_argument("pwnrf: syncword must be up to 8 characters without spaces");
+	}
+
+	return set("syncword " + std::to_string(word.size()) + (word.empty() ? "" : " " + word), "Syncword Set Successfully");
+}
+
+std::future<void> Client::send(const std::string &payload) {
+	checkPayload(payload);
+
+	return set("transmit " + payload, "Successful Transmission");
+}
+
+std::future<void> Client::startContinuous(uint32_t ms, const std::string &payload) {
+	checkPayload(payload);
+	if (ms == 0) {
+		throw std::invalid_argument("pwnrf: continuous period must not be 0, use stopContinuous()");
+	}
+
+	return set("transmitContinuous " + std::to_string(ms) + " " + payload, "Continuous Transmission Enabled");
+}
+
+std::future<void> Client::stopContinuous() {
+	return set("transmitContinuous 0", "Continuous Mode Stopped");
+}
+
+std::future<void> Client::configure(const Config &config) {
+	std::vector<std::pair<std::string, const char *>> lines;
+
+	if (config.freq) {
+		lines.emplace_back("freq " + std::to_string(*config.freq), "Frequency Set Successfully");
+	}
+	if (config.freqDeviation) {
+		lines.emplace_back("freqDeviation " + std::to_string(*config.freqDeviation), "Frequency Deviation Set Successfully");
+	}
+	if (config.power) {
+		lines.emplace_back("power " + std::to_string(*config.power), "Power Set Successfully");
+	}
+	if (config.datarate) {
+		lines.emplace_back("datarate " + std::to_string(*config.datarate), "Datarate Set Successfully");
+	}
+	if (config.preambleLength) {
+		lines.emplace_back("preamble " + std::to_string(*config.preambleLength), "Preamble Length Set Successfully");
+	}
+	if (config.crc) {
+		lines.emplace_back(*config.crc ? "crc on" : "crc off", *config.crc ? "Turned CRC On" : "Turned CRC Off");
+	}
+	if (config.syncword) {
+		const std::string &word = *config.syncword;
+		if (word.size() > 8 || word.find_first_of(" \r\n") != std::string::npos) {
+			throw std::invalid_argument("pwnrf: syncword must be up to 8 characters without spaces");
+		}
+		lines.emplace_back("syncword " + std::to_string(word.size()) + (word.empty() ? "" : " " + word),
+				"Syncword Set Successfully");
+	}
+
+	/* One future for the batch, set by the last response, holding the first error if any */
+	struct Batch {
+		std::promise<void> promise;
+		size_t remaining;
+		std::exception_ptr error;
+	};
+	auto batch = std::make_shared<Batch>();
+	batch->remaining = lines.size();
+	std::future<void> future = batch->promise.get_future();
+
+	if (lines.empty()) {
+		batch->promise.set_value();
+		return future;
+	}
+
+	/* Responses complete in order from the reader thread, no locking needed */
+	auto finish = [batch](std::exception_ptr error) {
+		if (error && !batch->error) {
+			batch->error = error;
+		}
+		if (--batch->remaining == 0) {
+			if (batch->error) {
+				batch->promise.set_exception(batch->error);
+			} else {
+				batch->promise.set_value();
+			}
+		}
+	};
+
+	/* All in the pipeline at once, the window keeps cliQueue from overflowing */
+	for (auto &[line, success] : lines) {
+		enqueue({line, [finish, line = line, success = success](const std::string &response) {
+			finish(contains(response, success) ? nullptr : std::make_exception_ptr(CommandError(line + ": " + response)));
+		}, finish});
+	}
+
+	return future;
+}
+
+} // namespace pwnrf
@@ -0,0 +1,132 @@
+/*
+ * pwnrf.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Christodoulos Sotiriou
+ */
+
+#ifndef TOOLS_LIBPWNRF_PWNRF_H_
+#define TOOLS_LIBPWNRF_PWNRF_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace pwnrf {
+
+/* Must match Lib/Src/CLI/cli.c */
+constexpr const char *kPrompt = "> \x1b" "7";
+constexpr size_t kLineSize = 128;
+constexpr size_t kMaxPayload = 63;
+
+/* cliQueue holds 5 lines, one more is assembled by the UART interrupt meanwhile */
+constexpr unsigned kDefaultWindow = 4;
+
+/* @brief: The firmware rejected a command, what() holds the command and its response */
+class CommandError : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+/* @brief: Radio settings applied by Client::configure(), only the fields that are set */
+struct Config {
+	std::optional<uint32_t> freq;			/* Hz */
+	std::optional<uint32_t> freqDeviation;	/* Hz */
+	std::optional<uint32_t> power;			/* dBm */
+	std::optional<uint32_t> datarate;		/* bps */
+	std::optional<uint32_t> preambleLength;	/* bytes */
+	std::optional<bool> crc;
+	std::optional<std::string> syncword;	/* Up to 8 characters, no spaces */
+};
+
+/*
+ * @brief: Async client of the pwnRF CLI on a serial port or the pseudo-terminal
+ * of pwnrf_sim. The calls mirror SubghzApp_* and return futures. Up to window
+ * commands are in flight at once; each prompt completes the oldest one, so the
+ * responses are matched in order. Echo is turned off while connected.
+ */
+class Client {
+public:
+	explicit Client(const std::string &path, unsigned window = kDefaultWindow);
+	~Client();
+
+	Client(const Client &) = delete;
+	Client &operator=(const Client &) = delete;
+
+	/* Any command line, the future holds its output without the prompt */
+	std::future<std::string> command(const std::string &line);
+
+	/* The firmware reports the frequency in kHz steps and the deviation in Hz */
+	std::future<uint32_t> getFreq();
+	std::future<void> setFreq(uint32_t hz);
+	std::future<uint32_t> getFreqDeviation();
+	std::future<void> setFreqDeviation(uint32_t hz);
+	std::future<uint32_t> getPower();
+	std::future<void> setPower(uint32_t dBm);
+	std::future<uint32_t> getDatarate();
+	std::future<void> setDatarate(uint32_t bps);
+	std::future<uint32_t> getPreambleLength();
+	std::future<void> setPreambleLength(uint32_t bytes);
+	std::future<bool> getCrc();
+	std::future<void> setCrc(bool on);
+	std::future<bool> getWhitening();
+	std::future<void> setWhitening(bool on, uint16_t seed = 0x01FF);
+	std::future<std::string> getSyncword();
+	std::future<void> setSyncword(const std::string &word);
+
+	std::future<void> send(const std::string &payload);
+	std::future<void> startContinuous(uint32_t ms, const std::string &payload);
+	std::future<void> stopContinuous();
+
+	/* @brief: Sends every setting of config back to back, ready once all of them are applied */
+	std::future<void> configure(const Config &config);
+
+	/* @brief: Blocks until every command sent so far has its response */
+	void flush();
+
+	unsigned window() const { return windowSize; }
+
+private:
+	struct Request {
+		std::string line;
+		std::function<void(const std::string &)> complete;
+		std::function<void(std::exception_ptr)> fail;
+	};
+
+	template<typename T>
+	std::future<T> submit(const std::string &line, std::function<T(const std::string &)> parse);
+	std::future<void> set(const std::string &line, const char *success);
+
+	bool handshake();
+	void shutdown(bool restoreEcho);
+	void enqueue(Request request);
+	void writeLine(const std::string &line);
+	void sendQueued();
+	void readLoop();
+	void failAll(std::exception_ptr error);
+
+	int fd = -1;
+	int wakeFd[2] = {-1, -1};
+	unsigned windowSize;
+
+	std::mutex mutex;
+	std::condition_variable idle;
+	std::deque<Request> inFlight;		/* Sent, waiting for their prompt in this order */
+	std::deque<Request> waiting;		/* Not sent yet, the window is full */
+	bool closed = false;
+
+	std::string response;				/* Output of the oldest command in flight so far */
+	std::thread reader;
+};
+
+} // namespace pwnrf
+
+#endif /* TOOLS_LIBPWNRF_PWNRF_H_ */